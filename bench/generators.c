@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "generators.h"
+
+/* Synthetic graph generators. Loops are never generated, because simple
+ * graphs cannot have them, but RMAT and Erdos-Renyi graphs may have repeated
+ * edges, which end up as one connection in simple graph.
+ */
+
+typedef GArray* (*BenchGenerateFunc)(guint order,
+                                     guint size,
+                                     GRand* rand,
+                                     guint* real_order);
+
+typedef struct _BenchGenerator BenchGenerator;
+
+struct _BenchGenerator
+{
+  const gchar* name;
+  BenchGenerateFunc func;
+};
+
+static void
+add_edge(GArray* edges,
+         guint32 first,
+         guint32 second)
+{
+  BenchEdge edge;
+
+  edge.first = first;
+  edge.second = second;
+  g_array_append_val(edges, edge);
+}
+
+/* Recursive matrix generator with usual Graph500 probabilities. Each edge
+ * descends log2(ORDER) levels, picking one of four quadrants of adjacency
+ * matrix on each, which gives a skewed, power-law like degree distribution.
+ */
+static GArray*
+generate_rmat(guint order,
+              guint size,
+              GRand* rand,
+              guint* real_order)
+{
+  GArray* edges;
+  guint scale;
+  guint iter;
+
+  scale = 1;
+  while ((1u << scale) < order && scale < 31)
+  {
+    scale++;
+  }
+  *real_order = 1u << scale;
+
+  edges = g_array_sized_new(FALSE, FALSE, sizeof(BenchEdge), size);
+  while (edges->len < size)
+  {
+    guint32 first;
+    guint32 second;
+
+    first = 0;
+    second = 0;
+    for (iter = 0; iter < scale; iter++)
+    {
+      gdouble p;
+
+      p = g_rand_double(rand);
+      first <<= 1;
+      second <<= 1;
+      if (p < 0.57)
+      {
+        continue;
+      }
+      else if (p < 0.76)
+      {
+        second |= 1;
+      }
+      else if (p < 0.95)
+      {
+        first |= 1;
+      }
+      else
+      {
+        first |= 1;
+        second |= 1;
+      }
+    }
+    if (first != second)
+    {
+      add_edge(edges, first, second);
+    }
+  }
+
+  return edges;
+}
+
+/* G(n, m) Erdos-Renyi graph - SIZE edges with uniformly chosen ends. */
+static GArray*
+generate_erdos_renyi(guint order,
+                     guint size,
+                     GRand* rand,
+                     guint* real_order)
+{
+  GArray* edges;
+
+  *real_order = MAX(order, 2);
+  edges = g_array_sized_new(FALSE, FALSE, sizeof(BenchEdge), size);
+  while (edges->len < size)
+  {
+    guint32 first;
+    guint32 second;
+
+    first = g_rand_int_range(rand, 0, *real_order);
+    second = g_rand_int_range(rand, 0, *real_order);
+    if (first != second)
+    {
+      add_edge(edges, first, second);
+    }
+  }
+
+  return edges;
+}
+
+/* Square lattice, every node connected to its right and bottom neighbour. */
+static GArray*
+generate_grid(guint order,
+              guint size G_GNUC_UNUSED,
+              GRand* rand G_GNUC_UNUSED,
+              guint* real_order)
+{
+  GArray* edges;
+  guint side;
+  guint row;
+  guint column;
+
+  side = 2;
+  while ((side + 1) * (side + 1) <= order)
+  {
+    side++;
+  }
+  *real_order = side * side;
+
+  edges = g_array_sized_new(FALSE, FALSE, sizeof(BenchEdge),
+                            2 * side * (side - 1));
+  for (row = 0; row < side; row++)
+  {
+    for (column = 0; column < side; column++)
+    {
+      guint32 node;
+
+      node = row * side + column;
+      if (column + 1 < side)
+      {
+        add_edge(edges, node, node + 1);
+      }
+      if (row + 1 < side)
+      {
+        add_edge(edges, node, node + side);
+      }
+    }
+  }
+
+  return edges;
+}
+
+/* Single path, worst case for anything recursive. */
+static GArray*
+generate_path(guint order,
+              guint size G_GNUC_UNUSED,
+              GRand* rand G_GNUC_UNUSED,
+              guint* real_order)
+{
+  GArray* edges;
+  guint iter;
+
+  *real_order = MAX(order, 2);
+  edges = g_array_sized_new(FALSE, FALSE, sizeof(BenchEdge), *real_order - 1);
+  for (iter = 1; iter < *real_order; iter++)
+  {
+    add_edge(edges, iter - 1, iter);
+  }
+
+  return edges;
+}
+
+/* One hub connected to all other nodes, worst case for per node adjacency
+ * scans.
+ */
+static GArray*
+generate_star(guint order,
+              guint size G_GNUC_UNUSED,
+              GRand* rand G_GNUC_UNUSED,
+              guint* real_order)
+{
+  GArray* edges;
+  guint iter;
+
+  *real_order = MAX(order, 2);
+  edges = g_array_sized_new(FALSE, FALSE, sizeof(BenchEdge), *real_order - 1);
+  for (iter = 1; iter < *real_order; iter++)
+  {
+    add_edge(edges, 0, iter);
+  }
+
+  return edges;
+}
+
+static const BenchGenerator generators[] =
+{
+  {"rmat", generate_rmat},
+  {"erdos-renyi", generate_erdos_renyi},
+  {"grid", generate_grid},
+  {"path", generate_path},
+  {"star", generate_star}
+};
+
+static const gchar* const generator_names[] =
+{
+  "rmat",
+  "erdos-renyi",
+  "grid",
+  "path",
+  "star",
+  NULL
+};
+
+GArray*
+bench_generate(const gchar* name,
+               guint order,
+               guint size,
+               GRand* rand,
+               guint* real_order)
+{
+  guint iter;
+
+  for (iter = 0; iter < G_N_ELEMENTS(generators); iter++)
+  {
+    if (!strcmp(generators[iter].name, name))
+    {
+      return (*generators[iter].func)(order, size, rand, real_order);
+    }
+  }
+  return NULL;
+}
+
+const gchar* const*
+bench_get_generator_names(void)
+{
+  return generator_names;
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BENCH_GENERATORS_H_
+#define _BENCH_GENERATORS_H_
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* An edge of generated graph. Nodes are numbered from 0. */
+typedef struct _BenchEdge BenchEdge;
+
+struct _BenchEdge
+{
+  guint32 first;
+  guint32 second;
+};
+
+/* Generates a graph and returns a GArray of BenchEdges. ORDER is rounded as
+ * generator needs - up to a power of two for RMAT and down to a square for
+ * grid - and real order is stored in REAL_ORDER. SIZE is used only by RMAT
+ * and Erdos-Renyi generators, others have it determined by ORDER. Returns
+ * NULL if there is no generator called NAME.
+ */
+GArray*
+bench_generate(const gchar* name,
+               guint order,
+               guint size,
+               GRand* rand,
+               guint* real_order);
+
+/* NULL terminated array of generator names. */
+const gchar* const*
+bench_get_generator_names(void);
+
+G_END_DECLS
+
+#endif /* _BENCH_GENERATORS_H_ */
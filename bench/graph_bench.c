@@ -0,0 +1,554 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <gsgraph/gsgraph.h>
+#include <gsgraph/gsegraph.h>
+
+#ifdef G_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+#include "generators.h"
+
+/* Times basic operations of both graph kinds on synthetic graphs and prints
+ * one tab separated line per operation, so results of different releases can
+ * be compared by scripts. Operations on whole graph report time per edge of
+ * input or of the largest separate graph, queries report time per query.
+ * Peak resident set size is the process-wide maximum reached so far.
+ *
+ * Effect of reordering on cache behaviour is shown by breadth first traversals
+ * of the largest graph copied into an arena in its original order and in each
+ * computed order.
+ *
+ * Usage: graph_bench [GENERATOR|all [ORDER [SIZE [SEED [THREADS]]]]]
+ *
+ * SIZE is number of edges of RMAT and Erdos-Renyi graphs and defaults to
+ * eight times ORDER. THREADS is number of threads used by parallel operations
+ * and defaults to 4.
+ */
+
+/* number of are_separate and is_bridge queries. */
+#define QUERIES 16
+
+/* names of orderings, indexed by GSGraphOrdering and GSEGraphOrdering. */
+static const gchar* const ordering_names[] = {"rcm", "degree", "bfs"};
+
+typedef struct _BenchRun BenchRun;
+
+struct _BenchRun
+{
+  const gchar* generator;
+  guint order;
+  guint size;
+  guint n_threads;
+  GTimer* timer;
+};
+
+static glong
+get_peak_rss(void)
+{
+#ifdef G_OS_UNIX
+  struct rusage usage;
+
+  if (!getrusage(RUSAGE_SELF, &usage))
+  {
+    return usage.ru_maxrss;
+  }
+#endif
+  return 0;
+}
+
+static void
+start_timing(BenchRun* run)
+{
+  g_timer_start(run->timer);
+}
+
+static void
+stop_timing(BenchRun* run,
+            const gchar* operation,
+            guint items)
+{
+  gdouble time;
+
+  g_timer_stop(run->timer);
+  time = g_timer_elapsed(run->timer, NULL) * G_USEC_PER_SEC;
+  g_print("%s\t%u\t%u\t%s\t%u\t%.0f\t%.1f\t%ld\n",
+          run->generator, run->order, run->size, operation, items, time,
+          items ? time * 1000.0 / items : 0.0, get_peak_rss());
+}
+
+static gpointer
+copy_data(gconstpointer data,
+          gpointer user_data G_GNUC_UNUSED)
+{
+  return (gpointer)data;
+}
+
+static void
+free_blocks(GPtrArray* blocks)
+{
+  guint iter;
+
+  for (iter = 0; iter < blocks->len; iter++)
+  {
+    g_array_free(g_ptr_array_index(blocks, iter), TRUE);
+  }
+  g_ptr_array_free(blocks, TRUE);
+}
+
+static GSGraphSnapshot*
+get_largest_sgraph(GPtrArray* graphs)
+{
+  GSGraphSnapshot* largest;
+  guint iter;
+
+  largest = g_ptr_array_index(graphs, 0);
+  for (iter = 1; iter < graphs->len; iter++)
+  {
+    GSGraphSnapshot* graph;
+
+    graph = g_ptr_array_index(graphs, iter);
+    if (graph->node_array->len > largest->node_array->len)
+    {
+      largest = graph;
+    }
+  }
+  return largest;
+}
+
+static GSEGraphSnapshot*
+get_largest_segraph(GPtrArray* graphs)
+{
+  GSEGraphSnapshot* largest;
+  guint iter;
+
+  largest = g_ptr_array_index(graphs, 0);
+  for (iter = 1; iter < graphs->len; iter++)
+  {
+    GSEGraphSnapshot* graph;
+
+    graph = g_ptr_array_index(graphs, iter);
+    if (graph->node_array->len > largest->node_array->len)
+    {
+      largest = graph;
+    }
+  }
+  return largest;
+}
+
+static void
+bench_sgraph_orderings(BenchRun* run,
+                       GSGraphSnapshot* largest,
+                       guint size)
+{
+  GSGraphArena* arena;
+  GSGraphSnapshot* graph;
+  GSGraphSnapshot* bfs_graph;
+  GSGraphNode* start;
+  gchar* operation;
+  guint iter;
+
+  arena = g_sgraph_arena_new();
+  graph = g_sgraph_snapshot_copy_in_arena(largest, arena, NULL, NULL);
+  start = g_ptr_array_index(graph->node_array, 0);
+  start_timing(run);
+  bfs_graph = g_sgraph_snapshot_new_from_node(start, G_SGRAPH_TRAVERSE_BFS);
+  stop_timing(run, "sgraph_bfs_snapshot_unordered", size);
+  g_sgraph_snapshot_free(bfs_graph, FALSE);
+  g_sgraph_snapshot_free(graph, FALSE);
+  g_sgraph_arena_free(arena, NULL);
+
+  for (iter = 0; iter < G_N_ELEMENTS(ordering_names); iter++)
+  {
+    arena = g_sgraph_arena_new();
+    operation = g_strdup_printf("sgraph_reorder_%s", ordering_names[iter]);
+    start_timing(run);
+    graph = g_sgraph_snapshot_reorder(largest, arena, iter);
+    stop_timing(run, operation, size);
+    g_free(operation);
+
+    operation = g_strdup_printf("sgraph_bfs_snapshot_%s", ordering_names[iter]);
+    start = g_ptr_array_index(graph->node_array, 0);
+    start_timing(run);
+    bfs_graph = g_sgraph_snapshot_new_from_node(start, G_SGRAPH_TRAVERSE_BFS);
+    stop_timing(run, operation, size);
+    g_free(operation);
+
+    g_sgraph_snapshot_free(bfs_graph, FALSE);
+    g_sgraph_snapshot_free(graph, FALSE);
+    g_sgraph_arena_free(arena, NULL);
+  }
+}
+
+static void
+bench_segraph_orderings(BenchRun* run,
+                        GSEGraphSnapshot* largest,
+                        guint size)
+{
+  GSEGraphArena* arena;
+  GSEGraphSnapshot* graph;
+  GSEGraphSnapshot* bfs_graph;
+  GSEGraphNode* start;
+  gchar* operation;
+  guint iter;
+
+  arena = g_segraph_arena_new();
+  graph = g_segraph_snapshot_copy_in_arena(largest, arena, NULL, NULL, NULL,
+                                           NULL);
+  start = g_ptr_array_index(graph->node_array, 0);
+  start_timing(run);
+  bfs_graph = g_segraph_snapshot_new_from_node(start, G_SEGRAPH_TRAVERSE_BFS);
+  stop_timing(run, "segraph_bfs_snapshot_unordered", size);
+  g_segraph_snapshot_free(bfs_graph, FALSE);
+  g_segraph_snapshot_free(graph, FALSE);
+  g_segraph_arena_free(arena, NULL, NULL);
+
+  for (iter = 0; iter < G_N_ELEMENTS(ordering_names); iter++)
+  {
+    arena = g_segraph_arena_new();
+    operation = g_strdup_printf("segraph_reorder_%s", ordering_names[iter]);
+    start_timing(run);
+    graph = g_segraph_snapshot_reorder(largest, arena, iter);
+    stop_timing(run, operation, size);
+    g_free(operation);
+
+    operation = g_strdup_printf("segraph_bfs_snapshot_%s",
+                                ordering_names[iter]);
+    start = g_ptr_array_index(graph->node_array, 0);
+    start_timing(run);
+    bfs_graph = g_segraph_snapshot_new_from_node(start, G_SEGRAPH_TRAVERSE_BFS);
+    stop_timing(run, operation, size);
+    g_free(operation);
+
+    g_segraph_snapshot_free(bfs_graph, FALSE);
+    g_segraph_snapshot_free(graph, FALSE);
+    g_segraph_arena_free(arena, NULL, NULL);
+  }
+}
+
+static void
+bench_sgraph_csr(BenchRun* run,
+                 GSGraphSnapshot* largest,
+                 guint size)
+{
+  GSGraphCsr* csr;
+  GArray* depths;
+  GArray* parents;
+  gchar* operation;
+
+  csr = g_sgraph_csr_new(largest);
+
+  start_timing(run);
+  depths = g_sgraph_csr_bfs_parallel(csr, 0, &parents, 1);
+  stop_timing(run, "sgraph_csr_bfs", size);
+  g_array_free(depths, TRUE);
+  g_array_free(parents, TRUE);
+
+  operation = g_strdup_printf("sgraph_csr_bfs_parallel_%u", run->n_threads);
+  start_timing(run);
+  depths = g_sgraph_csr_bfs_parallel(csr, 0, &parents, run->n_threads);
+  stop_timing(run, operation, size);
+  g_free(operation);
+  g_array_free(depths, TRUE);
+  g_array_free(parents, TRUE);
+
+  g_sgraph_csr_free(csr);
+}
+
+static void
+bench_sgraph(BenchRun* run,
+             GArray* edges,
+             GRand* rand)
+{
+  GSGraphDataPair** data_pairs;
+  GPtrArray* graphs;
+  GSGraphSnapshot* largest;
+  GSGraphSnapshot* graph;
+  GSGraphNode* start;
+  GPtrArray* blocks;
+  GArray* labels;
+  gchar* operation;
+  guint size;
+  guint iter;
+
+  data_pairs = g_new(GSGraphDataPair*, edges->len);
+  for (iter = 0; iter < edges->len; iter++)
+  {
+    BenchEdge* edge;
+    gpointer first;
+    gpointer second;
+
+    /* data are shifted by one, because NULL data make pair invalid. */
+    edge = &g_array_index(edges, BenchEdge, iter);
+    first = GUINT_TO_POINTER(edge->first + 1);
+    second = GUINT_TO_POINTER(edge->second + 1);
+    data_pairs[iter] = g_sgraph_data_pair_new(first, second);
+  }
+
+  start_timing(run);
+  graphs = g_sgraph_snapshot_new(data_pairs, edges->len);
+  stop_timing(run, "sgraph_snapshot_new", edges->len);
+  g_sgraph_data_pair_free_v(data_pairs, edges->len, TRUE);
+
+  largest = get_largest_sgraph(graphs);
+  size = g_sgraph_snapshot_get_size(largest);
+  start = g_ptr_array_index(largest->node_array, 0);
+
+  start_timing(run);
+  graph = g_sgraph_snapshot_new_from_node(start, G_SGRAPH_TRAVERSE_BFS);
+  stop_timing(run, "sgraph_bfs_snapshot", size);
+  g_sgraph_snapshot_free(graph, FALSE);
+
+  start_timing(run);
+  graph = g_sgraph_snapshot_new_from_node(start, G_SGRAPH_TRAVERSE_DFS);
+  stop_timing(run, "sgraph_dfs_snapshot", size);
+  g_sgraph_snapshot_free(graph, FALSE);
+
+  start_timing(run);
+  graph = g_sgraph_snapshot_copy(largest);
+  stop_timing(run, "sgraph_copy", size);
+  g_sgraph_snapshot_free(graph, TRUE);
+
+  start_timing(run);
+  graph = g_sgraph_snapshot_copy_deep(largest, copy_data, NULL);
+  stop_timing(run, "sgraph_copy_deep", size);
+  g_sgraph_snapshot_free(graph, TRUE);
+
+  bench_sgraph_orderings(run, largest, size);
+  bench_sgraph_csr(run, largest, size);
+
+  operation = g_strdup_printf("sgraph_label_components_%u", run->n_threads);
+  start_timing(run);
+  labels = g_sgraph_snapshot_label_components(largest->node_array, NULL,
+                                              run->n_threads);
+  stop_timing(run, operation, size);
+  g_free(operation);
+  g_array_free(labels, TRUE);
+
+  start_timing(run);
+  for (iter = 0; iter < QUERIES; iter++)
+  {
+    GSGraphNode* node;
+    GSGraphNode* other_node;
+
+    node = g_ptr_array_index(largest->node_array,
+                             g_rand_int_range(rand, 0,
+                                              largest->node_array->len));
+    other_node = g_ptr_array_index(largest->node_array,
+                                   g_rand_int_range(rand, 0,
+                                                    largest->node_array->len));
+    g_sgraph_node_are_separate(node, other_node);
+  }
+  stop_timing(run, "sgraph_are_separate", QUERIES);
+
+  start_timing(run);
+  blocks = g_sgraph_snapshot_find_blocks(largest, &labels);
+  stop_timing(run, "sgraph_find_blocks", size);
+  free_blocks(blocks);
+  g_array_free(labels, TRUE);
+
+  for (iter = 0; iter < graphs->len; iter++)
+  {
+    g_sgraph_snapshot_free(g_ptr_array_index(graphs, iter), TRUE);
+  }
+  g_ptr_array_free(graphs, TRUE);
+}
+
+static void
+bench_segraph(BenchRun* run,
+              GArray* edges,
+              GRand* rand)
+{
+  GSEGraphDataTriplet** data_triplets;
+  GPtrArray* graphs;
+  GSEGraphSnapshot* largest;
+  GSEGraphSnapshot* graph;
+  GSEGraphNode* start;
+  GPtrArray* bridges;
+  GPtrArray* blocks;
+  GArray* labels;
+  GArray* edge_blocks;
+  gchar* operation;
+  guint size;
+  guint iter;
+
+  data_triplets = g_new(GSEGraphDataTriplet*, edges->len);
+  for (iter = 0; iter < edges->len; iter++)
+  {
+    BenchEdge* edge;
+    gpointer first;
+    gpointer second;
+
+    edge = &g_array_index(edges, BenchEdge, iter);
+    first = GUINT_TO_POINTER(edge->first + 1);
+    second = GUINT_TO_POINTER(edge->second + 1);
+    data_triplets[iter] = g_segraph_data_triplet_new(first, second, NULL);
+  }
+
+  start_timing(run);
+  graphs = g_segraph_snapshot_new(data_triplets, edges->len);
+  stop_timing(run, "segraph_snapshot_new", edges->len);
+  g_segraph_data_triplet_free_v(data_triplets, edges->len, TRUE);
+
+  largest = get_largest_segraph(graphs);
+  size = g_segraph_snapshot_get_size(largest);
+  start = g_ptr_array_index(largest->node_array, 0);
+
+  start_timing(run);
+  graph = g_segraph_snapshot_new_from_node(start, G_SEGRAPH_TRAVERSE_BFS);
+  stop_timing(run, "segraph_bfs_snapshot", size);
+  g_segraph_snapshot_free(graph, FALSE);
+
+  start_timing(run);
+  graph = g_segraph_snapshot_new_from_node(start, G_SEGRAPH_TRAVERSE_DFS);
+  stop_timing(run, "segraph_dfs_snapshot", size);
+  g_segraph_snapshot_free(graph, FALSE);
+
+  start_timing(run);
+  graph = g_segraph_snapshot_copy(largest);
+  stop_timing(run, "segraph_copy", size);
+  g_segraph_snapshot_free(graph, TRUE);
+
+  start_timing(run);
+  graph = g_segraph_snapshot_copy_deep(largest, copy_data, NULL, copy_data,
+                                       NULL);
+  stop_timing(run, "segraph_copy_deep", size);
+  g_segraph_snapshot_free(graph, TRUE);
+
+  bench_segraph_orderings(run, largest, size);
+
+  operation = g_strdup_printf("segraph_label_components_%u", run->n_threads);
+  start_timing(run);
+  labels = g_segraph_snapshot_label_components(largest->node_array, NULL,
+                                               run->n_threads);
+  stop_timing(run, operation, size);
+  g_free(operation);
+  g_array_free(labels, TRUE);
+
+  start_timing(run);
+  for (iter = 0; iter < QUERIES; iter++)
+  {
+    GSEGraphEdge* edge;
+
+    edge = g_ptr_array_index(largest->edge_array,
+                             g_rand_int_range(rand, 0,
+                                              largest->edge_array->len));
+    g_segraph_edge_is_bridge(edge);
+  }
+  stop_timing(run, "segraph_is_bridge", QUERIES);
+
+  start_timing(run);
+  bridges = g_segraph_snapshot_find_bridges(largest);
+  stop_timing(run, "segraph_find_bridges", size);
+  g_ptr_array_free(bridges, TRUE);
+
+  start_timing(run);
+  blocks = g_segraph_snapshot_find_blocks(largest, &labels, &edge_blocks);
+  stop_timing(run, "segraph_find_blocks", size);
+  free_blocks(blocks);
+  g_array_free(edge_blocks, TRUE);
+  g_array_free(labels, TRUE);
+
+  for (iter = 0; iter < graphs->len; iter++)
+  {
+    g_segraph_snapshot_free(g_ptr_array_index(graphs, iter), TRUE);
+  }
+  g_ptr_array_free(graphs, TRUE);
+}
+
+static gboolean
+bench_generator(const gchar* name,
+                guint order,
+                guint size,
+                guint seed,
+                guint n_threads)
+{
+  BenchRun run;
+  GArray* edges;
+  GRand* rand;
+
+  rand = g_rand_new_with_seed(seed);
+  edges = bench_generate(name, order, size, rand, &run.order);
+  if (!edges)
+  {
+    g_rand_free(rand);
+    return FALSE;
+  }
+  run.generator = name;
+  run.size = edges->len;
+  run.n_threads = n_threads;
+  run.timer = g_timer_new();
+
+  bench_sgraph(&run, edges, rand);
+  bench_segraph(&run, edges, rand);
+
+  g_timer_destroy(run.timer);
+  g_array_free(edges, TRUE);
+  g_rand_free(rand);
+  return TRUE;
+}
+
+int
+main(int argc,
+     char** argv)
+{
+  const gchar* name;
+  guint order;
+  guint size;
+  guint seed;
+  guint n_threads;
+
+  name = (argc > 1) ? argv[1] : "all";
+  order = (argc > 2) ? (guint)atoi(argv[2]) : 100000;
+  size = (argc > 3) ? (guint)atoi(argv[3]) : 8 * order;
+  seed = (argc > 4) ? (guint)atoi(argv[4]) : 42;
+  n_threads = (argc > 5) ? (guint)atoi(argv[5]) : 4;
+  if (order < 2)
+  {
+    g_printerr("ORDER must be at least 2.\n");
+    return 1;
+  }
+
+  if (!g_thread_supported())
+  {
+    g_thread_init(NULL);
+  }
+  g_print("generator\torder\tedges\toperation\titems\tusec\tns_per_item"
+          "\tpeak_rss_kb\n");
+  if (!strcmp(name, "all"))
+  {
+    const gchar* const* names;
+
+    for (names = bench_get_generator_names(); *names; names++)
+    {
+      bench_generator(*names, order, size, seed, n_threads);
+    }
+  }
+  else if (!bench_generator(name, order, size, seed, n_threads))
+  {
+    g_printerr("Unknown generator `%s'.\n", name);
+    return 1;
+  }
+
+  return 0;
+}
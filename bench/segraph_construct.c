@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+
+#include <gsgraph/gsegraph.h>
+
+/* Builds the same multigraph with g_segraph_snapshot_new() twice - once from
+ * triplets in "sorted" order, where every triplet but the first one touches
+ * already created node, and once from the same triplets shuffled. Graph is a
+ * random tree with additional random links, multiple edges, loops and
+ * half-edges.
+ *
+ * Usage: segraph_construct [ORDER [EXTRA_EDGES [SEED]]]
+ */
+
+static GSEGraphDataTriplet**
+create_triplets(guint order,
+                guint extra_edges,
+                GRand* rand,
+                guint* count)
+{
+  GSEGraphDataTriplet** triplets;
+  guint iter;
+  guint index;
+
+  *count = (order - 1) + extra_edges;
+  triplets = g_new(GSEGraphDataTriplet*, *count);
+  index = 0;
+
+  /* tree edges - parent always exists before its child. */
+  for (iter = 1; iter < order; iter++)
+  {
+    guint parent;
+
+    parent = g_rand_int_range(rand, 0, iter);
+    triplets[index++] = g_segraph_data_triplet_new(GUINT_TO_POINTER(parent + 1),
+                                                   GUINT_TO_POINTER(iter + 1),
+                                                   NULL);
+  }
+
+  /* extra edges - every eighth is a loop and every eighth is a half-edge. */
+  for (iter = 0; iter < extra_edges; iter++)
+  {
+    guint first;
+    guint second;
+    gpointer second_data;
+
+    first = g_rand_int_range(rand, 0, order);
+    second = g_rand_int_range(rand, 0, order);
+    switch (iter % 8)
+    {
+      case 0:
+      {
+        second_data = GUINT_TO_POINTER(first + 1);
+        break;
+      }
+      case 1:
+      {
+        second_data = NULL;
+        break;
+      }
+      default:
+      {
+        second_data = GUINT_TO_POINTER(second + 1);
+        break;
+      }
+    }
+    triplets[index++] = g_segraph_data_triplet_new(GUINT_TO_POINTER(first + 1),
+                                                   second_data,
+                                                   NULL);
+  }
+
+  return triplets;
+}
+
+static void
+shuffle_triplets(GSEGraphDataTriplet** triplets,
+                 guint count,
+                 GRand* rand)
+{
+  guint iter;
+
+  for (iter = count - 1; iter > 0; iter--)
+  {
+    guint other;
+    GSEGraphDataTriplet* temp;
+
+    other = g_rand_int_range(rand, 0, iter + 1);
+    temp = triplets[iter];
+    triplets[iter] = triplets[other];
+    triplets[other] = temp;
+  }
+}
+
+static gdouble
+time_construction(GSEGraphDataTriplet** triplets,
+                  guint count,
+                  guint* graph_count)
+{
+  GPtrArray* graphs;
+  GTimer* timer;
+  gdouble usec;
+  guint iter;
+
+  timer = g_timer_new();
+  graphs = g_segraph_snapshot_new(triplets, count);
+  g_timer_stop(timer);
+  usec = g_timer_elapsed(timer, NULL) * G_USEC_PER_SEC;
+  g_timer_destroy(timer);
+
+  *graph_count = graphs->len;
+  for (iter = 0; iter < graphs->len; iter++)
+  {
+    g_segraph_snapshot_free(g_ptr_array_index(graphs, iter), TRUE);
+  }
+  g_ptr_array_free(graphs, TRUE);
+
+  return usec;
+}
+
+int
+main(int argc,
+     char** argv)
+{
+  GSEGraphDataTriplet** triplets;
+  GRand* rand;
+  guint order;
+  guint extra_edges;
+  guint seed;
+  guint count;
+  guint sorted_graphs;
+  guint shuffled_graphs;
+  gdouble sorted_time;
+  gdouble shuffled_time;
+
+  order = (argc > 1) ? (guint)atoi(argv[1]) : 1000000;
+  extra_edges = (argc > 2) ? (guint)atoi(argv[2]) : order;
+  seed = (argc > 3) ? (guint)atoi(argv[3]) : 42;
+  if (order < 2)
+  {
+    g_printerr("ORDER must be at least 2.\n");
+    return 1;
+  }
+
+  rand = g_rand_new_with_seed(seed);
+  triplets = create_triplets(order, extra_edges, rand, &count);
+
+  sorted_time = time_construction(triplets, count, &sorted_graphs);
+  shuffle_triplets(triplets, count, rand);
+  shuffled_time = time_construction(triplets, count, &shuffled_graphs);
+
+  g_print("input\ttriplets\tgraphs\tusec\tns_per_triplet\n");
+  g_print("sorted\t%u\t%u\t%.0f\t%.1f\n", count, sorted_graphs,
+          sorted_time, sorted_time * 1000.0 / count);
+  g_print("shuffled\t%u\t%u\t%.0f\t%.1f\n", count,
+          shuffled_graphs, shuffled_time, shuffled_time * 1000.0 / count);
+
+  g_segraph_data_triplet_free_v(triplets, count, TRUE);
+  g_rand_free(rand);
+  return 0;
+}
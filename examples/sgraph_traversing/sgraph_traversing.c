@@ -65,17 +65,6 @@ g_sgraph_node_connect(NODE(desc1), NODE(desc2))
 #undef NODE
 }
 
-gboolean
-find_node(GSGraphNode* node,
-          const gchar* desc)
-{
-  if (g_strcmp0(node->data, desc))
-  {
-    return FALSE;
-  }
-  return TRUE;
-}
-
 void
 print_node_desc(GSGraphNode* node,
                 gpointer user_data G_GNUC_UNUSED)
@@ -104,7 +93,8 @@ main(void)
   graph = g_sgraph_snapshot_new_from_node(node, G_SGRAPH_TRAVERSE_DFS);
   g_print("\nDFS from `A':");
   g_sgraph_snapshot_foreach_node(graph, (GFunc)print_node_desc, NULL);
-  node = g_sgraph_snapshot_find_node_custom(graph, "I", (GEqualFunc)find_node);
+  g_sgraph_snapshot_build_index(graph, g_str_hash, g_str_equal, 1);
+  node = g_sgraph_snapshot_lookup_node(graph, "I");
   g_sgraph_snapshot_free(graph, FALSE);
   graph = g_sgraph_snapshot_new_from_node(node, G_SGRAPH_TRAVERSE_BFS);
   g_print("\nBFS from `I':");
@@ -28,6 +28,11 @@
 #include <gsgraph/gsegraphedge.h>
 #include <gsgraph/gsegraphdatatriplet.h>
 #include <gsgraph/gsegraphsnapshot.h>
+#include <gsgraph/gsegraphiter.h>
+#include <gsgraph/gsegraphcsr.h>
+#include <gsgraph/gsegraphconnectivity.h>
+#include <gsgraph/gsegrapharena.h>
+#include <gsgraph/gsegraphvisitmarks.h>
 #include <gsgraph/gsegraphenums.h>
 
 #undef _G_SEGRAPH_H_INSIDE_
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsegrapharena.h"
+#include "gsegrapharenaprivate.h"
+
+#include "gsegraphnodeprivate.h"
+#include "gsgraphblocks.h"
+
+/**
+ * SECTION: gsegrapharena
+ * @title: Simple edged graph arena
+ * @short_description: allocator of nodes and edges freed all at once.
+ * @include: gsgraph/gsegraph.h
+ * @see_also: #GSEGraphNode, #GSEGraphEdge, g_segraph_node_new_in_arena(),
+ * g_segraph_edge_new_in_arena()
+ *
+ * Allocator handing out nodes and edges from big blocks of memory. Nodes and
+ * edges themselves take one allocation per thousand of them instead of one per
+ * each and their memory is released in bulk. Edges own no other memory, so
+ * unless their data has to be freed, they are released without being visited.
+ * Every node still owns its edges array, which is a #GPtrArray allocated by
+ * GLib, so creating a node allocates that array and freeing the arena walks
+ * all nodes to free their arrays. Freeing an arena therefore takes time linear
+ * in number of nodes created in it.
+ *
+ * To create an arena, use g_segraph_arena_new().
+ *
+ * To create a node or an edge in arena, use g_segraph_node_new_in_arena() or
+ * g_segraph_edge_new_in_arena(). To build whole graphs in arena, use
+ * g_segraph_snapshot_new_in_arena() or g_segraph_snapshot_copy_in_arena().
+ *
+ * To free an arena with all its nodes and edges, use g_segraph_arena_free().
+ *
+ * To check its memory use, use g_segraph_arena_get_node_count(),
+ * g_segraph_arena_get_edge_count(), g_segraph_arena_get_reserved_size() and
+ * g_segraph_arena_get_used_size().
+ *
+ * <note>
+ *   <para>
+ *     Nodes and edges from an arena can be freed with g_segraph_node_free() and
+ *     g_segraph_edge_free() - their memory is reused by next nodes and edges
+ *     created in the arena. Arena is not thread safe.
+ *   </para>
+ * </note>
+ */
+
+/* internal types. */
+
+struct _GSEGraphArena
+{
+  GSGraphBlocks nodes;
+  GSGraphBlocks edges;
+};
+
+/* static function declarations. */
+
+static void
+_g_segraph_arena_free_node (gpointer element,
+                            gpointer data_destroy_func_ptr);
+
+static void
+_g_segraph_arena_free_edge (gpointer element,
+                            gpointer data_destroy_func_ptr);
+
+/* public function definitions. */
+
+/**
+ * g_segraph_arena_new:
+ *
+ * Creates new empty arena.
+ *
+ * Returns: newly created #GSEGraphArena.
+ */
+GSEGraphArena*
+g_segraph_arena_new (void)
+{
+  GSEGraphArena* arena;
+
+  arena = g_slice_new (GSEGraphArena);
+  _g_sgraph_blocks_init (&arena->nodes, sizeof (GSEGraphNode));
+  _g_sgraph_blocks_init (&arena->edges, sizeof (GSEGraphEdge));
+
+  return arena;
+}
+
+/**
+ * g_segraph_arena_free:
+ * @arena: arena to free.
+ * @node_data_destroy_func: function freeing data of nodes or %NULL.
+ * @edge_data_destroy_func: function freeing data of edges or %NULL.
+ *
+ * Frees @arena together with all nodes and edges allocated from it. Memory of
+ * nodes and edges is released in blocks, but edges array of every node not
+ * freed before is freed separately, so it takes time linear in number of nodes
+ * created in @arena. Edges are visited only if @edge_data_destroy_func is not
+ * %NULL. Nodes and edges from @arena must not be connected to ones from outside
+ * of it, because these would keep pointers to freed memory.
+ */
+void
+g_segraph_arena_free (GSEGraphArena* arena,
+                      GDestroyNotify node_data_destroy_func,
+                      GDestroyNotify edge_data_destroy_func)
+{
+  g_return_if_fail (arena != NULL);
+
+  _g_sgraph_blocks_foreach (&arena->nodes,
+                            _g_segraph_arena_free_node,
+                            &node_data_destroy_func);
+  if (edge_data_destroy_func)
+  {
+    _g_sgraph_blocks_foreach (&arena->edges,
+                              _g_segraph_arena_free_edge,
+                              &edge_data_destroy_func);
+  }
+  _g_sgraph_blocks_clear (&arena->nodes);
+  _g_sgraph_blocks_clear (&arena->edges);
+  g_slice_free (GSEGraphArena, arena);
+}
+
+/**
+ * g_segraph_arena_get_node_count:
+ * @arena: an arena.
+ *
+ * Gets number of nodes in @arena which were not freed.
+ *
+ * Returns: number of nodes.
+ */
+guint
+g_segraph_arena_get_node_count (GSEGraphArena* arena)
+{
+  g_return_val_if_fail (arena != NULL, 0);
+
+  return arena->nodes.count;
+}
+
+/**
+ * g_segraph_arena_get_edge_count:
+ * @arena: an arena.
+ *
+ * Gets number of edges in @arena which were not freed.
+ *
+ * Returns: number of edges.
+ */
+guint
+g_segraph_arena_get_edge_count (GSEGraphArena* arena)
+{
+  g_return_val_if_fail (arena != NULL, 0);
+
+  return arena->edges.count;
+}
+
+/**
+ * g_segraph_arena_get_reserved_size:
+ * @arena: an arena.
+ *
+ * Gets number of bytes @arena reserved for nodes and edges.
+ *
+ * Returns: reserved size in bytes.
+ */
+gsize
+g_segraph_arena_get_reserved_size (GSEGraphArena* arena)
+{
+  g_return_val_if_fail (arena != NULL, 0);
+
+  return _g_sgraph_blocks_get_reserved_size (&arena->nodes) +
+         _g_sgraph_blocks_get_reserved_size (&arena->edges);
+}
+
+/**
+ * g_segraph_arena_get_used_size:
+ * @arena: an arena.
+ *
+ * Gets number of bytes taken by nodes and edges in @arena which were not
+ * freed. Memory of edges arrays of nodes is not counted.
+ *
+ * Returns: used size in bytes.
+ */
+gsize
+g_segraph_arena_get_used_size (GSEGraphArena* arena)
+{
+  g_return_val_if_fail (arena != NULL, 0);
+
+  return (gsize)arena->nodes.count * sizeof (GSEGraphNode) +
+         (gsize)arena->edges.count * sizeof (GSEGraphEdge);
+}
+
+/* internal function definitions. */
+
+/**
+ * _g_segraph_arena_alloc_node:
+ * @arena: an arena.
+ *
+ * Hands out memory for a node. Node has to be initialized by caller.
+ *
+ * Returns: uninitialized node.
+ */
+GSEGraphNode*
+_g_segraph_arena_alloc_node (GSEGraphArena* arena)
+{
+  return _g_sgraph_blocks_alloc (&arena->nodes);
+}
+
+/**
+ * _g_segraph_arena_release_node:
+ * @arena: an arena.
+ * @node: a disposed node allocated from @arena.
+ *
+ * Gives memory of @node back to @arena.
+ */
+void
+_g_segraph_arena_release_node (GSEGraphArena* arena,
+                               GSEGraphNode* node)
+{
+  _g_sgraph_blocks_release (&arena->nodes, node);
+}
+
+/**
+ * _g_segraph_arena_alloc_edge:
+ * @arena: an arena.
+ *
+ * Hands out memory for an edge. Edge has to be initialized by caller.
+ *
+ * Returns: uninitialized edge.
+ */
+GSEGraphEdge*
+_g_segraph_arena_alloc_edge (GSEGraphArena* arena)
+{
+  return _g_sgraph_blocks_alloc (&arena->edges);
+}
+
+/**
+ * _g_segraph_arena_release_edge:
+ * @arena: an arena.
+ * @edge: an edge allocated from @arena.
+ *
+ * Gives memory of @edge back to @arena. Arena of @edge is set to %NULL, so
+ * freed edges can be told apart from used ones.
+ */
+void
+_g_segraph_arena_release_edge (GSEGraphArena* arena,
+                               GSEGraphEdge* edge)
+{
+  edge->arena = NULL;
+  _g_sgraph_blocks_release (&arena->edges, edge);
+}
+
+/* static function definitions. */
+
+/**
+ * _g_segraph_arena_free_node:
+ * @element: a node slot.
+ * @data_destroy_func_ptr: pointer to #GDestroyNotify freeing data of node.
+ *
+ * Disposes a node in @element, unless it was already freed.
+ */
+static void
+_g_segraph_arena_free_node (gpointer element,
+                            gpointer data_destroy_func_ptr)
+{
+  GSEGraphNode* node;
+  GDestroyNotify data_destroy_func;
+
+  node = element;
+  if (!node->edges)
+  {
+    return;
+  }
+  data_destroy_func = *(GDestroyNotify*)data_destroy_func_ptr;
+  if (data_destroy_func)
+  {
+    (*data_destroy_func) (node->data);
+  }
+  _g_segraph_node_dispose (node);
+}
+
+/**
+ * _g_segraph_arena_free_edge:
+ * @element: an edge slot.
+ * @data_destroy_func_ptr: pointer to #GDestroyNotify freeing data of edge.
+ *
+ * Frees data of an edge in @element, unless the edge was already freed.
+ */
+static void
+_g_segraph_arena_free_edge (gpointer element,
+                            gpointer data_destroy_func_ptr)
+{
+  GSEGraphEdge* edge;
+  GDestroyNotify data_destroy_func;
+
+  edge = element;
+  if (!edge->arena)
+  {
+    return;
+  }
+  data_destroy_func = *(GDestroyNotify*)data_destroy_func_ptr;
+  (*data_destroy_func) (edge->data);
+}
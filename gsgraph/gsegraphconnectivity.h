@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined (G_DISABLE_SINGLE_INCLUDES) && !defined (_G_SEGRAPH_H_INSIDE_) && !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "Only <gsgraph/gsegraph.h> can be included directly."
+#endif
+
+#ifndef _G_SEGRAPH_CONNECTIVITY_H_
+#define _G_SEGRAPH_CONNECTIVITY_H_
+
+#include <glib.h>
+
+#include <gsgraph/gsegraphtypedefs.h>
+#include <gsgraph/gsegraphnode.h>
+#include <gsgraph/gsegraphsnapshot.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GSEGraphConnectivity:
+ *
+ * Opaque index of connected components of nodes added to it.
+ */
+
+GSEGraphConnectivity*
+g_segraph_connectivity_new (void) G_GNUC_WARN_UNUSED_RESULT;
+
+void
+g_segraph_connectivity_free (GSEGraphConnectivity* connectivity);
+
+void
+g_segraph_connectivity_add_node (GSEGraphConnectivity* connectivity,
+                                 GSEGraphNode* node);
+
+void
+g_segraph_connectivity_add_graph (GSEGraphConnectivity* connectivity,
+                                  GSEGraphSnapshot* graph);
+
+gboolean
+g_segraph_connectivity_is_valid (GSEGraphConnectivity* connectivity);
+
+void
+g_segraph_connectivity_rebuild (GSEGraphConnectivity* connectivity);
+
+guint
+g_segraph_connectivity_get_count (GSEGraphConnectivity* connectivity);
+
+G_END_DECLS
+
+#endif /* _G_SEGRAPH_CONNECTIVITY_H_ */
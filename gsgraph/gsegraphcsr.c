@@ -0,0 +1,890 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsegraphcsr.h"
+#include "gsegraphnode.h"
+#include "gsegraphedge.h"
+#include "gsgraphbinary.h"
+
+/**
+ * SECTION: gsegraphcsr
+ * @title: Simple edged graph in compressed sparse row form
+ * @short_description: immutable, contiguous copy of a simple edged graph.
+ * @include: gsgraph/gsegraph.h
+ * @see_also: #GSEGraphSnapshot, #GSEGraphTraverseType
+ *
+ * Frozen copy of a graph held by #GSEGraphSnapshot. Edges of all nodes are
+ * stored in one array of 32-bit edge indices and each node owns a contiguous
+ * range of it, described by an offsets array. Ends of edges are stored in two
+ * arrays of 32-bit node indices. Node and edge data are stored in parallel
+ * arrays. Such layout makes scans over the graph touch memory sequentially
+ * instead of chasing pointers to separately allocated nodes and edges.
+ *
+ * Node with index i in #GSEGraphCsr is the i-th node of snapshot's node array,
+ * edge with index i is the i-th edge of snapshot's edge array and order of
+ * edges of each node is preserved, so traversing a #GSEGraphCsr visits nodes
+ * in the same order as traversing the nodes it was created from.
+ *
+ * To create a structure, use g_segraph_csr_new().
+ *
+ * To free it, use g_segraph_csr_free().
+ *
+ * To get number of nodes, edges or edges of a node, use
+ * g_segraph_csr_get_order(), g_segraph_csr_get_size() or
+ * g_segraph_csr_get_degree().
+ *
+ * To get indices of nodes in traversal order, use g_segraph_csr_traverse().
+ *
+ * To save a graph in a binary file, use g_segraph_csr_save(). To save
+ * a #GSEGraphSnapshot, create a #GSEGraphCsr from it first. To load a graph
+ * saved this way, use g_segraph_csr_load(). Loaded file is mapped into memory
+ * and offsets, edges, firsts and seconds arrays point straight into the
+ * mapping. Node and edge data are saved as payloads serialized with
+ * #GSEGraphCsrSaveFunc. They can be deserialized during loading with
+ * #GSEGraphCsrLoadFunc or read in place with g_segraph_csr_get_node_payload()
+ * and g_segraph_csr_get_edge_payload().
+ *
+ * <note>
+ *   <para>
+ *     #GSEGraphCsr is not updated when nodes or edges it was created from
+ *     change. Node and edge data are shared with original nodes and edges, so
+ *     freeing #GSEGraphCsr does not free them.
+ *   </para>
+ * </note>
+ */
+
+/* internal macros */
+
+/* identifies binary files holding #GSEGraphCsr. */
+#define G_SEGRAPH_CSR_MAGIC "GSEGRAPH"
+
+/* internal types. */
+
+/**
+ * GSEGraphCsrFrame:
+ * @index: index of node.
+ * @position: position in edges array of next edge to check.
+ *
+ * Internal struct used as a depth first search stack frame.
+ */
+typedef struct _GSEGraphCsrFrame GSEGraphCsrFrame;
+
+struct _GSEGraphCsrFrame
+{
+  guint32 index;
+  guint32 position;
+};
+
+/* static function declarations. */
+
+static guint32
+_g_segraph_csr_get_other (GSEGraphCsr* csr,
+                          guint32 edge,
+                          guint32 index);
+
+static void
+_g_segraph_csr_append_DFS (GSEGraphCsr* csr,
+                           guint32 index,
+                           GArray* indices,
+                           guint8* visited);
+
+static void
+_g_segraph_csr_append_BFS (GSEGraphCsr* csr,
+                           guint32 index,
+                           GArray* indices,
+                           guint8* visited);
+
+static guint32
+_g_segraph_csr_lookup (GHashTable* elements_to_indices,
+                       gpointer element);
+
+static const gchar*
+_g_segraph_csr_get_payload (const gchar* payloads,
+                            const guint64* payload_offsets,
+                            guint32 index,
+                            gsize* length);
+
+/* public function definitions. */
+
+/**
+ * g_segraph_csr_error_quark:
+ *
+ * Gets the error domain of #GSEGraphCsr file loading.
+ *
+ * Returns: error quark.
+ */
+GQuark
+g_segraph_csr_error_quark (void)
+{
+  return g_quark_from_static_string ("g-segraph-csr-error-quark");
+}
+
+/**
+ * g_segraph_csr_new:
+ * @graph: a graph.
+ *
+ * Creates a #GSEGraphCsr holding the same graph as @graph in O(V+E) time.
+ * @graph must hold both nodes and edges and all edges of nodes in @graph and
+ * all ends of edges in @graph must also be in @graph, which is always true for
+ * snapshots created by g_segraph_snapshot_new(),
+ * g_segraph_snapshot_new_from_node() and g_segraph_snapshot_new_from_edge().
+ *
+ * Returns: new #GSEGraphCsr or %NULL if @graph is not closed or too large.
+ */
+GSEGraphCsr*
+g_segraph_csr_new (GSEGraphSnapshot* graph)
+{
+  GSEGraphCsr* csr;
+  GHashTable* nodes_to_indices;
+  GHashTable* edges_to_indices;
+  guint64 total;
+  guint iter;
+  gboolean closed;
+
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->node_array != NULL, NULL);
+  g_return_val_if_fail (graph->edge_array != NULL, NULL);
+  g_return_val_if_fail (graph->node_array->len < G_MAXUINT32, NULL);
+  g_return_val_if_fail (graph->edge_array->len < G_MAXUINT32, NULL);
+
+  total = 0;
+  for (iter = 0; iter < graph->node_array->len; ++iter)
+  {
+    GSEGraphNode* node;
+
+    node = g_ptr_array_index (graph->node_array, iter);
+    total += node->edges->len;
+  }
+  g_return_val_if_fail (total < G_MAXUINT32, NULL);
+
+  nodes_to_indices = g_hash_table_new (NULL, NULL);
+  for (iter = 0; iter < graph->node_array->len; ++iter)
+  {
+    g_hash_table_insert (nodes_to_indices,
+                         g_ptr_array_index (graph->node_array, iter),
+                         GUINT_TO_POINTER (iter));
+  }
+  edges_to_indices = g_hash_table_new (NULL, NULL);
+  for (iter = 0; iter < graph->edge_array->len; ++iter)
+  {
+    g_hash_table_insert (edges_to_indices,
+                         g_ptr_array_index (graph->edge_array, iter),
+                         GUINT_TO_POINTER (iter));
+  }
+
+  csr = g_slice_new (GSEGraphCsr);
+  csr->order = graph->node_array->len;
+  csr->size = graph->edge_array->len;
+  csr->offsets = g_new (guint32, csr->order + 1);
+  csr->edges = g_new (guint32, total);
+  csr->firsts = g_new (guint32, csr->size);
+  csr->seconds = g_new (guint32, csr->size);
+  csr->node_data = g_new (gpointer, csr->order);
+  csr->edge_data = g_new (gpointer, csr->size);
+  csr->mapped_file = NULL;
+  csr->node_payloads = NULL;
+  csr->node_payload_offsets = NULL;
+  csr->edge_payloads = NULL;
+  csr->edge_payload_offsets = NULL;
+
+  closed = TRUE;
+  csr->offsets[0] = 0;
+  for (iter = 0; closed && (iter < csr->order); ++iter)
+  {
+    GSEGraphNode* node;
+    guint32 offset;
+    guint iter2;
+
+    node = g_ptr_array_index (graph->node_array, iter);
+    offset = csr->offsets[iter];
+    csr->node_data[iter] = node->data;
+    for (iter2 = 0; iter2 < node->edges->len; ++iter2)
+    {
+      guint32 edge_index;
+
+      edge_index = _g_segraph_csr_lookup (edges_to_indices,
+                                          g_ptr_array_index (node->edges,
+                                                             iter2));
+      if (edge_index == G_MAXUINT32)
+      {
+        closed = FALSE;
+        break;
+      }
+      csr->edges[offset + iter2] = edge_index;
+    }
+    csr->offsets[iter + 1] = offset + node->edges->len;
+  }
+
+  for (iter = 0; closed && (iter < csr->size); ++iter)
+  {
+    GSEGraphEdge* edge;
+
+    edge = g_ptr_array_index (graph->edge_array, iter);
+    csr->edge_data[iter] = edge->data;
+    csr->firsts[iter] = G_MAXUINT32;
+    csr->seconds[iter] = G_MAXUINT32;
+    if (edge->first)
+    {
+      csr->firsts[iter] = _g_segraph_csr_lookup (nodes_to_indices,
+                                                 edge->first);
+      closed = (csr->firsts[iter] != G_MAXUINT32);
+    }
+    if (closed && edge->second)
+    {
+      csr->seconds[iter] = _g_segraph_csr_lookup (nodes_to_indices,
+                                                  edge->second);
+      closed = (csr->seconds[iter] != G_MAXUINT32);
+    }
+  }
+
+  g_hash_table_unref (nodes_to_indices);
+  g_hash_table_unref (edges_to_indices);
+  if (!closed)
+  {
+    g_segraph_csr_free (csr);
+    g_return_val_if_reached (NULL);
+  }
+  return csr;
+}
+
+/**
+ * g_segraph_csr_free:
+ * @csr: #GSEGraphCsr to free.
+ *
+ * Frees memory allocated to @csr. Node and edge data are not freed.
+ */
+void
+g_segraph_csr_free (GSEGraphCsr* csr)
+{
+  g_return_if_fail (csr != NULL);
+
+  if (csr->mapped_file)
+  {
+    g_mapped_file_free (csr->mapped_file);
+  }
+  else
+  {
+    g_free (csr->offsets);
+    g_free (csr->edges);
+    g_free (csr->firsts);
+    g_free (csr->seconds);
+  }
+  g_free (csr->node_data);
+  g_free (csr->edge_data);
+  g_slice_free (GSEGraphCsr, csr);
+}
+
+/**
+ * g_segraph_csr_get_order:
+ * @csr: a graph.
+ *
+ * Gets @csr's order, that is - number of nodes in graph.
+ *
+ * Returns: number of nodes in graph.
+ */
+guint
+g_segraph_csr_get_order (GSEGraphCsr* csr)
+{
+  g_return_val_if_fail (csr != NULL, 0);
+
+  return csr->order;
+}
+
+/**
+ * g_segraph_csr_get_size:
+ * @csr: a graph.
+ *
+ * Gets @csr's size, that is - number of edges in graph.
+ *
+ * Returns: number of edges in graph.
+ */
+guint
+g_segraph_csr_get_size (GSEGraphCsr* csr)
+{
+  g_return_val_if_fail (csr != NULL, 0);
+
+  return csr->size;
+}
+
+/**
+ * g_segraph_csr_get_degree:
+ * @csr: a graph.
+ * @index: index of a node.
+ *
+ * Gets number of edges of node with @index.
+ *
+ * Returns: degree of a node.
+ */
+guint
+g_segraph_csr_get_degree (GSEGraphCsr* csr,
+                          guint32 index)
+{
+  g_return_val_if_fail (csr != NULL, 0);
+  g_return_val_if_fail (index < csr->order, 0);
+
+  return csr->offsets[index + 1] - csr->offsets[index];
+}
+
+/**
+ * g_segraph_csr_traverse:
+ * @csr: a graph.
+ * @index: index of a starting node.
+ * @traverse_type: which traversing algorithm to use.
+ *
+ * Gets indices of all nodes reachable from node with @index in order specified
+ * by @traverse_type. This order is the same as order of nodes in
+ * #GSEGraphSnapshot created by g_segraph_snapshot_new_from_node() from
+ * corresponding node. Neither of traversals is recursive.
+ *
+ * Returns: newly created #GArray of #guint32 node indices. Free it with
+ * g_array_free().
+ */
+GArray*
+g_segraph_csr_traverse (GSEGraphCsr* csr,
+                        guint32 index,
+                        GSEGraphTraverseType traverse_type)
+{
+  typedef void (*GraphSearchFunc) (GSEGraphCsr* csr,
+                                   guint32 index,
+                                   GArray* indices,
+                                   guint8* visited);
+
+  GArray* indices;
+  guint8* visited;
+  GraphSearchFunc gsfunc;
+
+  g_return_val_if_fail (csr != NULL, NULL);
+  g_return_val_if_fail (index < csr->order, NULL);
+
+  switch (traverse_type)
+  {
+    case G_SEGRAPH_TRAVERSE_BFS:
+    {
+      gsfunc = _g_segraph_csr_append_BFS;
+      break;
+    }
+    case G_SEGRAPH_TRAVERSE_DFS:
+    {
+      gsfunc = _g_segraph_csr_append_DFS;
+      break;
+    }
+    default:
+    {
+      g_return_val_if_reached (NULL);
+    }
+  }
+
+  indices = g_array_new (FALSE, FALSE, sizeof (guint32));
+  visited = g_new0 (guint8, csr->order);
+
+  (*gsfunc) (csr, index, indices, visited);
+
+  g_free (visited);
+  return indices;
+}
+
+/**
+ * g_segraph_csr_save:
+ * @csr: a graph.
+ * @filename: name of a file to write.
+ * @node_save_func: a function serializing node data or %NULL.
+ * @node_user_data: user data passed to @node_save_func.
+ * @edge_save_func: a function serializing edge data or %NULL.
+ * @edge_user_data: user data passed to @edge_save_func.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Saves @csr in a binary file. If @node_save_func or @edge_save_func is not
+ * %NULL, it is called for each node or edge data and its output is saved as
+ * node or edge payload. Files are written in native byte order and can be
+ * loaded only on machines having the same one. If an error occurs, partially
+ * written file is removed.
+ *
+ * Returns: %TRUE on success, %FALSE if an error occured.
+ */
+gboolean
+g_segraph_csr_save (GSEGraphCsr* csr,
+                    const gchar* filename,
+                    GSEGraphCsrSaveFunc node_save_func,
+                    gpointer node_user_data,
+                    GSEGraphCsrSaveFunc edge_save_func,
+                    gpointer edge_user_data,
+                    GError** error)
+{
+  GSGraphBinaryWriter writer;
+  GSGraphBinaryHeader header;
+
+  g_return_val_if_fail (csr != NULL, FALSE);
+  g_return_val_if_fail (filename != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  _g_sgraph_binary_header_init (&header, G_SEGRAPH_CSR_MAGIC);
+  header.order = csr->order;
+  header.size = csr->size;
+  header.entries = csr->offsets[csr->order];
+
+  if (!_g_sgraph_binary_writer_open (&writer, filename, error))
+  {
+    return FALSE;
+  }
+  if (!_g_sgraph_binary_write (&writer,
+                               csr->offsets,
+                               sizeof (guint32) * (csr->order + 1),
+                               error) ||
+      !_g_sgraph_binary_write (&writer,
+                               csr->edges,
+                               sizeof (guint32) * header.entries,
+                               error) ||
+      !_g_sgraph_binary_write (&writer,
+                               csr->firsts,
+                               sizeof (guint32) * csr->size,
+                               error) ||
+      !_g_sgraph_binary_write (&writer,
+                               csr->seconds,
+                               sizeof (guint32) * csr->size,
+                               error))
+  {
+    _g_sgraph_binary_writer_abort (&writer);
+    return FALSE;
+  }
+  if (node_save_func)
+  {
+    header.flags |= G_SGRAPH_BINARY_NODE_PAYLOADS;
+    if (!_g_sgraph_binary_write_payloads (&writer,
+                                          csr->node_data,
+                                          csr->order,
+                                          node_save_func,
+                                          node_user_data,
+                                          &header.node_payloads_length,
+                                          error))
+    {
+      _g_sgraph_binary_writer_abort (&writer);
+      return FALSE;
+    }
+  }
+  if (edge_save_func)
+  {
+    header.flags |= G_SGRAPH_BINARY_EDGE_PAYLOADS;
+    if (!_g_sgraph_binary_write_payloads (&writer,
+                                          csr->edge_data,
+                                          csr->size,
+                                          edge_save_func,
+                                          edge_user_data,
+                                          &header.edge_payloads_length,
+                                          error))
+    {
+      _g_sgraph_binary_writer_abort (&writer);
+      return FALSE;
+    }
+  }
+
+  return _g_sgraph_binary_writer_close (&writer, &header, error);
+}
+
+/**
+ * g_segraph_csr_load:
+ * @filename: name of a file to load.
+ * @node_load_func: a function deserializing node data or %NULL.
+ * @node_user_data: user data passed to @node_load_func.
+ * @edge_load_func: a function deserializing edge data or %NULL.
+ * @edge_user_data: user data passed to @edge_load_func.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Loads a graph saved with g_segraph_csr_save(). The file is mapped into
+ * memory and stays mapped until returned #GSEGraphCsr is freed. If the file
+ * holds node or edge payloads and @node_load_func or @edge_load_func is not
+ * %NULL, it is called for each of them and its result becomes node or edge
+ * data. Otherwise node or edge data are %NULL. The whole file is validated, so
+ * a damaged file results in an error.
+ *
+ * Returns: new #GSEGraphCsr or %NULL if an error occured.
+ */
+GSEGraphCsr*
+g_segraph_csr_load (const gchar* filename,
+                    GSEGraphCsrLoadFunc node_load_func,
+                    gpointer node_user_data,
+                    GSEGraphCsrLoadFunc edge_load_func,
+                    gpointer edge_user_data,
+                    GError** error)
+{
+  GMappedFile* mapped_file;
+  const gchar* contents;
+  gsize length;
+  GSGraphBinaryReader reader;
+  const GSGraphBinaryHeader* header;
+  const guint32* offsets;
+  const guint32* edges;
+  const guint32* firsts;
+  const guint32* seconds;
+  const gchar* node_payloads;
+  const guint64* node_payload_offsets;
+  const gchar* edge_payloads;
+  const guint64* edge_payload_offsets;
+  GSEGraphCsr* csr;
+  guint32 iter;
+
+  g_return_val_if_fail (filename != NULL, NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+  mapped_file = g_mapped_file_new (filename, FALSE, error);
+  if (!mapped_file)
+  {
+    return NULL;
+  }
+
+  contents = g_mapped_file_get_contents (mapped_file);
+  length = g_mapped_file_get_length (mapped_file);
+  header = _g_sgraph_binary_reader_init (&reader,
+                                         contents,
+                                         length,
+                                         G_SEGRAPH_CSR_MAGIC,
+                                         G_SEGRAPH_CSR_ERROR,
+                                         error);
+  if (!header)
+  {
+    g_mapped_file_free (mapped_file);
+    return NULL;
+  }
+
+  node_payloads = NULL;
+  node_payload_offsets = NULL;
+  edge_payloads = NULL;
+  edge_payload_offsets = NULL;
+  offsets = _g_sgraph_binary_read (&reader,
+                                   sizeof (guint32) *
+                                   ((guint64)header->order + 1));
+  edges = _g_sgraph_binary_read (&reader,
+                                 sizeof (guint32) * (guint64)header->entries);
+  firsts = _g_sgraph_binary_read (&reader,
+                                  sizeof (guint32) * (guint64)header->size);
+  seconds = _g_sgraph_binary_read (&reader,
+                                   sizeof (guint32) * (guint64)header->size);
+  if (!offsets || !edges || !firsts || !seconds ||
+      (header->order == G_MAXUINT32) || (header->size == G_MAXUINT32) ||
+      !_g_sgraph_binary_check_offsets (offsets,
+                                       header->order,
+                                       header->entries) ||
+      !_g_sgraph_binary_check_indices (edges,
+                                       header->entries,
+                                       header->size,
+                                       FALSE) ||
+      !_g_sgraph_binary_check_indices (firsts,
+                                       header->size,
+                                       header->order,
+                                       TRUE) ||
+      !_g_sgraph_binary_check_indices (seconds,
+                                       header->size,
+                                       header->order,
+                                       TRUE) ||
+      ((header->flags & G_SGRAPH_BINARY_NODE_PAYLOADS) &&
+       !_g_sgraph_binary_read_payloads (&reader,
+                                        header->order,
+                                        header->node_payloads_length,
+                                        &node_payloads,
+                                        &node_payload_offsets)) ||
+      ((header->flags & G_SGRAPH_BINARY_EDGE_PAYLOADS) &&
+       !_g_sgraph_binary_read_payloads (&reader,
+                                        header->size,
+                                        header->edge_payloads_length,
+                                        &edge_payloads,
+                                        &edge_payload_offsets)))
+  {
+    g_set_error (error, G_SEGRAPH_CSR_ERROR, G_SEGRAPH_CSR_ERROR_FORMAT,
+                 "File `%s' is damaged.", filename);
+    g_mapped_file_free (mapped_file);
+    return NULL;
+  }
+
+  csr = g_slice_new (GSEGraphCsr);
+  csr->order = header->order;
+  csr->size = header->size;
+  csr->offsets = (guint32*)offsets;
+  csr->edges = (guint32*)edges;
+  csr->firsts = (guint32*)firsts;
+  csr->seconds = (guint32*)seconds;
+  csr->node_data = g_new0 (gpointer, csr->order);
+  csr->edge_data = g_new0 (gpointer, csr->size);
+  csr->mapped_file = mapped_file;
+  csr->node_payloads = node_payloads;
+  csr->node_payload_offsets = node_payload_offsets;
+  csr->edge_payloads = edge_payloads;
+  csr->edge_payload_offsets = edge_payload_offsets;
+
+  if (node_load_func && node_payloads)
+  {
+    for (iter = 0; iter < csr->order; ++iter)
+    {
+      csr->node_data[iter] = (*node_load_func) (node_payloads +
+                                                node_payload_offsets[iter],
+                                                node_payload_offsets[iter + 1] -
+                                                node_payload_offsets[iter],
+                                                node_user_data);
+    }
+  }
+  if (edge_load_func && edge_payloads)
+  {
+    for (iter = 0; iter < csr->size; ++iter)
+    {
+      csr->edge_data[iter] = (*edge_load_func) (edge_payloads +
+                                                edge_payload_offsets[iter],
+                                                edge_payload_offsets[iter + 1] -
+                                                edge_payload_offsets[iter],
+                                                edge_user_data);
+    }
+  }
+
+  return csr;
+}
+
+/**
+ * g_segraph_csr_get_node_payload:
+ * @csr: a graph loaded with g_segraph_csr_load().
+ * @index: index of a node.
+ * @length: return location for length of payload or %NULL.
+ *
+ * Gets serialized data of node with @index straight from the mapped file,
+ * without deserializing it.
+ *
+ * Returns: payload owned by @csr or %NULL if @csr holds no node payloads.
+ */
+const gchar*
+g_segraph_csr_get_node_payload (GSEGraphCsr* csr,
+                                guint32 index,
+                                gsize* length)
+{
+  g_return_val_if_fail (csr != NULL, NULL);
+  g_return_val_if_fail (index < csr->order, NULL);
+
+  return _g_segraph_csr_get_payload (csr->node_payloads,
+                                     csr->node_payload_offsets,
+                                     index,
+                                     length);
+}
+
+/**
+ * g_segraph_csr_get_edge_payload:
+ * @csr: a graph loaded with g_segraph_csr_load().
+ * @index: index of an edge.
+ * @length: return location for length of payload or %NULL.
+ *
+ * Gets serialized data of edge with @index straight from the mapped file,
+ * without deserializing it.
+ *
+ * Returns: payload owned by @csr or %NULL if @csr holds no edge payloads.
+ */
+const gchar*
+g_segraph_csr_get_edge_payload (GSEGraphCsr* csr,
+                                guint32 index,
+                                gsize* length)
+{
+  g_return_val_if_fail (csr != NULL, NULL);
+  g_return_val_if_fail (index < csr->size, NULL);
+
+  return _g_segraph_csr_get_payload (csr->edge_payloads,
+                                     csr->edge_payload_offsets,
+                                     index,
+                                     length);
+}
+
+/* static function definitions. */
+
+/**
+ * _g_segraph_csr_get_other:
+ * @csr: a graph.
+ * @edge: index of an edge.
+ * @index: index of one of @edge's ends.
+ *
+ * Gets index of the other end of @edge, like g_segraph_edge_get_node() does.
+ *
+ * Returns: index of the other end or %G_MAXUINT32 if there is none.
+ */
+static guint32
+_g_segraph_csr_get_other (GSEGraphCsr* csr,
+                          guint32 edge,
+                          guint32 index)
+{
+  if (csr->firsts[edge] == index)
+  {
+    return csr->seconds[edge];
+  }
+  return csr->firsts[edge];
+}
+
+/**
+ * _g_segraph_csr_append_DFS:
+ * @csr: a graph.
+ * @index: index of starting node.
+ * @indices: array where indices of visited nodes are put.
+ * @visited: array of flags, one per node.
+ *
+ * Puts indices of all nodes reachable from node with @index into @indices
+ * using depth first search algorithm. Explicit stack is used instead of
+ * recursion.
+ */
+static void
+_g_segraph_csr_append_DFS (GSEGraphCsr* csr,
+                           guint32 index,
+                           GArray* indices,
+                           guint8* visited)
+{
+  GArray* stack;
+  GSEGraphCsrFrame frame;
+
+  stack = g_array_new (FALSE, FALSE, sizeof (GSEGraphCsrFrame));
+
+  visited[index] = TRUE;
+  g_array_append_val (indices, index);
+  frame.index = index;
+  frame.position = csr->offsets[index];
+  g_array_append_val (stack, frame);
+
+  while (stack->len)
+  {
+    GSEGraphCsrFrame* top;
+    guint32 other_index;
+
+    top = &g_array_index (stack, GSEGraphCsrFrame, stack->len - 1);
+    if (top->position == csr->offsets[top->index + 1])
+    {
+      g_array_set_size (stack, stack->len - 1);
+      continue;
+    }
+
+    other_index = _g_segraph_csr_get_other (csr,
+                                            csr->edges[top->position],
+                                            top->index);
+    ++top->position;
+    if ((other_index == G_MAXUINT32) || visited[other_index])
+    {
+      continue;
+    }
+
+    visited[other_index] = TRUE;
+    g_array_append_val (indices, other_index);
+    frame.index = other_index;
+    frame.position = csr->offsets[other_index];
+    g_array_append_val (stack, frame);
+  }
+
+  g_array_free (stack, TRUE);
+}
+
+/**
+ * _g_segraph_csr_append_BFS:
+ * @csr: a graph.
+ * @index: index of starting node.
+ * @indices: array where indices of visited nodes are put.
+ * @visited: array of flags, one per node.
+ *
+ * Puts indices of all nodes reachable from node with @index into @indices
+ * using breadth first search algorithm. @indices itself serves as a queue.
+ */
+static void
+_g_segraph_csr_append_BFS (GSEGraphCsr* csr,
+                           guint32 index,
+                           GArray* indices,
+                           guint8* visited)
+{
+  guint head;
+
+  visited[index] = TRUE;
+  g_array_append_val (indices, index);
+
+  for (head = 0; head < indices->len; ++head)
+  {
+    guint32 temp_index;
+    guint32 iter;
+
+    temp_index = g_array_index (indices, guint32, head);
+    for (iter = csr->offsets[temp_index];
+         iter < csr->offsets[temp_index + 1];
+         ++iter)
+    {
+      guint32 other_index;
+
+      other_index = _g_segraph_csr_get_other (csr,
+                                              csr->edges[iter],
+                                              temp_index);
+      if ((other_index == G_MAXUINT32) || visited[other_index])
+      {
+        continue;
+      }
+
+      visited[other_index] = TRUE;
+      g_array_append_val (indices, other_index);
+    }
+  }
+}
+
+/**
+ * _g_segraph_csr_lookup:
+ * @elements_to_indices: a map of nodes or edges to their indices.
+ * @element: a node or an edge.
+ *
+ * Gets index of @element.
+ *
+ * Returns: index or %G_MAXUINT32 if @element is not in the map.
+ */
+static guint32
+_g_segraph_csr_lookup (GHashTable* elements_to_indices,
+                       gpointer element)
+{
+  gpointer index;
+
+  if (!g_hash_table_lookup_extended (elements_to_indices,
+                                     element,
+                                     NULL,
+                                     &index))
+  {
+    return G_MAXUINT32;
+  }
+  return GPOINTER_TO_UINT (index);
+}
+
+/**
+ * _g_segraph_csr_get_payload:
+ * @payloads: payloads blob or %NULL.
+ * @payload_offsets: offsets into @payloads.
+ * @index: index of a payload.
+ * @length: return location for length of payload or %NULL.
+ *
+ * Gets payload with @index.
+ *
+ * Returns: payload or %NULL if @payloads is %NULL.
+ */
+static const gchar*
+_g_segraph_csr_get_payload (const gchar* payloads,
+                            const guint64* payload_offsets,
+                            guint32 index,
+                            gsize* length)
+{
+  if (!payloads)
+  {
+    if (length)
+    {
+      *length = 0;
+    }
+    return NULL;
+  }
+
+  if (length)
+  {
+    *length = payload_offsets[index + 1] - payload_offsets[index];
+  }
+  return payloads + payload_offsets[index];
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined (G_DISABLE_SINGLE_INCLUDES) && !defined (_G_SEGRAPH_H_INSIDE_) && !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "Only <gsgraph/gsegraph.h> can be included directly."
+#endif
+
+#ifndef _G_SEGRAPH_CSR_H_
+#define _G_SEGRAPH_CSR_H_
+
+#include <glib.h>
+
+#include <gsgraph/gsegraphenums.h>
+#include <gsgraph/gsegraphsnapshot.h>
+
+G_BEGIN_DECLS
+
+/**
+ * G_SEGRAPH_CSR_ERROR:
+ *
+ * Error domain for loading #GSEGraphCsr from a file. Errors in this domain
+ * will be from the #GSEGraphCsrError enumeration.
+ */
+#define G_SEGRAPH_CSR_ERROR g_segraph_csr_error_quark ()
+
+/**
+ * GSEGraphCsrSaveFunc:
+ * @data: data of a node or an edge.
+ * @buffer: a buffer to append serialized @data to.
+ * @user_data: user data passed to g_segraph_csr_save().
+ *
+ * Serializes node or edge data, so it can be saved in a file.
+ */
+typedef void (*GSEGraphCsrSaveFunc) (gpointer data,
+                                     GString* buffer,
+                                     gpointer user_data);
+
+/**
+ * GSEGraphCsrLoadFunc:
+ * @payload: serialized node or edge data.
+ * @length: length of @payload.
+ * @user_data: user data passed to g_segraph_csr_load().
+ *
+ * Deserializes node or edge data saved with #GSEGraphCsrSaveFunc.
+ *
+ * Returns: node or edge data.
+ */
+typedef gpointer (*GSEGraphCsrLoadFunc) (const gchar* payload,
+                                         gsize length,
+                                         gpointer user_data);
+
+/**
+ * GSEGraphCsr:
+ * @order: number of nodes.
+ * @size: number of edges.
+ * @offsets: array of @order + 1 offsets into @edges. Edges of node with index
+ * i are stored between @offsets[i] (inclusive) and @offsets[i + 1]
+ * (exclusive).
+ * @edges: array of edge indices.
+ * @firsts: array of @size indices of first ends of edges. %G_MAXUINT32 means
+ * that edge has no first end.
+ * @seconds: array of @size indices of second ends of edges. %G_MAXUINT32
+ * means that edge has no second end.
+ * @node_data: array of @order node data.
+ * @edge_data: array of @size edge data.
+ *
+ * Immutable graph in compressed sparse row form. Node with index i is the i-th
+ * node in node array and edge with index i is the i-th edge in edge array of
+ * #GSEGraphSnapshot it was created from.
+ */
+typedef struct _GSEGraphCsr GSEGraphCsr;
+
+struct _GSEGraphCsr
+{
+  guint32 order;
+  guint32 size;
+  guint32* offsets;
+  guint32* edges;
+  guint32* firsts;
+  guint32* seconds;
+  gpointer* node_data;
+  gpointer* edge_data;
+
+  /*< private >*/
+  GMappedFile* mapped_file;
+  const gchar* node_payloads;
+  const guint64* node_payload_offsets;
+  const gchar* edge_payloads;
+  const guint64* edge_payload_offsets;
+};
+
+GQuark
+g_segraph_csr_error_quark (void);
+
+GSEGraphCsr*
+g_segraph_csr_new (GSEGraphSnapshot* graph) G_GNUC_WARN_UNUSED_RESULT;
+
+void
+g_segraph_csr_free (GSEGraphCsr* csr);
+
+guint
+g_segraph_csr_get_order (GSEGraphCsr* csr);
+
+guint
+g_segraph_csr_get_size (GSEGraphCsr* csr);
+
+guint
+g_segraph_csr_get_degree (GSEGraphCsr* csr,
+                          guint32 index);
+
+GArray*
+g_segraph_csr_traverse (GSEGraphCsr* csr,
+                        guint32 index,
+                        GSEGraphTraverseType traverse_type) G_GNUC_WARN_UNUSED_RESULT;
+
+gboolean
+g_segraph_csr_save (GSEGraphCsr* csr,
+                    const gchar* filename,
+                    GSEGraphCsrSaveFunc node_save_func,
+                    gpointer node_user_data,
+                    GSEGraphCsrSaveFunc edge_save_func,
+                    gpointer edge_user_data,
+                    GError** error);
+
+GSEGraphCsr*
+g_segraph_csr_load (const gchar* filename,
+                    GSEGraphCsrLoadFunc node_load_func,
+                    gpointer node_user_data,
+                    GSEGraphCsrLoadFunc edge_load_func,
+                    gpointer edge_user_data,
+                    GError** error) G_GNUC_WARN_UNUSED_RESULT;
+
+const gchar*
+g_segraph_csr_get_node_payload (GSEGraphCsr* csr,
+                                guint32 index,
+                                gsize* length);
+
+const gchar*
+g_segraph_csr_get_edge_payload (GSEGraphCsr* csr,
+                                guint32 index,
+                                gsize* length);
+
+G_END_DECLS
+
+#endif /* _G_SEGRAPH_CSR_H_ */
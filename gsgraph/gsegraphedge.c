@@ -20,6 +20,9 @@
 #include "gsegraphedge.h"
 
 #include "gsegraphnode.h"
+#include "gsegraphconnectivityprivate.h"
+#include "gsegrapharenaprivate.h"
+#include "gsgraphvisited.h"
 
 /**
  * SECTION: gsegraphedge
@@ -32,7 +35,8 @@
  * edges are always undirected. Loops and multiple edges are allowed.
  * Edge is clean if its both pointers to nodes are %NULL.
  *
- * To create new edge, use g_segraph_edge_new().
+ * To create new edge, use g_segraph_edge_new() or
+ * g_segraph_edge_new_in_arena().
  *
  * To free it, use g_segraph_edge_free().
  *
@@ -66,8 +70,29 @@
  * </note>
  */
 
+/* internal types */
+
+/**
+ * GSEGraphEdgeFrame:
+ * @node: a node.
+ * @position: index of next edge of @node to check.
+ *
+ * Internal struct used as a depth first search stack frame.
+ */
+typedef struct _GSEGraphEdgeFrame GSEGraphEdgeFrame;
+
+struct _GSEGraphEdgeFrame
+{
+  GSEGraphNode* node;
+  guint position;
+};
+
 /* static function declarations */
 
+static GSEGraphEdge*
+_g_segraph_edge_new_general (GSEGraphArena* arena,
+                             gpointer data);
+
 static gboolean
 _g_segraph_edge_general_member_check (GSEGraphEdge* edge,
                                       GSEGraphNode* node,
@@ -77,12 +102,21 @@ _g_segraph_edge_general_member_check (GSEGraphEdge* edge,
 static gboolean
 _g_segraph_edge_bridge_check (GSEGraphNode* first,
                               GSEGraphNode* second,
-                              GHashTable* visited_nodes,
-                              GHashTable* visited_edges);
+                              GSGraphVisited* visited);
 
 static void
 _g_segraph_edge_disjoin (GSEGraphEdge* edge);
 
+static void
+_g_segraph_edge_attach (GSEGraphEdge* edge,
+                        GSEGraphNode* node,
+                        guint* position);
+
+static void
+_g_segraph_edge_detach (GSEGraphEdge* edge,
+                        GSEGraphNode* node,
+                        guint position);
+
 /* public function definitions */
 
 /**
@@ -96,14 +130,26 @@ _g_segraph_edge_disjoin (GSEGraphEdge* edge);
 GSEGraphEdge*
 g_segraph_edge_new (gpointer data)
 {
-  GSEGraphEdge* edge;
+  return _g_segraph_edge_new_general (NULL, data);
+}
 
-  edge = g_slice_new (GSEGraphEdge);
-  edge->first = NULL;
-  edge->second = NULL;
-  edge->data = data;
+/**
+ * g_segraph_edge_new_in_arena:
+ * @arena: an arena.
+ * @data: data of the connection.
+ *
+ * Creates new clean edge containing @data with memory taken from @arena. Such
+ * edge is freed with g_segraph_edge_free() or together with whole @arena.
+ *
+ * Returns: newly created #GSEGraphEdge.
+ */
+GSEGraphEdge*
+g_segraph_edge_new_in_arena (GSEGraphArena* arena,
+                             gpointer data)
+{
+  g_return_val_if_fail (arena != NULL, NULL);
 
-  return edge;
+  return _g_segraph_edge_new_general (arena, data);
 }
 
 /**
@@ -114,7 +160,8 @@ g_segraph_edge_new (gpointer data)
  *
  * Creates new edge containing @data and connecting @first and @second. Only one
  * node (@first or @second) can be %NULL. @data can also be %NULL. To connect
- * nodes, @edge have to be clean.
+ * nodes, @edge have to be clean. If one of nodes is held by
+ * #GSEGraphConnectivity, the index is updated.
  *
  * Returns: newly created #GSEGraphEdge.
  */
@@ -132,12 +179,17 @@ g_segraph_edge_connect_nodes (GSEGraphEdge* edge,
 
   if (first)
   {
-    g_ptr_array_add (first->edges, edge);
+    _g_segraph_edge_attach (edge, first, &edge->first_position);
   }
 
   if (second)
   {
-    g_ptr_array_add (second->edges, edge);
+    _g_segraph_edge_attach (edge, second, &edge->second_position);
+  }
+
+  if (first && second && (first != second))
+  {
+    _g_segraph_connectivity_node_connected (first, second);
   }
 }
 
@@ -161,7 +213,14 @@ g_segraph_edge_free (GSEGraphEdge* edge)
   g_return_val_if_fail (edge != NULL, NULL);
 
   data = edge->data;
-  g_slice_free (GSEGraphEdge, edge);
+  if (edge->arena)
+  {
+    _g_segraph_arena_release_edge (edge->arena, edge);
+  }
+  else
+  {
+    g_slice_free (GSEGraphEdge, edge);
+  }
   return data;
 }
 
@@ -341,6 +400,8 @@ g_segraph_edge_clean (GSEGraphEdge* edge)
 {
   g_return_if_fail (edge != NULL);
 
+  _g_segraph_connectivity_node_disconnected (edge->first);
+  _g_segraph_connectivity_node_disconnected (edge->second);
   edge->first = NULL;
   edge->second = NULL;
 }
@@ -393,6 +454,7 @@ g_segraph_edge_clean_first (GSEGraphEdge* edge)
 {
   g_return_if_fail (edge != NULL);
 
+  _g_segraph_connectivity_node_disconnected (edge->first);
   edge->first = NULL;
 }
 
@@ -410,7 +472,8 @@ g_segraph_edge_disconnect_first (GSEGraphEdge* edge)
 
   if (edge->first)
   {
-    g_ptr_array_remove (edge->first->edges, edge);
+    _g_segraph_connectivity_node_disconnected (edge->first);
+    _g_segraph_edge_detach (edge, edge->first, edge->first_position);
   }
 }
 
@@ -427,7 +490,8 @@ g_segraph_edge_clean_disconnect_first (GSEGraphEdge* edge)
 
   if (edge->first)
   {
-    g_ptr_array_remove (edge->first->edges, edge);
+    _g_segraph_connectivity_node_disconnected (edge->first);
+    _g_segraph_edge_detach (edge, edge->first, edge->first_position);
     edge->first = NULL;
   }
 }
@@ -444,6 +508,7 @@ g_segraph_edge_clean_second (GSEGraphEdge* edge)
 {
   g_return_if_fail (edge != NULL);
 
+  _g_segraph_connectivity_node_disconnected (edge->second);
   edge->second = NULL;
 }
 
@@ -461,7 +526,8 @@ g_segraph_edge_disconnect_second (GSEGraphEdge* edge)
 
   if (edge->second)
   {
-    g_ptr_array_remove (edge->second->edges, edge);
+    _g_segraph_connectivity_node_disconnected (edge->second);
+    _g_segraph_edge_detach (edge, edge->second, edge->second_position);
   }
 }
 
@@ -479,7 +545,8 @@ g_segraph_edge_clean_disconnect_second (GSEGraphEdge* edge)
 
   if (edge->second)
   {
-    g_ptr_array_remove (edge->second->edges, edge);
+    _g_segraph_connectivity_node_disconnected (edge->second);
+    _g_segraph_edge_detach (edge, edge->second, edge->second_position);
     edge->second = NULL;
   }
 }
@@ -504,11 +571,13 @@ g_segraph_edge_clean_node (GSEGraphEdge* edge,
 
   if (edge->first == node)
   {
+    _g_segraph_connectivity_node_disconnected (node);
     edge->first = NULL;
     return TRUE;
   }
   if (edge->second == node)
   {
+    _g_segraph_connectivity_node_disconnected (node);
     edge->second = NULL;
     return TRUE;
   }
@@ -533,9 +602,16 @@ g_segraph_edge_disconnect_node (GSEGraphEdge* edge,
   g_return_val_if_fail (edge != NULL, FALSE);
   g_return_val_if_fail (node != NULL, FALSE);
 
-  if ((edge->first == node) || (edge->second == node))
+  if (edge->first == node)
   {
-    g_ptr_array_remove (node->edges, edge);
+    _g_segraph_connectivity_node_disconnected (node);
+    _g_segraph_edge_detach (edge, node, edge->first_position);
+    return TRUE;
+  }
+  if (edge->second == node)
+  {
+    _g_segraph_connectivity_node_disconnected (node);
+    _g_segraph_edge_detach (edge, node, edge->second_position);
     return TRUE;
   }
   return FALSE;
@@ -561,14 +637,16 @@ g_segraph_edge_clean_disconnect_node (GSEGraphEdge* edge,
 
   if (edge->first == node)
   {
-    g_ptr_array_remove (node->edges, edge);
+    _g_segraph_connectivity_node_disconnected (node);
+    _g_segraph_edge_detach (edge, node, edge->first_position);
     edge->first = NULL;
     return TRUE;
   }
 
   if (edge->second == node)
   {
-    g_ptr_array_remove (node->edges, edge);
+    _g_segraph_connectivity_node_disconnected (node);
+    _g_segraph_edge_detach (edge, node, edge->second_position);
     edge->second = NULL;
     return TRUE;
   }
@@ -673,8 +751,7 @@ g_segraph_edge_get_multiplicity (GSEGraphEdge* edge)
 gboolean
 g_segraph_edge_is_bridge (GSEGraphEdge* edge)
 {
-  GHashTable* visited_nodes;
-  GHashTable* visited_edges;
+  GSGraphVisited visited;
   gboolean result;
 
   g_return_val_if_fail (edge != NULL, FALSE);
@@ -684,18 +761,14 @@ g_segraph_edge_is_bridge (GSEGraphEdge* edge)
     return FALSE;
   }
 
-  visited_nodes = g_hash_table_new (NULL, NULL);
-  visited_edges = g_hash_table_new (NULL, NULL);
-
-  g_hash_table_insert (visited_edges, edge, NULL);
+  _g_sgraph_visited_init (&visited, G_SGRAPH_VISITED_DOMAIN_SEGRAPH, 1);
+  _g_sgraph_visited_set (&visited, edge, &edge->visit_mark, 1);
 
   result = _g_segraph_edge_bridge_check (edge->first,
                                          edge->second,
-                                         visited_nodes,
-                                         visited_edges);
+                                         &visited);
 
-  g_hash_table_unref (visited_nodes);
-  g_hash_table_unref (visited_edges);
+  _g_sgraph_visited_clear (&visited);
 
   return result;
 }
@@ -719,6 +792,41 @@ g_segraph_edge_is_half_edge (GSEGraphEdge* edge)
 
 /* static function definitions */
 
+/**
+ * _g_segraph_edge_new_general:
+ * @arena: an arena or %NULL.
+ * @data: data of the connection.
+ *
+ * Creates new clean edge containing @data. If @arena is not %NULL, memory for
+ * edge is taken from it.
+ *
+ * Returns: newly created #GSEGraphEdge.
+ */
+static GSEGraphEdge*
+_g_segraph_edge_new_general (GSEGraphArena* arena,
+                             gpointer data)
+{
+  GSEGraphEdge* edge;
+
+  if (arena)
+  {
+    edge = _g_segraph_arena_alloc_edge (arena);
+  }
+  else
+  {
+    edge = g_slice_new (GSEGraphEdge);
+  }
+  edge->first = NULL;
+  edge->second = NULL;
+  edge->data = data;
+  edge->visit_mark = 0;
+  edge->first_position = 0;
+  edge->second_position = 0;
+  edge->arena = arena;
+
+  return edge;
+}
+
 /**
  * _g_segraph_edge_general_member_check:
  * @edge: an edge.
@@ -774,58 +882,79 @@ _g_segraph_edge_general_member_check (GSEGraphEdge* edge,
  * _g_segraph_edge_bridge_check:
  * @first: first node.
  * @second: second node.
- * @visited_nodes: hash table holding already visited nodes.
- * @visited_edges: hash table holding already visited edges.
+ * @visited: a set of already visited nodes and edges.
  *
- * Recursively checks if @first is connected to @second. This function is used
- * for checking if an edge is a bridge.
+ * Checks if @first is reachable from @second in depth first order. This
+ * function is used for checking if an edge is a bridge. An explicit stack
+ * allocated once per check is used instead of recursion.
  *
  * Returns: %TRUE if edge is a bridge, otherwise %FALSE.
  */
 static gboolean
 _g_segraph_edge_bridge_check (GSEGraphNode* first,
                               GSEGraphNode* second,
-                              GHashTable* visited_nodes,
-                              GHashTable* visited_edges)
+                              GSGraphVisited* visited)
 {
-  guint iter;
+  GArray* stack;
+  GSEGraphEdgeFrame frame;
+  gboolean is_bridge;
 
   if (first == second)
   {
     return FALSE;
   }
 
-  g_hash_table_insert (visited_nodes, second, NULL);
+  stack = g_array_new (FALSE, FALSE, sizeof (GSEGraphEdgeFrame));
 
-  for (iter = 0; iter < second->edges->len; ++iter)
+  _g_sgraph_visited_set (visited, second, &second->visit_mark, 1);
+  frame.node = second;
+  frame.position = 0;
+  g_array_append_val (stack, frame);
+
+  is_bridge = TRUE;
+  while (stack->len)
   {
+    GSEGraphEdgeFrame* top;
     GSEGraphEdge* edge;
     GSEGraphNode* node;
 
-    edge = g_ptr_array_index (second->edges, iter);
-    if (g_hash_table_lookup_extended (visited_edges, edge, NULL, NULL))
+    top = &g_array_index (stack, GSEGraphEdgeFrame, stack->len - 1);
+    if (top->position == top->node->edges->len)
     {
+      g_array_set_size (stack, stack->len - 1);
       continue;
     }
-    else
+
+    edge = g_ptr_array_index (top->node->edges, top->position);
+    ++top->position;
+    if (_g_sgraph_visited_check (visited, edge, &edge->visit_mark))
     {
-      g_hash_table_insert (visited_edges, edge, NULL);
+      continue;
     }
-    node = g_segraph_edge_get_node (edge, second);
-    if (g_hash_table_lookup_extended (visited_nodes, node, NULL, NULL))
+    node = g_segraph_edge_get_node (edge, top->node);
+    if (!node)
+    {
+      continue;
+    }
+    if (_g_sgraph_visited_get (visited, node, &node->visit_mark))
     {
       continue;
     }
 
-    if (!_g_segraph_edge_bridge_check (first,
-                                       node,
-                                       visited_nodes,
-                                       visited_edges))
+    if (node == first)
     {
-      return FALSE;
+      is_bridge = FALSE;
+      break;
     }
+
+    _g_sgraph_visited_set (visited, node, &node->visit_mark, 1);
+    frame.node = node;
+    frame.position = 0;
+    g_array_append_val (stack, frame);
   }
-  return TRUE;
+
+  g_array_free (stack, TRUE);
+  return is_bridge;
 }
 
 /**
@@ -839,10 +968,108 @@ _g_segraph_edge_disjoin (GSEGraphEdge* edge)
 {
   if (edge->first)
   {
-    g_ptr_array_remove (edge->first->edges, edge);
+    _g_segraph_connectivity_node_disconnected (edge->first);
+    _g_segraph_edge_detach (edge, edge->first, edge->first_position);
   }
   if (edge->second)
   {
-    g_ptr_array_remove (edge->second->edges, edge);
+    _g_segraph_connectivity_node_disconnected (edge->second);
+    _g_segraph_edge_detach (edge, edge->second, edge->second_position);
+  }
+}
+
+/**
+ * _g_segraph_edge_attach:
+ * @edge: an edge.
+ * @node: a node.
+ * @position: place where index of @edge in @node's edges array is stored.
+ *
+ * Appends @edge to @node's edges array and remembers its index in @position.
+ */
+static void
+_g_segraph_edge_attach (GSEGraphEdge* edge,
+                        GSEGraphNode* node,
+                        guint* position)
+{
+  *position = node->edges->len;
+  g_ptr_array_add (node->edges, edge);
+}
+
+/**
+ * _g_segraph_edge_detach:
+ * @edge: an edge.
+ * @node: a node.
+ * @position: remembered index of @edge in @node's edges array.
+ *
+ * Removes @edge from @node's edges array. If @position does not point to @edge
+ * (edges array was modified by hand), @edge is searched for. Unless @node keeps
+ * order of edges, last edge is moved in place of @edge, otherwise following
+ * edges are shifted. In both cases remembered indices of moved edges are
+ * updated. Loops occupy two slots, so the index to update is the one equal to
+ * old slot.
+ */
+static void
+_g_segraph_edge_detach (GSEGraphEdge* edge,
+                        GSEGraphNode* node,
+                        guint position)
+{
+  GPtrArray* edges;
+
+  edges = node->edges;
+  if ((position >= edges->len) || (g_ptr_array_index (edges, position) != edge))
+  {
+    for (position = 0; position < edges->len; ++position)
+    {
+      if (g_ptr_array_index (edges, position) == edge)
+      {
+        break;
+      }
+    }
+    if (position == edges->len)
+    {
+      return;
+    }
+  }
+
+  if (node->keep_edge_order)
+  {
+    guint iter;
+
+    g_ptr_array_remove_index (edges, position);
+    for (iter = position; iter < edges->len; ++iter)
+    {
+      GSEGraphEdge* moved;
+
+      moved = g_ptr_array_index (edges, iter);
+      if ((moved->first == node) && (moved->first_position == iter + 1))
+      {
+        moved->first_position = iter;
+      }
+      else if ((moved->second == node) && (moved->second_position == iter + 1))
+      {
+        moved->second_position = iter;
+      }
+    }
+  }
+  else
+  {
+    guint last;
+
+    last = edges->len - 1;
+    g_ptr_array_remove_index_fast (edges, position);
+    if (position < last)
+    {
+      GSEGraphEdge* moved;
+
+      moved = g_ptr_array_index (edges, position);
+      if ((moved->first == node) && (moved->first_position == last))
+      {
+        moved->first_position = position;
+      }
+      else if ((moved->second == node) && (moved->second_position == last))
+      {
+        moved->second_position = position;
+      }
+    }
   }
 }
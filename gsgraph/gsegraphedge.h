@@ -43,11 +43,21 @@ struct _GSEGraphEdge
   GSEGraphNode* first;
   GSEGraphNode* second;
   gpointer data;
+
+  /*< private >*/
+  guint32 visit_mark;
+  guint first_position;
+  guint second_position;
+  GSEGraphArena* arena;
 };
 
 GSEGraphEdge*
 g_segraph_edge_new (gpointer data);
 
+GSEGraphEdge*
+g_segraph_edge_new_in_arena (GSEGraphArena* arena,
+                             gpointer data);
+
 void
 g_segraph_edge_connect_nodes (GSEGraphEdge* edge,
                               GSEGraphNode* first,
@@ -50,6 +50,55 @@ typedef enum
   G_SEGRAPH_TRAVERSE_DFS
 } GSEGraphTraverseType;
 
+/**
+ * GSEGraphVisitResult:
+ * @G_SEGRAPH_VISIT_CONTINUE: Continue traversal.
+ * @G_SEGRAPH_VISIT_SKIP_CHILDREN: Continue traversal, but do not go through
+ * edges of visited node.
+ * @G_SEGRAPH_VISIT_STOP: Stop traversal.
+ *
+ * Returned by #GSEGraphVisitFunc to tell how traversal should go on.
+ */
+typedef enum
+{
+  G_SEGRAPH_VISIT_CONTINUE,
+  G_SEGRAPH_VISIT_SKIP_CHILDREN,
+  G_SEGRAPH_VISIT_STOP
+} GSEGraphVisitResult;
+
+/**
+ * GSEGraphOrdering:
+ * @G_SEGRAPH_ORDERING_RCM: Reverse Cuthill-McKee order. Neighbouring nodes get
+ * close positions, which keeps bandwidth of adjacency matrix low.
+ * @G_SEGRAPH_ORDERING_DEGREE: Nodes with highest degrees go first.
+ * @G_SEGRAPH_ORDERING_BFS: Order of breadth first search.
+ *
+ * Used to specify order nodes are put in by g_segraph_snapshot_reorder().
+ */
+typedef enum
+{
+  G_SEGRAPH_ORDERING_RCM,
+  G_SEGRAPH_ORDERING_DEGREE,
+  G_SEGRAPH_ORDERING_BFS
+} GSEGraphOrdering;
+
+/**
+ * GSEGraphCsrError:
+ * @G_SEGRAPH_CSR_ERROR_FORMAT: File is not an extended graph file or it is
+ * damaged.
+ * @G_SEGRAPH_CSR_ERROR_VERSION: File has unsupported version.
+ * @G_SEGRAPH_CSR_ERROR_BYTE_ORDER: File was written on a machine with
+ * different byte order.
+ *
+ * Error codes returned by g_segraph_csr_load().
+ */
+typedef enum
+{
+  G_SEGRAPH_CSR_ERROR_FORMAT,
+  G_SEGRAPH_CSR_ERROR_VERSION,
+  G_SEGRAPH_CSR_ERROR_BYTE_ORDER
+} GSEGraphCsrError;
+
 G_END_DECLS
 
 #endif /* _G_SEGRAPH_ENUMS_H_ */
@@ -0,0 +1,474 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsegraphiter.h"
+#include "gsegraphiterprivate.h"
+
+/**
+ * SECTION: gsegraphiter
+ * @title: Simple edged graph iterator
+ * @short_description: traversal returning edges and nodes one by one.
+ * @include: gsgraph/gsegraph.h
+ * @see_also: #GSEGraphNode, #GSEGraphEdge, #GSEGraphTraverseType,
+ * #GSEGraphSnapshot
+ *
+ * Iterator traversing a graph from given node. First step returns the node
+ * traversal starts from. Each next step returns an edge seen for the first
+ * time together with a node found through it, if that node was not returned
+ * before. Nodes and edges are returned in the same order
+ * g_segraph_snapshot_new_from_node() puts them into its arrays. Work is done
+ * only when next step is requested, so traversal can be stopped early without
+ * visiting whole graph and without keeping arrays of all its nodes and edges.
+ *
+ * To create an iterator, use g_segraph_iter_new().
+ *
+ * To do next step, use g_segraph_iter_next().
+ *
+ * To free an iterator, use g_segraph_iter_free().
+ *
+ * <note>
+ *   <para>
+ *     Graph must not be changed while it is traversed by an iterator. Visited
+ *     nodes and edges are remembered in a hash table owned by iterator, so many
+ *     iterators can traverse the same graph at the same time.
+ *   </para>
+ * </note>
+ */
+
+/* internal macros */
+
+/**
+ * G_SEGRAPH_ITER_COMPACT_THRESHOLD:
+ *
+ * Number of already expanded nodes in breadth first search queue, above which
+ * they are removed from the queue if they take at least half of it.
+ */
+#define G_SEGRAPH_ITER_COMPACT_THRESHOLD 1024
+
+/* static function declarations. */
+
+static gboolean
+_g_segraph_iter_next_DFS (GSEGraphIter* iter,
+                          GSEGraphNode** node,
+                          GSEGraphEdge** edge);
+
+static gboolean
+_g_segraph_iter_next_BFS (GSEGraphIter* iter,
+                          GSEGraphNode** node,
+                          GSEGraphEdge** edge);
+
+/* public function definitions. */
+
+/**
+ * g_segraph_iter_new:
+ * @node: a node traversal starts from.
+ * @traverse_type: which traversing algorithm to use.
+ *
+ * Creates an iterator over all nodes and edges reachable from @node, @node
+ * included.
+ *
+ * Returns: newly created #GSEGraphIter.
+ */
+GSEGraphIter*
+g_segraph_iter_new (GSEGraphNode* node,
+                    GSEGraphTraverseType traverse_type)
+{
+  GSEGraphIter* iter;
+
+  g_return_val_if_fail (node != NULL, NULL);
+  g_return_val_if_fail ((traverse_type == G_SEGRAPH_TRAVERSE_BFS) ||
+                        (traverse_type == G_SEGRAPH_TRAVERSE_DFS), NULL);
+
+  iter = g_slice_new (GSEGraphIter);
+  _g_segraph_iter_init (iter, node, traverse_type, FALSE);
+
+  return iter;
+}
+
+/**
+ * g_segraph_iter_next:
+ * @iter: an iterator.
+ * @node: place for a node returned by this step or %NULL.
+ * @edge: place for an edge returned by this step or %NULL.
+ *
+ * Does next step of traversal. First step puts a node traversal starts from
+ * into @node and %NULL into @edge. Each next step puts into @edge an edge not
+ * returned before and into @node a node at its other end if it was not
+ * returned before or %NULL otherwise.
+ *
+ * Returns: %TRUE if step was done, %FALSE if all reachable nodes and edges
+ * were already returned.
+ */
+gboolean
+g_segraph_iter_next (GSEGraphIter* iter,
+                     GSEGraphNode** node,
+                     GSEGraphEdge** edge)
+{
+  GSEGraphNode* next_node;
+  GSEGraphEdge* next_edge;
+  gboolean result;
+
+  g_return_val_if_fail (iter != NULL, FALSE);
+
+  next_node = NULL;
+  next_edge = NULL;
+  if (iter->start)
+  {
+    next_node = iter->start;
+    iter->start = NULL;
+    result = TRUE;
+  }
+  else
+  {
+    switch (iter->traverse_type)
+    {
+      case G_SEGRAPH_TRAVERSE_BFS:
+      {
+        result = _g_segraph_iter_next_BFS (iter, &next_node, &next_edge);
+        break;
+      }
+      case G_SEGRAPH_TRAVERSE_DFS:
+      {
+        result = _g_segraph_iter_next_DFS (iter, &next_node, &next_edge);
+        break;
+      }
+      default:
+      {
+        g_return_val_if_reached (FALSE);
+      }
+    }
+  }
+
+  if (node)
+  {
+    *node = next_node;
+  }
+  if (edge)
+  {
+    *edge = next_edge;
+  }
+  return result;
+}
+
+/**
+ * g_segraph_iter_free:
+ * @iter: an iterator to free.
+ *
+ * Frees @iter. Traversed graph is left untouched.
+ */
+void
+g_segraph_iter_free (GSEGraphIter* iter)
+{
+  g_return_if_fail (iter != NULL);
+
+  _g_segraph_iter_clear (iter);
+  g_slice_free (GSEGraphIter, iter);
+}
+
+/* internal function definitions. */
+
+/**
+ * _g_segraph_iter_init:
+ * @iter: an iterator to initialize.
+ * @node: a node traversal starts from.
+ * @traverse_type: which traversing algorithm to use.
+ * @use_marks: whether visit marks in nodes and edges can be used.
+ *
+ * Prepares @iter for traversal starting from @node. If @use_marks is %TRUE,
+ * visited set may hold the domain lock until _g_segraph_iter_clear() is
+ * called, so it should be used only by traversals done within a single
+ * function.
+ */
+void
+_g_segraph_iter_init (GSEGraphIter* iter,
+                      GSEGraphNode* node,
+                      GSEGraphTraverseType traverse_type,
+                      gboolean use_marks)
+{
+  iter->traverse_type = traverse_type;
+  iter->start = node;
+  iter->stack = NULL;
+  iter->queue = NULL;
+  iter->head = 0;
+  iter->position = 0;
+  iter->level_end = 1;
+  iter->depth = 0;
+  iter->last_depth = 0;
+  iter->max_depth = G_MAXUINT;
+  iter->filter_func = NULL;
+  iter->filter_data = NULL;
+
+  if (use_marks)
+  {
+    _g_sgraph_visited_init (&iter->visited,
+                            G_SGRAPH_VISITED_DOMAIN_SEGRAPH,
+                            1);
+  }
+  else
+  {
+    _g_sgraph_visited_init_table (&iter->visited,
+                                  G_SGRAPH_VISITED_DOMAIN_SEGRAPH,
+                                  1);
+  }
+  _g_sgraph_visited_set (&iter->visited, node, &node->visit_mark, 1);
+
+  if (traverse_type == G_SEGRAPH_TRAVERSE_DFS)
+  {
+    GSEGraphIterFrame frame;
+
+    iter->stack = g_array_new (FALSE, FALSE, sizeof (GSEGraphIterFrame));
+    frame.node = node;
+    frame.position = 0;
+    g_array_append_val (iter->stack, frame);
+  }
+  else
+  {
+    iter->queue = g_ptr_array_new ();
+    g_ptr_array_add (iter->queue, node);
+  }
+}
+
+/**
+ * _g_segraph_iter_set_limits:
+ * @iter: an iterator, which did not do any step yet.
+ * @max_depth: depth of nodes whose edges are not checked.
+ * @filter_func: function deciding which edges can be followed or %NULL.
+ * @filter_data: data passed to @filter_func.
+ *
+ * Limits traversal done by @iter to nodes at most @max_depth steps away from
+ * starting node, going only through edges accepted by @filter_func. Edges not
+ * accepted are not returned.
+ */
+void
+_g_segraph_iter_set_limits (GSEGraphIter* iter,
+                            guint max_depth,
+                            GSEGraphFilterFunc filter_func,
+                            gpointer filter_data)
+{
+  iter->max_depth = max_depth;
+  iter->filter_func = filter_func;
+  iter->filter_data = filter_data;
+}
+
+/**
+ * _g_segraph_iter_get_depth:
+ * @iter: an iterator.
+ *
+ * Gets depth of last node returned by @iter. In breadth first search it is
+ * a distance from starting node, in depth first search it is a depth in the
+ * search tree.
+ *
+ * Returns: depth of last returned node.
+ */
+guint
+_g_segraph_iter_get_depth (GSEGraphIter* iter)
+{
+  return iter->last_depth;
+}
+
+/**
+ * _g_segraph_iter_skip_children:
+ * @iter: an iterator, whose last step returned a node.
+ *
+ * Makes @iter not check edges of last returned node. Nodes and edges reachable
+ * only through that node will not be returned.
+ */
+void
+_g_segraph_iter_skip_children (GSEGraphIter* iter)
+{
+  if (iter->stack)
+  {
+    g_array_set_size (iter->stack, iter->stack->len - 1);
+  }
+  else
+  {
+    g_ptr_array_set_size (iter->queue, iter->queue->len - 1);
+  }
+}
+
+/**
+ * _g_segraph_iter_clear:
+ * @iter: an iterator.
+ *
+ * Frees memory allocated by @iter, but not @iter itself.
+ */
+void
+_g_segraph_iter_clear (GSEGraphIter* iter)
+{
+  if (iter->stack)
+  {
+    g_array_free (iter->stack, TRUE);
+  }
+  if (iter->queue)
+  {
+    g_ptr_array_free (iter->queue, TRUE);
+  }
+  _g_sgraph_visited_clear (&iter->visited);
+}
+
+/* static function definitions. */
+
+/**
+ * _g_segraph_iter_next_DFS:
+ * @iter: an iterator.
+ * @node: place for a newly found node.
+ * @edge: place for a newly found edge.
+ *
+ * Does next step using depth first search algorithm. Instead of recursion, an
+ * explicit stack is used, so long paths do not exhaust thread's stack.
+ *
+ * Returns: %TRUE if step was done, %FALSE if traversal is finished.
+ */
+static gboolean
+_g_segraph_iter_next_DFS (GSEGraphIter* iter,
+                          GSEGraphNode** node,
+                          GSEGraphEdge** edge)
+{
+  GArray* stack;
+
+  stack = iter->stack;
+  while (stack->len)
+  {
+    GSEGraphIterFrame* top;
+    GSEGraphIterFrame frame;
+    GSEGraphNode* other_node;
+    GSEGraphEdge* temp_edge;
+
+    top = &g_array_index (stack, GSEGraphIterFrame, stack->len - 1);
+    if ((top->position == top->node->edges->len) ||
+        (stack->len > iter->max_depth))
+    {
+      g_array_set_size (stack, stack->len - 1);
+      continue;
+    }
+
+    temp_edge = g_ptr_array_index (top->node->edges, top->position);
+    ++top->position;
+    if (iter->filter_func && !(*iter->filter_func) (top->node,
+                                                     temp_edge,
+                                                     iter->filter_data))
+    {
+      continue;
+    }
+    if (_g_sgraph_visited_check (&iter->visited,
+                                 temp_edge,
+                                 &temp_edge->visit_mark))
+    {
+      continue;
+    }
+
+    *edge = temp_edge;
+    other_node = g_segraph_edge_get_node (temp_edge, top->node);
+    if (other_node && !_g_sgraph_visited_check (&iter->visited,
+                                                 other_node,
+                                                 &other_node->visit_mark))
+    {
+      *node = other_node;
+      iter->last_depth = stack->len;
+      frame.node = other_node;
+      frame.position = 0;
+      g_array_append_val (stack, frame);
+    }
+    return TRUE;
+  }
+
+  return FALSE;
+}
+
+/**
+ * _g_segraph_iter_next_BFS:
+ * @iter: an iterator.
+ * @node: place for a newly found node.
+ * @edge: place for a newly found edge.
+ *
+ * Does next step using breadth first search algorithm. Expanded nodes are
+ * dropped from the front of the queue from time to time, so it does not grow
+ * to the size of whole graph.
+ *
+ * Returns: %TRUE if step was done, %FALSE if traversal is finished.
+ */
+static gboolean
+_g_segraph_iter_next_BFS (GSEGraphIter* iter,
+                          GSEGraphNode** node,
+                          GSEGraphEdge** edge)
+{
+  GPtrArray* queue;
+
+  queue = iter->queue;
+  while (iter->head < queue->len)
+  {
+    GSEGraphNode* temp_node;
+    GSEGraphNode* other_node;
+    GSEGraphEdge* temp_edge;
+
+    if (iter->depth >= iter->max_depth)
+    {
+      break;
+    }
+
+    temp_node = g_ptr_array_index (queue, iter->head);
+    if (iter->position == temp_node->edges->len)
+    {
+      ++iter->head;
+      iter->position = 0;
+      if (iter->head == iter->level_end)
+      {
+        ++iter->depth;
+        iter->level_end = queue->len;
+      }
+      continue;
+    }
+
+    temp_edge = g_ptr_array_index (temp_node->edges, iter->position);
+    ++iter->position;
+    if (iter->filter_func && !(*iter->filter_func) (temp_node,
+                                                     temp_edge,
+                                                     iter->filter_data))
+    {
+      continue;
+    }
+    if (_g_sgraph_visited_check (&iter->visited,
+                                 temp_edge,
+                                 &temp_edge->visit_mark))
+    {
+      continue;
+    }
+
+    *edge = temp_edge;
+    other_node = g_segraph_edge_get_node (temp_edge, temp_node);
+    if (other_node && !_g_sgraph_visited_check (&iter->visited,
+                                                 other_node,
+                                                 &other_node->visit_mark))
+    {
+      if ((iter->head >= G_SEGRAPH_ITER_COMPACT_THRESHOLD) &&
+          (iter->head * 2 >= queue->len))
+      {
+        g_ptr_array_remove_range (queue, 0, iter->head);
+        iter->level_end -= iter->head;
+        iter->head = 0;
+      }
+      *node = other_node;
+      iter->last_depth = iter->depth + 1;
+      g_ptr_array_add (queue, other_node);
+    }
+    return TRUE;
+  }
+
+  return FALSE;
+}
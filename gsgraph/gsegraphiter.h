@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined (G_DISABLE_SINGLE_INCLUDES) && !defined (_G_SEGRAPH_H_INSIDE_) && !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "Only <gsgraph/gsegraph.h> can be included directly."
+#endif
+
+#ifndef _G_SEGRAPH_ITER_H_
+#define _G_SEGRAPH_ITER_H_
+
+#include <glib.h>
+
+#include <gsgraph/gsegraphnode.h>
+#include <gsgraph/gsegraphedge.h>
+#include <gsgraph/gsegraphenums.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GSEGraphIter:
+ *
+ * Opaque iterator traversing a graph edge by edge.
+ */
+typedef struct _GSEGraphIter GSEGraphIter;
+
+GSEGraphIter*
+g_segraph_iter_new (GSEGraphNode* node,
+                    GSEGraphTraverseType traverse_type) G_GNUC_WARN_UNUSED_RESULT;
+
+gboolean
+g_segraph_iter_next (GSEGraphIter* iter,
+                     GSEGraphNode** node,
+                     GSEGraphEdge** edge);
+
+void
+g_segraph_iter_free (GSEGraphIter* iter);
+
+G_END_DECLS
+
+#endif /* _G_SEGRAPH_ITER_H_ */
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "This is a private header, it must not be included outside libggraph."
+#endif
+
+#ifndef _G_SEGRAPH_ITER_PRIVATE_H_
+#define _G_SEGRAPH_ITER_PRIVATE_H_
+
+#include <glib.h>
+
+#include "gsegraphiter.h"
+#include "gsgraphvisited.h"
+
+G_BEGIN_DECLS
+
+/**
+ * GSEGraphIterFrame:
+ * @node: a node.
+ * @position: index of next edge of @node to check.
+ *
+ * Internal struct used as a depth first search stack frame.
+ */
+typedef struct _GSEGraphIterFrame GSEGraphIterFrame;
+
+struct _GSEGraphIterFrame
+{
+  GSEGraphNode* node;
+  guint position;
+};
+
+/**
+ * GSEGraphIter:
+ * @traverse_type: traversing algorithm.
+ * @visited: a set of already visited nodes and edges.
+ * @start: node to be returned first or %NULL if it was already returned.
+ * @stack: array of #GSEGraphIterFrame, used in depth first search.
+ * @queue: array of discovered nodes, used in breadth first search.
+ * @head: index of node in @queue whose edges are checked.
+ * @position: index of next edge of node at @head to check.
+ * @level_end: index in @queue of first node deeper than node at @head.
+ * @depth: depth of node at @head.
+ * @last_depth: depth of last returned node.
+ * @max_depth: depth of nodes whose edges are not checked.
+ * @filter_func: function deciding which edges can be followed or %NULL.
+ * @filter_data: data passed to @filter_func.
+ *
+ * Internal state of a traversal.
+ */
+struct _GSEGraphIter
+{
+  GSEGraphTraverseType traverse_type;
+  GSGraphVisited visited;
+  GSEGraphNode* start;
+  GArray* stack;
+  GPtrArray* queue;
+  guint head;
+  guint position;
+  guint level_end;
+  guint depth;
+  guint last_depth;
+  guint max_depth;
+  GSEGraphFilterFunc filter_func;
+  gpointer filter_data;
+};
+
+G_GNUC_INTERNAL void
+_g_segraph_iter_init (GSEGraphIter* iter,
+                      GSEGraphNode* node,
+                      GSEGraphTraverseType traverse_type,
+                      gboolean use_marks);
+
+G_GNUC_INTERNAL void
+_g_segraph_iter_set_limits (GSEGraphIter* iter,
+                            guint max_depth,
+                            GSEGraphFilterFunc filter_func,
+                            gpointer filter_data);
+
+G_GNUC_INTERNAL guint
+_g_segraph_iter_get_depth (GSEGraphIter* iter);
+
+G_GNUC_INTERNAL void
+_g_segraph_iter_skip_children (GSEGraphIter* iter);
+
+G_GNUC_INTERNAL void
+_g_segraph_iter_clear (GSEGraphIter* iter);
+
+G_END_DECLS
+
+#endif /* _G_SEGRAPH_ITER_PRIVATE_H_ */
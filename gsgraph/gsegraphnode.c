@@ -18,8 +18,13 @@
  */
 
 #include "gsegraphnode.h"
+#include "gsegraphnodeprivate.h"
 
 #include "gsegraphedge.h"
+#include "gsegraphconnectivityprivate.h"
+#include "gsegrapharenaprivate.h"
+#include "gsegraphiterprivate.h"
+#include "gsgraphvisited.h"
 
 /**
  * SECTION: gsegraphnode
@@ -31,12 +36,26 @@
  * Single node of connected graph. It contains data and an array of pointers to
  * edges to all its neighbours.
  *
- * To create a single node, use g_segraph_node_new().
+ * To create a single node, use g_segraph_node_new() or
+ * g_segraph_node_new_in_arena().
  *
  * To check if two nodes are in the same graph, use
- * g_segraph_node_are_separate().
+ * g_segraph_node_are_separate() or
+ * g_segraph_node_are_separate_bidirectional(). If many such checks are needed,
+ * add nodes to #GSEGraphConnectivity first.
  *
- * To free a node, use g_segraph_node_free().
+ * To visit nodes near given one, use g_segraph_node_visit(). It can limit
+ * depth of traversal, skip parts of graph and stop early, so it does work
+ * proportional to the number of visited nodes and their edges, not to the size
+ * of the graph.
+ *
+ * To free a node, use g_segraph_node_free(). To free a node together with all
+ * its edges, use g_segraph_node_remove(). To do it with many nodes at once, use
+ * g_segraph_node_remove_batch().
+ *
+ * Edges are removed from node's edges array in constant time by moving the last
+ * edge in place of the removed one. If order of edges has to be preserved, use
+ * g_segraph_node_set_keep_edge_order().
  *
  * <note>
  *   <para>
@@ -46,13 +65,38 @@
  * </note>
  */
 
+/* internal types. */
+
+/**
+ * GSEGraphNodeFrame:
+ * @node: a node.
+ * @position: index of next edge of @node to check.
+ *
+ * Internal struct used as a depth first search stack frame.
+ */
+typedef struct _GSEGraphNodeFrame GSEGraphNodeFrame;
+
+struct _GSEGraphNodeFrame
+{
+  GSEGraphNode* node;
+  guint position;
+};
+
 /* static function declarations. */
 
+static GSEGraphNode*
+_g_segraph_node_new_general (GSEGraphArena* arena,
+                             gpointer data);
+
 static gboolean
 _g_segraph_node_separation_check (GSEGraphNode* node,
                                   GSEGraphNode* other_node,
-                                  GHashTable* visited_nodes,
-                                  GHashTable* visited_edges);
+                                  GSGraphVisited* visited);
+
+static gboolean
+_g_segraph_node_expand_frontier (GPtrArray** frontier,
+                                 GSGraphVisited* visited,
+                                 guint32 side);
 
 /* public function definitions */
 
@@ -67,12 +111,27 @@ _g_segraph_node_separation_check (GSEGraphNode* node,
 GSEGraphNode*
 g_segraph_node_new (gpointer data)
 {
-  GSEGraphNode* graph;
+  return _g_segraph_node_new_general (NULL, data);
+}
 
-  graph = g_slice_new (GSEGraphNode);
-  graph->data = data;
-  graph->edges = g_ptr_array_new ();
-  return graph;
+/**
+ * g_segraph_node_new_in_arena:
+ * @arena: an arena.
+ * @data: data.
+ *
+ * Creates new separate graph node holding @data with memory taken from
+ * @arena. Such node is freed with g_segraph_node_free() or together with whole
+ * @arena.
+ *
+ * Returns: newly created #GSEGraphNode.
+ */
+GSEGraphNode*
+g_segraph_node_new_in_arena (GSEGraphArena* arena,
+                             gpointer data)
+{
+  g_return_val_if_fail (arena != NULL, NULL);
+
+  return _g_segraph_node_new_general (arena, data);
 }
 
 /**
@@ -82,7 +141,8 @@ g_segraph_node_new (gpointer data)
  * Frees memory allocated to @node and returns a pointer to data of freed node.
  * It is up to programmist to handle bad edges. Running
  * g_segraph_edge_disconnect_node() or g_segraph_edge_disconnect() on all edges
- * connecting @node is a safe bet.
+ * connecting @node is a safe bet. g_segraph_node_remove() does it and frees
+ * the edges.
  *
  * Returns: pointer to @node's data.
  */
@@ -94,17 +154,208 @@ g_segraph_node_free (GSEGraphNode* node)
   g_return_val_if_fail (node != NULL, NULL);
 
   data = node->data;
-  g_ptr_array_free (node->edges, TRUE);
-  g_slice_free (GSEGraphNode, node);
+  _g_segraph_node_dispose (node);
+  if (node->arena)
+  {
+    _g_segraph_arena_release_node (node->arena, node);
+  }
+  else
+  {
+    g_slice_free (GSEGraphNode, node);
+  }
   return data;
 }
 
+/**
+ * g_segraph_node_remove:
+ * @node: a node.
+ * @edge_data_destroy_func: function freeing data of removed edges or %NULL.
+ *
+ * Removes all edges of @node from their other ends, frees them and frees
+ * @node. Takes time linear in @node's degree. Checking if former neighbours
+ * are separate is up to programmist.
+ *
+ * Returns: pointer to @node's data.
+ */
+gpointer
+g_segraph_node_remove (GSEGraphNode* node,
+                       GDestroyNotify edge_data_destroy_func)
+{
+  guint iter;
+
+  g_return_val_if_fail (node != NULL, NULL);
+
+  for (iter = 0; iter < node->edges->len; ++iter)
+  {
+    GSEGraphEdge* edge;
+    GSEGraphNode* other_node;
+    gpointer data;
+
+    edge = g_ptr_array_index (node->edges, iter);
+    if (edge->first == node)
+    {
+      edge->first = NULL;
+    }
+    else if (edge->second == node)
+    {
+      edge->second = NULL;
+    }
+    else
+    {
+      continue;
+    }
+
+    other_node = (edge->first) ? edge->first : edge->second;
+    if (other_node == node)
+    {
+      /* a loop - it will be freed when its second end is met. */
+      continue;
+    }
+    if (other_node)
+    {
+      g_segraph_edge_clean_disconnect_node (edge, other_node);
+    }
+
+    data = g_segraph_edge_free (edge);
+    if (edge_data_destroy_func)
+    {
+      (*edge_data_destroy_func) (data);
+    }
+  }
+
+  return g_segraph_node_free (node);
+}
+
+/**
+ * g_segraph_node_remove_batch:
+ * @nodes: an array of nodes to remove.
+ * @node_data_destroy_func: function freeing data of removed nodes or %NULL.
+ * @edge_data_destroy_func: function freeing data of removed edges or %NULL.
+ *
+ * Removes all nodes in @nodes together with all their edges. Each node
+ * surviving the removal has its edges array swept once, so time is linear in
+ * total degree of removed nodes and their surviving neighbours. Order of edges
+ * of surviving nodes is preserved. @nodes must not contain duplicates and is
+ * not freed.
+ */
+void
+g_segraph_node_remove_batch (GPtrArray* nodes,
+                             GDestroyNotify node_data_destroy_func,
+                             GDestroyNotify edge_data_destroy_func)
+{
+  GSGraphVisited visited;
+  GPtrArray* affected;
+  GPtrArray* removed_edges;
+  guint iter;
+
+  g_return_if_fail (nodes != NULL);
+
+  _g_sgraph_visited_init (&visited, G_SGRAPH_VISITED_DOMAIN_SEGRAPH, 2);
+  for (iter = 0; iter < nodes->len; ++iter)
+  {
+    GSEGraphNode* node;
+
+    node = g_ptr_array_index (nodes, iter);
+    _g_sgraph_visited_set (&visited, node, &node->visit_mark, 1);
+  }
+
+  affected = g_ptr_array_new ();
+  removed_edges = g_ptr_array_new ();
+  for (iter = 0; iter < nodes->len; ++iter)
+  {
+    GSEGraphNode* node;
+    guint iter2;
+
+    node = g_ptr_array_index (nodes, iter);
+    for (iter2 = 0; iter2 < node->edges->len; ++iter2)
+    {
+      GSEGraphEdge* edge;
+      GSEGraphNode* other_node;
+
+      edge = g_ptr_array_index (node->edges, iter2);
+      if (!g_segraph_edge_get_node_extended (edge, node, &other_node) ||
+          _g_sgraph_visited_check (&visited, edge, &edge->visit_mark))
+      {
+        continue;
+      }
+      g_ptr_array_add (removed_edges, edge);
+
+      if (!other_node ||
+          _g_sgraph_visited_get (&visited, other_node, &other_node->visit_mark))
+      {
+        continue;
+      }
+      _g_sgraph_visited_set (&visited, other_node, &other_node->visit_mark, 2);
+      g_ptr_array_add (affected, other_node);
+    }
+  }
+
+  for (iter = 0; iter < affected->len; ++iter)
+  {
+    GSEGraphNode* node;
+    guint iter2;
+    guint kept;
+
+    node = g_ptr_array_index (affected, iter);
+    kept = 0;
+    for (iter2 = 0; iter2 < node->edges->len; ++iter2)
+    {
+      GSEGraphEdge* edge;
+
+      edge = g_ptr_array_index (node->edges, iter2);
+      if (_g_sgraph_visited_get (&visited, edge, &edge->visit_mark))
+      {
+        continue;
+      }
+      if ((edge->first == node) && (edge->first_position == iter2))
+      {
+        edge->first_position = kept;
+      }
+      else if ((edge->second == node) && (edge->second_position == iter2))
+      {
+        edge->second_position = kept;
+      }
+      g_ptr_array_index (node->edges, kept) = edge;
+      ++kept;
+    }
+    g_ptr_array_set_size (node->edges, kept);
+    _g_segraph_connectivity_node_disconnected (node);
+  }
+  _g_sgraph_visited_clear (&visited);
+  g_ptr_array_free (affected, TRUE);
+
+  for (iter = 0; iter < removed_edges->len; ++iter)
+  {
+    gpointer data;
+
+    data = g_segraph_edge_free (g_ptr_array_index (removed_edges, iter));
+    if (edge_data_destroy_func)
+    {
+      (*edge_data_destroy_func) (data);
+    }
+  }
+  g_ptr_array_free (removed_edges, TRUE);
+
+  for (iter = 0; iter < nodes->len; ++iter)
+  {
+    gpointer data;
+
+    data = g_segraph_node_free (g_ptr_array_index (nodes, iter));
+    if (node_data_destroy_func)
+    {
+      (*node_data_destroy_func) (data);
+    }
+  }
+}
+
 /**
  * g_segraph_node_are_separate:
  * @node: first node.
  * @other_node: second node.
  *
- * Checks if @node and @other_node are separate.
+ * Checks if @node and @other_node are separate. If any of the nodes is held by
+ * valid #GSEGraphConnectivity, the answer is taken from it in nearly constant
+ * time. Otherwise graph is traversed.
  *
  * <note>
  *   <para>
@@ -112,6 +363,8 @@ g_segraph_node_free (GSEGraphNode* node)
  *     and you are able to say which of graphs will have lower order, call this
  *     function with @node being in larger graph and @other_node being in
  *     smaller one.
+ *     If you cannot tell it, use
+ *     g_segraph_node_are_separate_bidirectional() instead.
  *   </para>
  * </note>
  *
@@ -121,87 +374,417 @@ gboolean
 g_segraph_node_are_separate (GSEGraphNode* node,
                              GSEGraphNode* other_node)
 {
-  GHashTable* visited_nodes;
-  GHashTable* visited_edges;
+  GSGraphVisited visited;
   gboolean are_separate;
 
   g_return_val_if_fail (node != NULL, FALSE);
   g_return_val_if_fail (other_node != NULL, FALSE);
 
-  visited_nodes = g_hash_table_new (NULL, NULL);
-  visited_edges = g_hash_table_new (NULL, NULL);
+  if (_g_segraph_connectivity_check (node, other_node, &are_separate))
+  {
+    return are_separate;
+  }
+
+  _g_sgraph_visited_init (&visited, G_SGRAPH_VISITED_DOMAIN_SEGRAPH, 1);
 
   are_separate = _g_segraph_node_separation_check (node,
                                                    other_node,
-                                                   visited_nodes,
-                                                   visited_edges);
+                                                   &visited);
+
+  _g_sgraph_visited_clear (&visited);
+
+  return are_separate;
+}
+
+/**
+ * g_segraph_node_are_separate_bidirectional:
+ * @node: first node.
+ * @other_node: second node.
+ *
+ * Checks if @node and @other_node are separate, just like
+ * g_segraph_node_are_separate(). The difference is that breadth first search
+ * is run from both nodes at once, each time expanding whole level of the side
+ * having less nodes in its frontier. Search stops as soon as both sides meet or
+ * one of them is exhausted. So when nodes are in the same graph, amount of work
+ * depends on distance between them rather than on order of the graph, and when
+ * they are separate, the smaller graph is traversed, no matter in which order
+ * the nodes were passed.
+ *
+ * Returns: %TRUE if there is no path between @node and @other_node.
+ */
+gboolean
+g_segraph_node_are_separate_bidirectional (GSEGraphNode* node,
+                                           GSEGraphNode* other_node)
+{
+  GSGraphVisited visited;
+  GPtrArray* frontier;
+  GPtrArray* other_frontier;
+  gboolean are_separate;
+
+  g_return_val_if_fail (node != NULL, FALSE);
+  g_return_val_if_fail (other_node != NULL, FALSE);
+
+  if (node == other_node)
+  {
+    return FALSE;
+  }
+  if (_g_segraph_connectivity_check (node, other_node, &are_separate))
+  {
+    return are_separate;
+  }
+
+  _g_sgraph_visited_init (&visited, G_SGRAPH_VISITED_DOMAIN_SEGRAPH, 2);
+  frontier = g_ptr_array_new ();
+  other_frontier = g_ptr_array_new ();
+
+  _g_sgraph_visited_set (&visited, node, &node->visit_mark, 1);
+  _g_sgraph_visited_set (&visited, other_node, &other_node->visit_mark, 2);
+  g_ptr_array_add (frontier, node);
+  g_ptr_array_add (other_frontier, other_node);
+
+  are_separate = TRUE;
+  while (frontier->len && other_frontier->len)
+  {
+    gboolean met;
+
+    if (frontier->len <= other_frontier->len)
+    {
+      met = _g_segraph_node_expand_frontier (&frontier, &visited, 1);
+    }
+    else
+    {
+      met = _g_segraph_node_expand_frontier (&other_frontier, &visited, 2);
+    }
+    if (met)
+    {
+      are_separate = FALSE;
+      break;
+    }
+  }
 
-  g_hash_table_unref (visited_nodes);
-  g_hash_table_unref (visited_edges);
+  g_ptr_array_free (frontier, TRUE);
+  g_ptr_array_free (other_frontier, TRUE);
+  _g_sgraph_visited_clear (&visited);
 
   return are_separate;
 }
 
+/**
+ * g_segraph_node_set_keep_edge_order:
+ * @node: a node.
+ * @keep_edge_order: whether order of edges has to be preserved.
+ *
+ * Sets whether removing an edge from @node keeps order of remaining edges in
+ * @node's edges array. By default it does not - last edge is moved in place of
+ * removed one, so removal takes constant time. When order is kept, removal
+ * takes time linear in number of @node's edges.
+ */
+void
+g_segraph_node_set_keep_edge_order (GSEGraphNode* node,
+                                    gboolean keep_edge_order)
+{
+  g_return_if_fail (node != NULL);
+
+  node->keep_edge_order = (keep_edge_order != FALSE);
+}
+
+/**
+ * g_segraph_node_get_keep_edge_order:
+ * @node: a node.
+ *
+ * Checks whether removing an edge from @node keeps order of remaining edges.
+ *
+ * Returns: %TRUE if order of edges is preserved, otherwise %FALSE.
+ */
+gboolean
+g_segraph_node_get_keep_edge_order (GSEGraphNode* node)
+{
+  g_return_val_if_fail (node != NULL, FALSE);
+
+  return node->keep_edge_order;
+}
+
+/**
+ * g_segraph_node_visit:
+ * @node: a node traversal starts from.
+ * @traverse_type: which traversing algorithm to use.
+ * @max_depth: depth of nodes whose edges are not followed. Pass %G_MAXUINT for
+ * no limit.
+ * @visit_func: function called for each visited node.
+ * @filter_func: function deciding which edges can be followed or %NULL.
+ * @user_data: data passed to @visit_func and @filter_func.
+ *
+ * Traverses graph from @node, calling @visit_func for each node at most
+ * @max_depth steps away from @node, @node included. Traversal goes through an
+ * edge only if @filter_func is %NULL or returns %TRUE for it and the node
+ * traversal goes from. When @visit_func returns
+ * %G_SEGRAPH_VISIT_SKIP_CHILDREN, edges of the node are not followed, and when
+ * it returns %G_SEGRAPH_VISIT_STOP, traversal is finished at once.
+ *
+ * In breadth first search depth of a node is its distance from @node, so
+ * all nodes at most @max_depth steps away are visited. In depth first search
+ * it is a depth in search tree, which can be greater than the distance.
+ *
+ * <note>
+ *   <para>
+ *     @visit_func and @filter_func must not change the graph and must not call
+ *     g_segraph_visit_marks_set_enabled() or g_segraph_visit_marks_clear().
+ *   </para>
+ * </note>
+ *
+ * Returns: a node for which @visit_func returned %G_SEGRAPH_VISIT_STOP or
+ * %NULL if traversal was not stopped.
+ */
+GSEGraphNode*
+g_segraph_node_visit (GSEGraphNode* node,
+                      GSEGraphTraverseType traverse_type,
+                      guint max_depth,
+                      GSEGraphVisitFunc visit_func,
+                      GSEGraphFilterFunc filter_func,
+                      gpointer user_data)
+{
+  GSEGraphIter iter;
+  GSEGraphNode* visited_node;
+  GSEGraphNode* stop_node;
+  GSEGraphEdge* edge;
+
+  g_return_val_if_fail (node != NULL, NULL);
+  g_return_val_if_fail (visit_func != NULL, NULL);
+  g_return_val_if_fail ((traverse_type == G_SEGRAPH_TRAVERSE_BFS) ||
+                        (traverse_type == G_SEGRAPH_TRAVERSE_DFS), NULL);
+
+  _g_segraph_iter_init (&iter, node, traverse_type, TRUE);
+  _g_segraph_iter_set_limits (&iter, max_depth, filter_func, user_data);
+
+  stop_node = NULL;
+  while (g_segraph_iter_next (&iter, &visited_node, &edge))
+  {
+    GSEGraphVisitResult result;
+
+    if (!visited_node)
+    {
+      continue;
+    }
+
+    result = (*visit_func) (visited_node,
+                            edge,
+                            _g_segraph_iter_get_depth (&iter),
+                            user_data);
+    if (result == G_SEGRAPH_VISIT_STOP)
+    {
+      stop_node = visited_node;
+      break;
+    }
+    if (result == G_SEGRAPH_VISIT_SKIP_CHILDREN)
+    {
+      _g_segraph_iter_skip_children (&iter);
+    }
+  }
+
+  _g_segraph_iter_clear (&iter);
+
+  return stop_node;
+}
+
+/* internal function definitions. */
+
+/**
+ * _g_segraph_node_dispose:
+ * @node: a node.
+ *
+ * Frees everything @node holds, but not @node itself. Edges array of @node is
+ * set to %NULL.
+ */
+void
+_g_segraph_node_dispose (GSEGraphNode* node)
+{
+  _g_segraph_connectivity_node_freed (node);
+  g_ptr_array_free (node->edges, TRUE);
+  node->edges = NULL;
+}
+
 /* static function definitions. */
 
+/**
+ * _g_segraph_node_new_general:
+ * @arena: an arena or %NULL.
+ * @data: data.
+ *
+ * Creates new separate graph node holding @data. If @arena is not %NULL,
+ * memory for node is taken from it.
+ *
+ * Returns: newly created #GSEGraphNode.
+ */
+static GSEGraphNode*
+_g_segraph_node_new_general (GSEGraphArena* arena,
+                             gpointer data)
+{
+  GSEGraphNode* graph;
+
+  if (arena)
+  {
+    graph = _g_segraph_arena_alloc_node (arena);
+  }
+  else
+  {
+    graph = g_slice_new (GSEGraphNode);
+  }
+  graph->data = data;
+  graph->edges = g_ptr_array_new ();
+  graph->connectivity = NULL;
+  graph->connectivity_index = 0;
+  graph->visit_mark = 0;
+  graph->keep_edge_order = FALSE;
+  graph->arena = arena;
+  return graph;
+}
+
 /**
  * _g_segraph_node_separation_check:
  * @node: a node.
  * @other_node: other node.
- * @visited_nodes: map of already visited nodes.
- * @visited_edges: map of already visited edges.
+ * @visited: a set of already visited nodes and edges.
  *
- * Checks if @node and @other_node are same. If so - returns %FALSE, otherwise
- * it runs same check against @node and @other_node's neighbours, until it
- * happens or whole graph is traversed.
+ * Checks if @node and @other_node are same. If not, it runs same check against
+ * @node and @other_node's neighbours in depth first order, until it happens or
+ * whole graph is traversed. An explicit stack allocated once per check is used
+ * instead of recursion.
  *
  * Returns: %TRUE if @node and other_node are not the same, otherwise @FALSE.
  */
 static gboolean
 _g_segraph_node_separation_check (GSEGraphNode* node,
                                   GSEGraphNode* other_node,
-                                  GHashTable* visited_nodes,
-                                  GHashTable* visited_edges)
+                                  GSGraphVisited* visited)
 {
-  guint iter;
+  GArray* stack;
+  GSEGraphNodeFrame frame;
+  gboolean are_separate;
 
   if (node == other_node)
   {
     return FALSE;
   }
 
-  g_hash_table_insert (visited_nodes, other_node, NULL);
+  stack = g_array_new (FALSE, FALSE, sizeof (GSEGraphNodeFrame));
 
-  for (iter = 0; iter < other_node->edges->len; ++iter)
+  _g_sgraph_visited_set (visited, other_node, &other_node->visit_mark, 1);
+  frame.node = other_node;
+  frame.position = 0;
+  g_array_append_val (stack, frame);
+
+  are_separate = TRUE;
+  while (stack->len)
   {
+    GSEGraphNodeFrame* top;
     GSEGraphEdge* edge;
     GSEGraphNode* temp_node;
 
-    edge = g_ptr_array_index (other_node->edges, iter);
-    if (g_hash_table_lookup_extended (visited_edges, edge, NULL, NULL))
+    top = &g_array_index (stack, GSEGraphNodeFrame, stack->len - 1);
+    if (top->position == top->node->edges->len)
+    {
+      g_array_set_size (stack, stack->len - 1);
+      continue;
+    }
+
+    edge = g_ptr_array_index (top->node->edges, top->position);
+    ++top->position;
+    if (_g_sgraph_visited_check (visited, edge, &edge->visit_mark))
     {
       continue;
     }
-    g_hash_table_insert (visited_edges, edge, NULL);
 
-    temp_node = g_segraph_edge_get_node (edge, other_node);
+    temp_node = g_segraph_edge_get_node (edge, top->node);
     if (!temp_node)
     {
       continue;
     }
 
-    if (g_hash_table_lookup_extended (visited_nodes, temp_node, NULL, NULL))
+    if (_g_sgraph_visited_get (visited, temp_node, &temp_node->visit_mark))
     {
       continue;
     }
 
-    if (!_g_segraph_node_separation_check (node,
-                                           temp_node,
-                                           visited_nodes,
-                                           visited_edges))
+    if (temp_node == node)
     {
-      return FALSE;
+      are_separate = FALSE;
+      break;
     }
+
+    _g_sgraph_visited_set (visited, temp_node, &temp_node->visit_mark, 1);
+    frame.node = temp_node;
+    frame.position = 0;
+    g_array_append_val (stack, frame);
   }
-  return TRUE;
+
+  g_array_free (stack, TRUE);
+  return are_separate;
+}
+
+/**
+ * _g_segraph_node_expand_frontier:
+ * @frontier: pointer to array of nodes in current level of search.
+ * @visited: a set of visited nodes, remembering side of search which reached
+ * them.
+ * @side: side of search @frontier belongs to.
+ *
+ * Replaces nodes in @frontier with their neighbours not visited yet, marking
+ * them with @side. Half-edges are skipped. Stops when a node visited by other
+ * side is reached.
+ *
+ * Returns: %TRUE if a node visited by other side was reached, otherwise
+ * %FALSE.
+ */
+static gboolean
+_g_segraph_node_expand_frontier (GPtrArray** frontier,
+                                 GSGraphVisited* visited,
+                                 guint32 side)
+{
+  GPtrArray* next_frontier;
+  guint iter;
+  gboolean met;
+
+  next_frontier = g_ptr_array_new ();
+  met = FALSE;
+  for (iter = 0; (iter < (*frontier)->len) && !met; ++iter)
+  {
+    GSEGraphNode* temp_node;
+    guint iter2;
+
+    temp_node = g_ptr_array_index (*frontier, iter);
+    for (iter2 = 0; iter2 < temp_node->edges->len; ++iter2)
+    {
+      GSEGraphNode* neighbour;
+      guint32 neighbour_side;
+
+      neighbour = g_segraph_edge_get_node (g_ptr_array_index (temp_node->edges,
+                                                              iter2),
+                                           temp_node);
+      if (!neighbour)
+      {
+        continue;
+      }
+
+      neighbour_side = _g_sgraph_visited_get (visited,
+                                              neighbour,
+                                              &neighbour->visit_mark);
+      if (!neighbour_side)
+      {
+        _g_sgraph_visited_set (visited,
+                               neighbour,
+                               &neighbour->visit_mark,
+                               side);
+        g_ptr_array_add (next_frontier, neighbour);
+      }
+      else if (neighbour_side != side)
+      {
+        met = TRUE;
+        break;
+      }
+    }
+  }
+
+  g_ptr_array_free (*frontier, TRUE);
+  *frontier = next_frontier;
+  return met;
 }
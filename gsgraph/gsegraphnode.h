@@ -27,6 +27,7 @@
 #include <glib.h>
 
 #include <gsgraph/gsegraphtypedefs.h>
+#include <gsgraph/gsegraphenums.h>
 
 G_BEGIN_DECLS
 
@@ -41,18 +42,89 @@ struct _GSEGraphNode
 {
   gpointer data;
   GPtrArray* edges;
+
+  /*< private >*/
+  GSEGraphConnectivity* connectivity;
+  guint connectivity_index;
+  guint32 visit_mark;
+  gboolean keep_edge_order;
+  GSEGraphArena* arena;
 };
 
+/**
+ * GSEGraphVisitFunc:
+ * @node: a visited node.
+ * @edge: an edge traversal came through to @node or %NULL for starting node.
+ * @depth: number of steps from starting node to @node in traversal.
+ * @user_data: data passed to g_segraph_node_visit().
+ *
+ * Specifies type of function called for each node visited by
+ * g_segraph_node_visit().
+ *
+ * Returns: how traversal should go on.
+ */
+typedef GSEGraphVisitResult (*GSEGraphVisitFunc) (GSEGraphNode* node,
+                                                  GSEGraphEdge* edge,
+                                                  guint depth,
+                                                  gpointer user_data);
+
+/**
+ * GSEGraphFilterFunc:
+ * @node: a node traversal goes from.
+ * @edge: an edge of @node traversal would go through.
+ * @user_data: data passed to g_segraph_node_visit().
+ *
+ * Specifies type of function deciding whether traversal can go from @node
+ * through @edge.
+ *
+ * Returns: %TRUE if traversal can go through @edge, otherwise %FALSE.
+ */
+typedef gboolean (*GSEGraphFilterFunc) (GSEGraphNode* node,
+                                        GSEGraphEdge* edge,
+                                        gpointer user_data);
+
 GSEGraphNode*
 g_segraph_node_new (gpointer data) G_GNUC_WARN_UNUSED_RESULT;
 
+GSEGraphNode*
+g_segraph_node_new_in_arena (GSEGraphArena* arena,
+                             gpointer data) G_GNUC_WARN_UNUSED_RESULT;
+
 gpointer
 g_segraph_node_free (GSEGraphNode* node);
 
+gpointer
+g_segraph_node_remove (GSEGraphNode* node,
+                       GDestroyNotify edge_data_destroy_func);
+
+void
+g_segraph_node_remove_batch (GPtrArray* nodes,
+                             GDestroyNotify node_data_destroy_func,
+                             GDestroyNotify edge_data_destroy_func);
+
 gboolean
 g_segraph_node_are_separate (GSEGraphNode* node,
                              GSEGraphNode* other_node);
 
+gboolean
+g_segraph_node_are_separate_bidirectional (GSEGraphNode* node,
+                                           GSEGraphNode* other_node);
+
+void
+g_segraph_node_set_keep_edge_order (GSEGraphNode* node,
+                                    gboolean keep_edge_order);
+
+gboolean
+g_segraph_node_get_keep_edge_order (GSEGraphNode* node);
+
+GSEGraphNode*
+g_segraph_node_visit (GSEGraphNode* node,
+                      GSEGraphTraverseType traverse_type,
+                      guint max_depth,
+                      GSEGraphVisitFunc visit_func,
+                      GSEGraphFilterFunc filter_func,
+                      gpointer user_data);
+
 G_END_DECLS
 
 #endif /* _G_SEGRAPH_NODE_H_ */
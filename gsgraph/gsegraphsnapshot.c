@@ -21,6 +21,16 @@
 
 #include "gsegraphedge.h"
 #include "gsegraphnode.h"
+#include "gsegraphcsr.h"
+#include "gsegrapharenaprivate.h"
+#include "gsegraphiterprivate.h"
+#include "gsgraphdisjointset.h"
+#include "gsgraphparallel.h"
+#include "gsgraphdataindex.h"
+#include "gsgraphpositions.h"
+#include "gsgraphordering.h"
+#include "gsgraphcomponents.h"
+#include "gsgraphbiconnected.h"
 
 /**
  * SECTION: gsegraphsnapshot
@@ -38,14 +48,23 @@
  * reflected in wrapper too.
  *
  * Wrapper can be created by using two traversing algorithms to add nodes and
- * edges to arrays inside the wrapper or by specifing data triplets.
+ * edges to arrays inside the wrapper or by specifing data triplets. Traversal
+ * is done with #GSEGraphIter, so the order of nodes and edges is the same as
+ * the order in which an iterator returns them.
  *
  * To create a structure, use g_segraph_snapshot_new(),
  * g_segraph_snapshot_new_from_node(), g_segraph_snapshot_new_from_edge(),
  * g_segraph_snapshot_new_only_nodes() or g_segraph_snapshot_new_only_edges().
  *
- * To make a copy of graph, use g_segraph_snapshot_copy() or
- * g_segraph_snapshot_copy_deep().
+ * To make a copy of graph, use g_segraph_snapshot_copy(),
+ * g_segraph_snapshot_copy_deep() or g_segraph_snapshot_copy_deep_parallel().
+ *
+ * To create nodes and edges of new graph in #GSEGraphArena, use
+ * g_segraph_snapshot_new_in_arena() or g_segraph_snapshot_copy_in_arena().
+ *
+ * To put neighbouring nodes and their edges close to each other in memory, use
+ * g_segraph_snapshot_reorder(). Order of nodes can be computed alone with
+ * g_segraph_snapshot_get_ordering().
  *
  * To free a wrapper or whole graph too, use g_segraph_snapshot_free().
  *
@@ -55,6 +74,26 @@
  * To process nodes or edges, use g_segraph_snapshot_foreach_node() or
  * g_segraph_snapshot_foreach_edge().
  *
+ * To find nodes or edges by data many times, build an index with
+ * g_segraph_snapshot_build_node_index() or
+ * g_segraph_snapshot_build_edge_index() and use
+ * g_segraph_snapshot_lookup_node() or g_segraph_snapshot_lookup_edge().
+ *
+ * To do the above using many threads, use
+ * g_segraph_snapshot_find_node_custom_parallel(),
+ * g_segraph_snapshot_find_edge_custom_parallel(),
+ * g_segraph_snapshot_foreach_node_parallel() or
+ * g_segraph_snapshot_foreach_edge_parallel().
+ *
+ * To find connected components of any array of nodes using many threads, use
+ * g_segraph_snapshot_label_components(). To get one wrapper for each of them,
+ * use g_segraph_snapshot_split_components().
+ *
+ * To find all bridges of a graph at once, use
+ * g_segraph_snapshot_find_bridges().
+ * To find articulation points and biconnected blocks of a graph, use
+ * g_segraph_snapshot_find_blocks().
+ *
  * <note>
  *   <para>
  *     Remember to always take care about data graph holds. When freeing whole
@@ -67,38 +106,70 @@
 /* internal types. */
 
 /**
- * GSEGraphConstructFlags:
- * @G_SEGRAPH_NONE: no nodes were created.
- * @G_SEGRAPH_FIRST: node containing first data was created.
- * @G_SEGRAPH_SECOND: node containing second data was created.
- * @G_SEGRAPH_BOTH: both nodes were created.
+ * GSEGraphSnapshotCopy:
+ * @graph: a graph being copied.
+ * @dup_graph: a copy of @graph.
+ * @positions: positions of @graph's nodes followed by positions of its edges.
+ * @node_data_copy_func: function copying data in nodes.
+ * @node_user_data: data passed to node data copying function.
+ * @edge_data_copy_func: function copying data in edges.
+ * @edge_user_data: data passed to edge data copying function.
  *
- * Internal enum for g_segraph_snapshot_new() needs. Describes which nodes were
- * created.
+ * Internal state of a copy, shared by threads copying nodes and edges.
  */
-typedef enum
+typedef struct _GSEGraphSnapshotCopy GSEGraphSnapshotCopy;
+
+struct _GSEGraphSnapshotCopy
 {
-  G_SEGRAPH_NONE = 0,
-  G_SEGRAPH_FIRST = 1 << 0,
-  G_SEGRAPH_SECOND = 1 << 1,
-  G_SEGRAPH_BOTH = G_SEGRAPH_FIRST | G_SEGRAPH_SECOND
-} GSEGraphConstructFlags;
+  GSEGraphSnapshot* graph;
+  GSEGraphSnapshot* dup_graph;
+  GSGraphPositions positions;
+  GCopyFunc node_data_copy_func;
+  gpointer node_user_data;
+  GCopyFunc edge_data_copy_func;
+  gpointer edge_user_data;
+};
 
-/* static function declarations. */
+/**
+ * GSEGraphSnapshotComponents:
+ * @nodes: nodes being labelled.
+ * @positions: positions of @nodes.
+ * @components: forest of components of @nodes.
+ *
+ * Internal state of components labelling, shared by threads joining nodes.
+ */
+typedef struct _GSEGraphSnapshotComponents GSEGraphSnapshotComponents;
 
-static void
-_g_segraph_snapshot_append_DFS (GSEGraphNode* node,
-                                GPtrArray* node_array,
-                                GHashTable* visited_nodes,
-                                GPtrArray* edge_array,
-                                GHashTable* visited_edges);
+struct _GSEGraphSnapshotComponents
+{
+  GPtrArray* nodes;
+  GSGraphPositions positions;
+  GSGraphComponents* components;
+};
 
-static void
-_g_segraph_snapshot_append_BFS (GSEGraphNode* node,
-                                GPtrArray* node_array,
-                                GHashTable* visited_nodes,
-                                GPtrArray* edge_array,
-                                GHashTable* visited_edges);
+/**
+ * GSEGraphSnapshotFrame:
+ * @index: position of a node being visited.
+ * @edge: edge by which the node was reached or %NULL for a root.
+ * @position: position of next edge to check in edge array of the node.
+ *
+ * Frame of iterative depth-first search.
+ */
+typedef struct _GSEGraphSnapshotFrame GSEGraphSnapshotFrame;
+
+struct _GSEGraphSnapshotFrame
+{
+  guint index;
+  GSEGraphEdge* edge;
+  guint position;
+};
+
+/* static function declarations. */
+
+static GPtrArray*
+_g_segraph_snapshot_new_general (GSEGraphArena* arena,
+                                 GSEGraphDataTriplet** data_triplets,
+                                 guint count);
 
 static GSEGraphSnapshot*
 _g_segraph_snapshot_new_from_node_general (GSEGraphNode* node,
@@ -114,10 +185,47 @@ _g_segraph_snapshot_new_from_edge_general (GSEGraphEdge* edge,
 
 static GSEGraphSnapshot*
 _g_segraph_snapshot_copy_general (GSEGraphSnapshot* graph,
+                                  GSEGraphArena* arena,
                                   GCopyFunc node_data_copy_func,
                                   gpointer node_user_data,
                                   GCopyFunc edge_data_copy_func,
-                                  gpointer edge_user_data);
+                                  gpointer edge_user_data,
+                                  guint n_threads);
+
+static void
+_g_segraph_snapshot_copy_element (guint index,
+                                  gpointer copy);
+
+static GSEGraphNode*
+_g_segraph_snapshot_get_dup_node (GSEGraphSnapshotCopy* copy,
+                                  GSEGraphNode* node);
+
+static GArray*
+_g_segraph_snapshot_compute_ordering (GSEGraphCsr* csr,
+                                      GSEGraphOrdering ordering);
+
+static GArray*
+_g_segraph_snapshot_label_general (GPtrArray* nodes,
+                                   guint* n_components,
+                                   guint n_threads,
+                                   GPtrArray** graphs);
+
+static void
+_g_segraph_snapshot_join_neighbours (guint index,
+                                     gpointer components);
+
+static GPtrArray*
+_g_segraph_snapshot_split (GSEGraphSnapshotComponents* graph_components,
+                           GArray* labels,
+                           guint n_components);
+
+static void
+_g_segraph_snapshot_push_frame (GArray* stack,
+                                guint32* discovery,
+                                guint32* low,
+                                guint32* time,
+                                guint index,
+                                GSEGraphEdge* edge);
 
 static GSEGraphSnapshot*
 _g_segraph_snapshot_new_blank (guint node_array_size,
@@ -125,6 +233,19 @@ _g_segraph_snapshot_new_blank (guint node_array_size,
                                gboolean create_node_array,
                                gboolean create_edge_array);
 
+static gpointer
+_g_segraph_snapshot_get_node_data (gpointer node);
+
+static gpointer
+_g_segraph_snapshot_get_edge_data (gpointer edge);
+
+static guint
+_g_segraph_snapshot_get_node_index (gpointer data,
+                                    GHashTable* data_to_indices,
+                                    GPtrArray* nodes,
+                                    GSGraphDisjointSet* components,
+                                    GSEGraphArena* arena);
+
 /* public function definitions. */
 
 /**
@@ -139,55 +260,16 @@ _g_segraph_snapshot_new_blank (guint node_array_size,
  * @data_triplets is %NULL terminated array. If one of first and second members
  * of #GSEGraphDataTriplet is %NULL, then only one node with not %NULL data and
  * a half-edge holding whatever data was passed as a third member of triplet
- * will be created. For performance reasons it would be good if in second and
- * later pairs one of node have data describing already created node.
- * Lets assume we want to create this graph:
- * <informalexample>
- *   <programlisting>
- *     cA--B-
- *      |
- *     -C--D
- *   </programlisting>
- * </informalexample>
- * So best order of pairs is:
- * <itemizedlist>
- *   <listitem>
- *     <para>
- *       A, B
- *     </para>
- *   </listitem>
- *   <listitem>
- *     <para>
- *       A, A
- *     </para>
- *   </listitem>
- *   <listitem>
- *     <para>
- *       B, %NULL
- *     </para>
- *   </listitem>
- *   <listitem>
- *     <para>
- *       A, C
- *     </para>
- *   </listitem>
- *   <listitem>
- *     <para>
- *       C, %NULL
- *     </para>
- *   </listitem>
- *   <listitem>
- *     <para>
- *       C, D
- *     </para>
- *   </listitem>
- * </itemizedlist>
- * This way we never create a separate graph, because in given pair one of the
- * members is already created, so newly created one will be its neighbour and a
- * part of larger graph.
- * Swaping fourth and sixth pair will cause creation of a separate graph while
- * processing fourth pair and checking if two graphs are one when processing
- * sixth pair.
+ * will be created. If both first and second members hold the same data, a loop
+ * is created.
+ *
+ * Separate graphs are tracked with a disjoint-set forest and node and edge
+ * arrays are filled only after all triplets are processed, so construction
+ * time is nearly linear in number of triplets regardless of their order.
+ * Separate graphs are ordered by first appearance of their nodes in
+ * @data_triplets, nodes in each graph are in order of their creation and edges
+ * are in order of their triplets. Each graph gets an index of its nodes by
+ * data, so they can be found with g_segraph_snapshot_lookup_node().
  *
  * Returns: array of newly created separate graphs or %NULL if no nodes were
  * created.
@@ -196,235 +278,32 @@ GPtrArray*
 g_segraph_snapshot_new (GSEGraphDataTriplet** data_triplets,
                         guint count)
 {
-  GPtrArray* separate_graphs;
-  GHashTable* data_to_nodes;
-  GHashTable* nodes_to_wholes;
-  guint iter;
-
   g_return_val_if_fail (data_triplets != NULL, NULL);
 
-  if (!count)
-  {
-    while (data_triplets[count])
-    {
-      ++count;
-    }
-  }
-
-  if (!count)
-  {
-    return NULL;
-  }
-
-  separate_graphs = g_ptr_array_new ();
-  data_to_nodes = g_hash_table_new (NULL, NULL);
-  nodes_to_wholes = g_hash_table_new (NULL, NULL);
-  for (iter = 0; iter < count; ++iter)
-  {
-    GSEGraphDataTriplet* data_triplet;
-
-    data_triplet = data_triplets[iter];
-    if (g_segraph_data_triplet_is_valid (data_triplet))
-    {
-      GSEGraphNode* first_node;
-      GSEGraphNode* second_node;
-      GSEGraphEdge* edge;
-      GSEGraphConstructFlags created;
-
-      created = G_SEGRAPH_NONE;
-      if (data_triplet->first)
-      {
-        if (!g_hash_table_lookup_extended (data_to_nodes,
-                                           data_triplet->first,
-                                           NULL,
-                                           (gpointer*)&first_node))
-        {
-          first_node = g_segraph_node_new (data_triplet->first);
-          g_hash_table_insert (data_to_nodes,
-                               data_triplet->first,
-                               first_node);
-          created |= G_SEGRAPH_FIRST;
-        }
-      }
-      else
-      {
-        first_node = NULL;
-      }
-
-      if (data_triplet->second)
-      {
-        if (!g_hash_table_lookup_extended (data_to_nodes,
-                                           data_triplet->second,
-                                           NULL,
-                                           (gpointer*)&second_node))
-        {
-          second_node = g_segraph_node_new (data_triplet->second);
-          g_hash_table_insert (data_to_nodes,
-                               data_triplet->second,
-                               second_node);
-          created |= G_SEGRAPH_SECOND;
-        }
-      }
-      else
-      {
-        second_node = NULL;
-      }
-
-      edge = g_segraph_edge_new (data_triplet->edge);
-      g_segraph_edge_connect_nodes (edge, first_node, second_node);
-      switch (created)
-      {
-        case G_SEGRAPH_NONE:
-        {
-          /* no nodes were created, so they can join two separate graphs. */
-          #define JOIN_COUNT 2
-          guint which;
-          GSEGraphSnapshot* joined_graphs[JOIN_COUNT];
-          GSEGraphNode* check_nodes[JOIN_COUNT];
-
-          /* if loop was created, then no graph join occurs. */
-          /* if half-edge was created, then no graph join occurs. */
-          if ((first_node == second_node) || !first_node || !second_node)
-          {
-            break;
-          }
-
-          check_nodes[0] = edge->first;
-          check_nodes[1] = edge->second;
-          for (which = 0; which < JOIN_COUNT; ++which)
-          {
-            guint iter2;
-
-            for (iter2 = 0; iter2 < separate_graphs->len; ++iter2)
-            {
-              GSEGraphSnapshot* graph;
-              guint iter3;
-              gboolean hit;
-
-              graph = g_ptr_array_index (separate_graphs, iter2);
-              hit = FALSE;
-              for (iter3 = 0; iter3 < graph->node_array->len; ++iter3)
-              {
-                GSEGraphNode* temp_node;
-
-                temp_node = g_ptr_array_index (graph->node_array, iter3);
-                if (temp_node == check_nodes[which])
-                {
-                  joined_graphs[which] = graph;
-                  hit = TRUE;
-                  break;
-                }
-              }
-              if (hit)
-              {
-                break;
-              }
-            }
-          }
-
-          if (joined_graphs[0] != joined_graphs[1])
-          {
-            guint iter2;
-
-            for (iter2 = 0; iter2 < joined_graphs[1]->node_array->len; ++iter2)
-            {
-              GSEGraphNode* temp_node;
-
-              temp_node = g_ptr_array_index (joined_graphs[1]->node_array,
-                                             iter2);
-              if (temp_node != check_nodes[1])
-              {
-                g_ptr_array_add (joined_graphs[0]->node_array, temp_node);
-                g_hash_table_insert (nodes_to_wholes,
-                                     temp_node,
-                                     joined_graphs[0]);
-              }
-            }
-
-            for (iter2 = 0; iter2 < joined_graphs[1]->edge_array->len; ++iter2)
-            {
-              GSEGraphEdge* temp_edge;
-
-              temp_edge = g_ptr_array_index (joined_graphs[1]->edge_array,
-                                             iter2);
-              g_ptr_array_add (joined_graphs[0]->edge_array, temp_edge);
-            }
-            g_ptr_array_remove_fast (separate_graphs, joined_graphs[1]);
-            g_segraph_snapshot_free (joined_graphs[1], FALSE);
-          }
-          g_ptr_array_add (joined_graphs[0]->edge_array, edge);
-          #undef JOIN_COUNT
-          break;
-        }
-        case G_SEGRAPH_FIRST:
-        {
-          /* first node was created, so maybe it will belong to existing graph.
-           */
-          GSEGraphSnapshot* temp_graph;
+  return _g_segraph_snapshot_new_general (NULL, data_triplets, count);
+}
 
-          /* creating self-connected node means it creates separate graph. */
-          /* creating half-edged node means it creates separate graph. */
-          if ((first_node == second_node) || !second_node)
-          {
-            temp_graph = _g_segraph_snapshot_new_blank (1, 1, TRUE, TRUE);
-            g_ptr_array_add (separate_graphs, temp_graph);
-          }
-          else
-          {
-            temp_graph = g_hash_table_lookup (nodes_to_wholes, second_node);
-          }
-          g_ptr_array_add (temp_graph->node_array, first_node);
-          g_ptr_array_add (temp_graph->edge_array, edge);
-          g_hash_table_insert (nodes_to_wholes, first_node, temp_graph);
-          break;
-        }
-        case G_SEGRAPH_SECOND:
-        {
-          /* second node was created, so maybe it will belong to existing graph.
-           */
-          GSEGraphSnapshot* temp_graph;
+/**
+ * g_segraph_snapshot_new_in_arena:
+ * @arena: an arena.
+ * @data_triplets: array of data triplets.
+ * @count: length of @data_triplets.
+ *
+ * Does the same as g_segraph_snapshot_new(), but memory for nodes and edges is
+ * taken from @arena.
+ *
+ * Returns: array of newly created separate graphs or %NULL if no nodes were
+ * created.
+ */
+GPtrArray*
+g_segraph_snapshot_new_in_arena (GSEGraphArena* arena,
+                                 GSEGraphDataTriplet** data_triplets,
+                                 guint count)
+{
+  g_return_val_if_fail (arena != NULL, NULL);
+  g_return_val_if_fail (data_triplets != NULL, NULL);
 
-          /* creating self-connected node means it creates separate graph. */
-          /* creating half-edged node means it creates separate graph. */
-          if ((first_node == second_node) || !first_node)
-          {
-            temp_graph = _g_segraph_snapshot_new_blank (1, 1, TRUE, TRUE);
-            g_ptr_array_add (separate_graphs, temp_graph);
-          }
-          else
-          {
-            temp_graph = g_hash_table_lookup (nodes_to_wholes, first_node);
-          }
-          g_ptr_array_add (temp_graph->node_array, second_node);
-          g_ptr_array_add (temp_graph->edge_array, edge);
-          g_hash_table_insert (nodes_to_wholes, second_node, temp_graph);
-          break;
-        }
-        case G_SEGRAPH_BOTH:
-        {
-          /* if both nodes were created then they create separate graph. */
-          GSEGraphSnapshot* temp_graph;
-
-          temp_graph = _g_segraph_snapshot_new_blank (2, 1, TRUE, TRUE);
-          g_ptr_array_add (temp_graph->node_array, first_node);
-          g_ptr_array_add (temp_graph->node_array, second_node);
-          g_ptr_array_add (temp_graph->edge_array, edge);
-          g_ptr_array_add (separate_graphs, temp_graph);
-          g_hash_table_insert (nodes_to_wholes, first_node, temp_graph);
-          g_hash_table_insert (nodes_to_wholes, second_node, temp_graph);
-          break;
-        }
-      }
-    }
-  }
-  g_hash_table_unref (data_to_nodes);
-  g_hash_table_unref (nodes_to_wholes);
-  if (!separate_graphs->len)
-  {
-    g_ptr_array_free (separate_graphs, TRUE);
-    separate_graphs = NULL;
-  }
-  return separate_graphs;
+  return _g_segraph_snapshot_new_general (arena, data_triplets, count);
 }
 
 /**
@@ -530,7 +409,13 @@ g_segraph_snapshot_copy (GSEGraphSnapshot* graph)
   g_return_val_if_fail (graph->node_array != NULL, NULL);
   g_return_val_if_fail (graph->edge_array != NULL, NULL);
 
-  return _g_segraph_snapshot_copy_general (graph, NULL, NULL, NULL, NULL);
+  return _g_segraph_snapshot_copy_general (graph,
+                                           NULL,
+                                           NULL,
+                                           NULL,
+                                           NULL,
+                                           NULL,
+                                           1);
 }
 
 /**
@@ -561,10 +446,214 @@ g_segraph_snapshot_copy_deep (GSEGraphSnapshot* graph,
   g_return_val_if_fail (edge_data_copy_func != NULL, NULL);
 
   return _g_segraph_snapshot_copy_general (graph,
+                                           NULL,
+                                           node_data_copy_func,
+                                           node_user_data,
+                                           edge_data_copy_func,
+                                           edge_user_data,
+                                           1);
+}
+
+/**
+ * g_segraph_snapshot_copy_deep_parallel:
+ * @graph: a graph to be copied.
+ * @node_data_copy_func: function copying data in nodes.
+ * @node_user_data: data passed to node data copying function.
+ * @edge_data_copy_func: function copying data in edges.
+ * @edge_user_data: data passed to edge data copying function.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Does the same as g_segraph_snapshot_copy_deep(), but data and connections of
+ * nodes and edges are copied by at most @n_threads threads.
+ * @node_data_copy_func and @edge_data_copy_func must be safe to call from many
+ * threads at once.
+ *
+ * Returns: A copy of @graph.
+ */
+GSEGraphSnapshot*
+g_segraph_snapshot_copy_deep_parallel (GSEGraphSnapshot* graph,
+                                       GCopyFunc node_data_copy_func,
+                                       gpointer node_user_data,
+                                       GCopyFunc edge_data_copy_func,
+                                       gpointer edge_user_data,
+                                       guint n_threads)
+{
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->node_array != NULL, NULL);
+  g_return_val_if_fail (graph->edge_array != NULL, NULL);
+  g_return_val_if_fail (node_data_copy_func != NULL, NULL);
+  g_return_val_if_fail (edge_data_copy_func != NULL, NULL);
+
+  return _g_segraph_snapshot_copy_general (graph,
+                                           NULL,
+                                           node_data_copy_func,
+                                           node_user_data,
+                                           edge_data_copy_func,
+                                           edge_user_data,
+                                           n_threads);
+}
+
+/**
+ * g_segraph_snapshot_copy_in_arena:
+ * @graph: a graph to be copied.
+ * @arena: an arena.
+ * @node_data_copy_func: function copying data in nodes or %NULL.
+ * @node_user_data: data passed to node data copying function.
+ * @edge_data_copy_func: function copying data in edges or %NULL.
+ * @edge_user_data: data passed to edge data copying function.
+ *
+ * Does a copy of @graph with memory for nodes and edges taken from @arena. If
+ * a copying function is %NULL, respective data is shared like in
+ * g_segraph_snapshot_copy(), otherwise it is duplicated like in
+ * g_segraph_snapshot_copy_deep(). @graph's members must not be %NULL.
+ *
+ * Returns: A copy of @graph.
+ */
+GSEGraphSnapshot*
+g_segraph_snapshot_copy_in_arena (GSEGraphSnapshot* graph,
+                                  GSEGraphArena* arena,
+                                  GCopyFunc node_data_copy_func,
+                                  gpointer node_user_data,
+                                  GCopyFunc edge_data_copy_func,
+                                  gpointer edge_user_data)
+{
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->node_array != NULL, NULL);
+  g_return_val_if_fail (graph->edge_array != NULL, NULL);
+  g_return_val_if_fail (arena != NULL, NULL);
+
+  return _g_segraph_snapshot_copy_general (graph,
+                                           arena,
                                            node_data_copy_func,
                                            node_user_data,
                                            edge_data_copy_func,
-                                           edge_user_data);
+                                           edge_user_data,
+                                           1);
+}
+
+/**
+ * g_segraph_snapshot_get_ordering:
+ * @graph: a graph.
+ * @ordering: kind of order.
+ *
+ * Computes an order of nodes in @graph, which improves locality of memory
+ * accesses. All ends of edges in @graph have to be in @graph too. @graph's
+ * members must not be %NULL.
+ *
+ * Returns: #GArray of #guint32 indices into @graph's node array, i-th element
+ * being the index of node which goes at position i. Free it with
+ * g_array_free().
+ */
+GArray*
+g_segraph_snapshot_get_ordering (GSEGraphSnapshot* graph,
+                                 GSEGraphOrdering ordering)
+{
+  GSEGraphCsr* csr;
+  GArray* permutation;
+
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->node_array != NULL, NULL);
+  g_return_val_if_fail (graph->edge_array != NULL, NULL);
+
+  csr = g_segraph_csr_new (graph);
+  if (!csr)
+  {
+    return NULL;
+  }
+  permutation = _g_segraph_snapshot_compute_ordering (csr, ordering);
+  g_segraph_csr_free (csr);
+
+  return permutation;
+}
+
+/**
+ * g_segraph_snapshot_reorder:
+ * @graph: a graph to be reordered.
+ * @arena: an arena or %NULL.
+ * @ordering: kind of order.
+ *
+ * Does a copy of @graph with nodes in order computed by
+ * g_segraph_snapshot_get_ordering(). Edges are put in order of their first
+ * appearance in edge arrays of reordered nodes. Nodes and edges of copy are
+ * allocated one after another in those orders, so when @arena is not %NULL,
+ * neighbouring nodes and their edges end up close to each other in memory.
+ * Data is shared like in g_segraph_snapshot_copy(). @graph's members must not
+ * be %NULL.
+ *
+ * Returns: A reordered copy of @graph or %NULL if some ends of edges are not
+ * in @graph.
+ */
+GSEGraphSnapshot*
+g_segraph_snapshot_reorder (GSEGraphSnapshot* graph,
+                            GSEGraphArena* arena,
+                            GSEGraphOrdering ordering)
+{
+  GSEGraphCsr* csr;
+  GSEGraphSnapshot* temp_graph;
+  GSEGraphSnapshot* dup_graph;
+  GArray* permutation;
+  guint8* edges_added;
+  guint iter;
+
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->node_array != NULL, NULL);
+  g_return_val_if_fail (graph->edge_array != NULL, NULL);
+
+  csr = g_segraph_csr_new (graph);
+  if (!csr)
+  {
+    return NULL;
+  }
+  permutation = _g_segraph_snapshot_compute_ordering (csr, ordering);
+
+  temp_graph = _g_segraph_snapshot_new_blank (csr->order,
+                                              csr->size,
+                                              TRUE,
+                                              TRUE);
+  edges_added = g_new0 (guint8, csr->size);
+  for (iter = 0; iter < permutation->len; ++iter)
+  {
+    guint32 index;
+    guint32 iter2;
+
+    index = g_array_index (permutation, guint32, iter);
+    g_ptr_array_add (temp_graph->node_array,
+                     g_ptr_array_index (graph->node_array, index));
+    for (iter2 = csr->offsets[index]; iter2 < csr->offsets[index + 1]; ++iter2)
+    {
+      guint32 edge_index;
+
+      edge_index = csr->edges[iter2];
+      if (!edges_added[edge_index])
+      {
+        edges_added[edge_index] = TRUE;
+        g_ptr_array_add (temp_graph->edge_array,
+                         g_ptr_array_index (graph->edge_array, edge_index));
+      }
+    }
+  }
+  for (iter = 0; iter < csr->size; ++iter)
+  {
+    if (!edges_added[iter])
+    {
+      g_ptr_array_add (temp_graph->edge_array,
+                       g_ptr_array_index (graph->edge_array, iter));
+    }
+  }
+  g_free (edges_added);
+  g_array_free (permutation, TRUE);
+  g_segraph_csr_free (csr);
+
+  dup_graph = _g_segraph_snapshot_copy_general (temp_graph,
+                                                arena,
+                                                NULL,
+                                                NULL,
+                                                NULL,
+                                                NULL,
+                                                1);
+  g_segraph_snapshot_free (temp_graph, FALSE);
+
+  return dup_graph;
 }
 
 /**
@@ -621,6 +710,8 @@ g_segraph_snapshot_free (GSEGraphSnapshot* graph,
     }
   }
 
+  g_segraph_snapshot_drop_node_index (graph);
+  g_segraph_snapshot_drop_edge_index (graph);
   g_slice_free (GSEGraphSnapshot, graph);
 }
 
@@ -628,7 +719,10 @@ g_segraph_snapshot_free (GSEGraphSnapshot* graph,
  * g_segraph_snapshot_get_order:
  * @graph: a graph.
  *
- * Gets @graph's order, that is - number of nodes in graph.
+ * Gets @graph's order, that is - number of nodes in graph. If @graph has no
+ * nodes array, because it was created with
+ * g_segraph_snapshot_new_only_edges(), number of nodes found while creating it
+ * is returned.
  *
  * Returns: number of nodes in graph.
  */
@@ -636,16 +730,22 @@ guint
 g_segraph_snapshot_get_order (GSEGraphSnapshot* graph)
 {
   g_return_val_if_fail (graph != NULL, 0);
-  g_return_val_if_fail (graph->node_array != NULL, 0);
 
-  return graph->node_array->len;
+  if (graph->node_array)
+  {
+    return graph->node_array->len;
+  }
+  return graph->order;
 }
 
 /**
  * g_segraph_snapshot_get_size:
  * @graph: a graph.
  *
- * Gets @graph's size, that is - number of edges in graph.
+ * Gets @graph's size, that is - number of edges in graph. If @graph has no
+ * edges array, because it was created with
+ * g_segraph_snapshot_new_only_nodes(), number of edges found while creating it
+ * is returned.
  *
  * Returns: number of edges in graph.
  */
@@ -653,16 +753,202 @@ guint
 g_segraph_snapshot_get_size (GSEGraphSnapshot* graph)
 {
   g_return_val_if_fail (graph != NULL, 0);
-  g_return_val_if_fail (graph->edge_array != NULL, 0);
 
-  return graph->edge_array->len;
+  if (graph->edge_array)
+  {
+    return graph->edge_array->len;
+  }
+  return graph->size;
 }
 
 /**
- * g_segraph_snapshot_foreach_node:
+ * g_segraph_snapshot_build_node_index:
  * @graph: a graph.
- * @func: the function to call with each element's data.
- * @user_data: data passed to @func.
+ * @hash_func: a function to create a hash value from node's data or %NULL.
+ * @key_equal_func: a function to check two node's data for equality or %NULL.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Builds an index of nodes in @graph by their data, so
+ * g_segraph_snapshot_lookup_node() can find them without iterating the node
+ * array. @hash_func and @key_equal_func have the same meaning as in
+ * g_hash_table_new(), so if they are %NULL, data are compared directly. If
+ * there are many nodes with equal data, the first one in node array is
+ * indexed. If @n_threads is greater than 1, index is built by that many
+ * threads, so @hash_func and @key_equal_func must be safe to call from many
+ * threads at once. Previous node index of @graph, if any, is dropped.
+ *
+ * Graphs created with g_segraph_snapshot_new() already have an index of nodes
+ * comparing data directly, which was used during their construction.
+ *
+ * If node array or data of nodes are changed, index has to be built again.
+ */
+void
+g_segraph_snapshot_build_node_index (GSEGraphSnapshot* graph,
+                                     GHashFunc hash_func,
+                                     GEqualFunc key_equal_func,
+                                     guint n_threads)
+{
+  g_return_if_fail (graph != NULL);
+  g_return_if_fail (graph->node_array != NULL);
+
+  g_segraph_snapshot_drop_node_index (graph);
+  graph->node_index =
+    _g_sgraph_data_index_new (graph->node_array,
+                              _g_segraph_snapshot_get_node_data,
+                              hash_func,
+                              key_equal_func,
+                              n_threads);
+}
+
+/**
+ * g_segraph_snapshot_drop_node_index:
+ * @graph: a graph.
+ *
+ * Frees an index of @graph's nodes, if it has one.
+ */
+void
+g_segraph_snapshot_drop_node_index (GSEGraphSnapshot* graph)
+{
+  g_return_if_fail (graph != NULL);
+
+  if (graph->node_index)
+  {
+    _g_sgraph_data_index_free (graph->node_index);
+    graph->node_index = NULL;
+  }
+}
+
+/**
+ * g_segraph_snapshot_has_node_index:
+ * @graph: a graph.
+ *
+ * Checks whether @graph has an index of its nodes.
+ *
+ * Returns: %TRUE if @graph has an index of nodes, otherwise %FALSE.
+ */
+gboolean
+g_segraph_snapshot_has_node_index (GSEGraphSnapshot* graph)
+{
+  g_return_val_if_fail (graph != NULL, FALSE);
+
+  return (graph->node_index != NULL);
+}
+
+/**
+ * g_segraph_snapshot_lookup_node:
+ * @graph: a graph with an index of nodes.
+ * @data: data of a node.
+ *
+ * Finds a node holding @data using an index of @graph. See
+ * g_segraph_snapshot_build_node_index().
+ *
+ * Returns: found #GSEGraphNode or %NULL if there was no such node.
+ */
+GSEGraphNode*
+g_segraph_snapshot_lookup_node (GSEGraphSnapshot* graph,
+                                gconstpointer data)
+{
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->node_index != NULL, NULL);
+
+  return _g_sgraph_data_index_lookup (graph->node_index, data);
+}
+
+/**
+ * g_segraph_snapshot_build_edge_index:
+ * @graph: a graph.
+ * @hash_func: a function to create a hash value from edge's data or %NULL.
+ * @key_equal_func: a function to check two edge's data for equality or %NULL.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Builds an index of edges in @graph by their data, so
+ * g_segraph_snapshot_lookup_edge() can find them without iterating the edge
+ * array. @hash_func and @key_equal_func have the same meaning as in
+ * g_hash_table_new(), so if they are %NULL, data are compared directly. If
+ * there are many edges with equal data, the first one in edge array is
+ * indexed. If @n_threads is greater than 1, index is built by that many
+ * threads, so @hash_func and @key_equal_func must be safe to call from many
+ * threads at once. Previous edge index of @graph, if any, is dropped.
+ *
+ * If edge array or data of edges are changed, index has to be built again.
+ */
+void
+g_segraph_snapshot_build_edge_index (GSEGraphSnapshot* graph,
+                                     GHashFunc hash_func,
+                                     GEqualFunc key_equal_func,
+                                     guint n_threads)
+{
+  g_return_if_fail (graph != NULL);
+  g_return_if_fail (graph->edge_array != NULL);
+
+  g_segraph_snapshot_drop_edge_index (graph);
+  graph->edge_index =
+    _g_sgraph_data_index_new (graph->edge_array,
+                              _g_segraph_snapshot_get_edge_data,
+                              hash_func,
+                              key_equal_func,
+                              n_threads);
+}
+
+/**
+ * g_segraph_snapshot_drop_edge_index:
+ * @graph: a graph.
+ *
+ * Frees an index of @graph's edges, if it has one.
+ */
+void
+g_segraph_snapshot_drop_edge_index (GSEGraphSnapshot* graph)
+{
+  g_return_if_fail (graph != NULL);
+
+  if (graph->edge_index)
+  {
+    _g_sgraph_data_index_free (graph->edge_index);
+    graph->edge_index = NULL;
+  }
+}
+
+/**
+ * g_segraph_snapshot_has_edge_index:
+ * @graph: a graph.
+ *
+ * Checks whether @graph has an index of its edges.
+ *
+ * Returns: %TRUE if @graph has an index of edges, otherwise %FALSE.
+ */
+gboolean
+g_segraph_snapshot_has_edge_index (GSEGraphSnapshot* graph)
+{
+  g_return_val_if_fail (graph != NULL, FALSE);
+
+  return (graph->edge_index != NULL);
+}
+
+/**
+ * g_segraph_snapshot_lookup_edge:
+ * @graph: a graph with an index of edges.
+ * @data: data of an edge.
+ *
+ * Finds an edge holding @data using an index of @graph. See
+ * g_segraph_snapshot_build_edge_index().
+ *
+ * Returns: found #GSEGraphEdge or %NULL if there was no such edge.
+ */
+GSEGraphEdge*
+g_segraph_snapshot_lookup_edge (GSEGraphSnapshot* graph,
+                                gconstpointer data)
+{
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->edge_index != NULL, NULL);
+
+  return _g_sgraph_data_index_lookup (graph->edge_index, data);
+}
+
+/**
+ * g_segraph_snapshot_foreach_node:
+ * @graph: a graph.
+ * @func: the function to call with each element's data.
+ * @user_data: data passed to @func.
  *
  * Calls @func for each node's data in @graph.
  */
@@ -782,141 +1068,736 @@ g_segraph_snapshot_find_edge_custom (GSEGraphSnapshot* graph,
   return NULL;
 }
 
-/* static function definitions. */
+/**
+ * g_segraph_snapshot_foreach_node_parallel:
+ * @graph: a graph.
+ * @func: the function to call with each node.
+ * @user_data: data passed to @func.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Calls @func for each node in @graph, like
+ * g_segraph_snapshot_foreach_node() does, but spreads the calls over at most
+ * @n_threads threads. The node array is split into chunks and idle threads
+ * take chunks left by busy ones. Calls happen in no particular order and
+ * @func must be safe to call from many threads at once. This function
+ * returns after all calls finished.
+ *
+ * If threads are not supported, that is - g_thread_init() was not called with
+ * older GLib, @func is called sequentially.
+ */
+void
+g_segraph_snapshot_foreach_node_parallel (GSEGraphSnapshot* graph,
+                                          GFunc func,
+                                          gpointer user_data,
+                                          guint n_threads)
+{
+  g_return_if_fail (graph != NULL);
+  g_return_if_fail (graph->node_array != NULL);
+  g_return_if_fail (func != NULL);
+
+  _g_sgraph_parallel_foreach (graph->node_array, func, user_data, n_threads);
+}
 
 /**
- * _g_segraph_snapshot_append_DFS:
- * @node: a node, which will be put into arrays with its edges.
- * @node_array: array of all nodes in graph.
- * @visited_nodes: a map of already visited nodes.
- * @edge_array: array of all edges in graph.
- * @visited_edges: a map of already visited edges.
- *
- * Checks all nodes and edges and put them into arrays using depth first search
- * algorithm.
+ * g_segraph_snapshot_foreach_edge_parallel:
+ * @graph: a graph.
+ * @func: the function to call with each edge.
+ * @user_data: data passed to @func.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Calls @func for each edge in @graph, like
+ * g_segraph_snapshot_foreach_edge() does, but spreads the calls over at most
+ * @n_threads threads. The edge array is split into chunks and idle threads
+ * take chunks left by busy ones. Calls happen in no particular order and
+ * @func must be safe to call from many threads at once. This function
+ * returns after all calls finished.
+ *
+ * If threads are not supported, that is - g_thread_init() was not called with
+ * older GLib, @func is called sequentially.
  */
-static void
-_g_segraph_snapshot_append_DFS (GSEGraphNode* node,
-                                GPtrArray* node_array,
-                                GHashTable* visited_nodes,
-                                GPtrArray* edge_array,
-                                GHashTable* visited_edges)
+void
+g_segraph_snapshot_foreach_edge_parallel (GSEGraphSnapshot* graph,
+                                          GFunc func,
+                                          gpointer user_data,
+                                          guint n_threads)
+{
+  g_return_if_fail (graph != NULL);
+  g_return_if_fail (graph->edge_array != NULL);
+  g_return_if_fail (func != NULL);
+
+  _g_sgraph_parallel_foreach (graph->edge_array, func, user_data, n_threads);
+}
+
+/**
+ * g_segraph_snapshot_find_node_custom_parallel:
+ * @graph: a graph.
+ * @user_data: user data passed to @func.
+ * @func: the function to call for each node.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Finds first element in a @graph, like
+ * g_segraph_snapshot_find_node_custom() does, but spreads the calls of
+ * @func over at most @n_threads threads. When a match is found, parts of the
+ * node array lying after it are not searched anymore. Returned node is
+ * always the one with lowest index in the array, so the result is the same as
+ * the sequential version gives. @func must be safe to call from many threads
+ * at once.
+ *
+ * Returns: found #GSEGraphNode or %NULL if there was no such node.
+ */
+GSEGraphNode*
+g_segraph_snapshot_find_node_custom_parallel (GSEGraphSnapshot* graph,
+                                              gpointer user_data,
+                                              GEqualFunc func,
+                                              guint n_threads)
+{
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->node_array != NULL, NULL);
+  g_return_val_if_fail (func != NULL, NULL);
+
+  return _g_sgraph_parallel_find (graph->node_array,
+                                  func,
+                                  user_data,
+                                  n_threads);
+}
+
+/**
+ * g_segraph_snapshot_find_edge_custom_parallel:
+ * @graph: a graph.
+ * @user_data: user data passed to @func.
+ * @func: the function to call for each edge.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Finds first element in a @graph, like
+ * g_segraph_snapshot_find_edge_custom() does, but spreads the calls of
+ * @func over at most @n_threads threads. When a match is found, parts of the
+ * edge array lying after it are not searched anymore. Returned edge is
+ * always the one with lowest index in the array, so the result is the same as
+ * the sequential version gives. @func must be safe to call from many threads
+ * at once.
+ *
+ * Returns: found #GSEGraphEdge or %NULL if there was no such edge.
+ */
+GSEGraphEdge*
+g_segraph_snapshot_find_edge_custom_parallel (GSEGraphSnapshot* graph,
+                                              gpointer user_data,
+                                              GEqualFunc func,
+                                              guint n_threads)
+{
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->edge_array != NULL, NULL);
+  g_return_val_if_fail (func != NULL, NULL);
+
+  return _g_sgraph_parallel_find (graph->edge_array,
+                                  func,
+                                  user_data,
+                                  n_threads);
+}
+
+/**
+ * g_segraph_snapshot_label_components:
+ * @nodes: array of distinct nodes, for example node array of a graph.
+ * @n_components: return location for number of components or %NULL.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Finds connected components of @nodes using at most @n_threads threads.
+ * Only edges between nodes in @nodes are taken into account, edges leading
+ * outside of it are ignored. Each thread joins nodes with their neighbours in
+ * a disjoint-set forest, which is updated with atomic operations instead of
+ * locks. Components are labelled with numbers from 0 to number of components
+ * minus 1, in order of their first nodes in @nodes.
+ *
+ * If threads are not supported, that is - g_thread_init() was not called with
+ * older GLib, components are found sequentially.
+ *
+ * Returns: newly created #GArray of #guint32 labels, i-th element being the
+ * label of i-th node in @nodes. Free it with g_array_free().
+ */
+GArray*
+g_segraph_snapshot_label_components (GPtrArray* nodes,
+                                     guint* n_components,
+                                     guint n_threads)
+{
+  g_return_val_if_fail (nodes != NULL, NULL);
+  g_return_val_if_fail (nodes->len < G_MAXINT, NULL);
+
+  return _g_segraph_snapshot_label_general (nodes,
+                                            n_components,
+                                            n_threads,
+                                            NULL);
+}
+
+/**
+ * g_segraph_snapshot_split_components:
+ * @nodes: array of distinct nodes, for example node array of a graph.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Splits @nodes into connected components found by
+ * g_segraph_snapshot_label_components(). Nodes in each component keep their
+ * order from @nodes. Edge array of each component holds all edges of its
+ * nodes, including half-edges, loops and edges leading outside of @nodes,
+ * each of them once. Wrappers are created, nodes and edges are not copied.
+ *
+ * Returns: newly created #GPtrArray of #GSEGraphSnapshot<!-- -->s, one for
+ * each component, in order of their first nodes in @nodes.
+ */
+GPtrArray*
+g_segraph_snapshot_split_components (GPtrArray* nodes,
+                                     guint n_threads)
 {
+  GPtrArray* graphs;
+  GArray* labels;
+
+  g_return_val_if_fail (nodes != NULL, NULL);
+  g_return_val_if_fail (nodes->len < G_MAXINT, NULL);
+
+  labels = _g_segraph_snapshot_label_general (nodes, NULL, n_threads, &graphs);
+  g_array_free (labels, TRUE);
+
+  return graphs;
+}
+
+/**
+ * g_segraph_snapshot_find_bridges:
+ * @graph: a graph.
+ *
+ * Finds all bridges of @graph in one depth-first search, so it takes time
+ * linear in order and size of @graph, instead of one search for each edge as
+ * in g_segraph_edge_is_bridge(). Search is iterative, so it works for graphs
+ * of any depth. Each node gets a discovery time and a lowest discovery time
+ * reachable from its subtree without using the edge it was reached by. A tree
+ * edge is a bridge if the subtree below it cannot reach higher than that.
+ *
+ * Only the very edge a node was reached by is skipped, not all edges to its
+ * parent, so an edge being one of many edges connecting the same nodes is
+ * never a bridge. Loops are never bridges and half-edges are not bridges,
+ * just like g_segraph_edge_is_bridge() says. Edges leading outside of node
+ * array are ignored and only edges from edge array are returned.
+ *
+ * Returns: newly created #GPtrArray of bridges in order of edge array. Free
+ * it with g_ptr_array_free().
+ */
+GPtrArray*
+g_segraph_snapshot_find_bridges (GSEGraphSnapshot* graph)
+{
+  GSGraphPositions positions;
+  GPtrArray* bridges;
+  GArray* stack;
+  guint32* discovery;
+  guint32* low;
+  gboolean* is_bridge;
+  guint32 time;
+  guint node_count;
+  guint edge_count;
   guint iter;
-  GPtrArray* n_e;
 
-  if (g_hash_table_lookup_extended (visited_nodes, node, NULL, NULL))
-  {
-    return;
-  }
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->node_array != NULL, NULL);
+  g_return_val_if_fail (graph->edge_array != NULL, NULL);
 
-  g_hash_table_insert (visited_nodes, node, NULL);
-  if (node_array)
+  node_count = graph->node_array->len;
+  edge_count = graph->edge_array->len;
+  _g_sgraph_positions_init (&positions,
+                            G_SGRAPH_VISITED_DOMAIN_SEGRAPH,
+                            node_count + edge_count);
+  for (iter = 0; iter < node_count; ++iter)
   {
-    g_ptr_array_add (node_array, node);
+    GSEGraphNode* node;
+
+    node = g_ptr_array_index (graph->node_array, iter);
+    _g_sgraph_positions_set (&positions, node, &node->visit_mark, iter);
   }
-  n_e = node->edges;
-  for (iter = 0; iter < n_e->len; ++iter)
+  for (iter = 0; iter < edge_count; ++iter)
   {
-    GSEGraphNode* other_node;
     GSEGraphEdge* edge;
 
-    edge = g_ptr_array_index (n_e, iter);
-    if (g_hash_table_lookup_extended (visited_edges, edge, NULL, NULL))
+    edge = g_ptr_array_index (graph->edge_array, iter);
+    _g_sgraph_positions_set (&positions,
+                             edge,
+                             &edge->visit_mark,
+                             node_count + iter);
+  }
+  _g_sgraph_positions_seal (&positions);
+
+  discovery = g_new0 (guint32, node_count);
+  low = g_new (guint32, node_count);
+  is_bridge = g_new0 (gboolean, edge_count);
+  stack = g_array_new (FALSE, FALSE, sizeof (GSEGraphSnapshotFrame));
+  time = 0;
+
+  for (iter = 0; iter < node_count; ++iter)
+  {
+    if (discovery[iter])
     {
       continue;
     }
-    g_hash_table_insert (visited_edges, edge, NULL);
-    if (edge_array)
+    _g_segraph_snapshot_push_frame (stack, discovery, low, &time, iter, NULL);
+    while (stack->len)
     {
-      g_ptr_array_add (edge_array, edge);
+      GSEGraphSnapshotFrame* frame;
+      GSEGraphNode* node;
+
+      frame = &g_array_index (stack, GSEGraphSnapshotFrame, stack->len - 1);
+      node = g_ptr_array_index (graph->node_array, frame->index);
+      if (frame->position < node->edges->len)
+      {
+        GSEGraphEdge* edge;
+        GSEGraphNode* neighbour;
+        guint position;
+
+        edge = g_ptr_array_index (node->edges, frame->position);
+        ++frame->position;
+        neighbour = (edge->first == node) ? edge->second : edge->first;
+        if ((edge == frame->edge) || !neighbour || (neighbour == node))
+        {
+          continue;
+        }
+        position = _g_sgraph_positions_get (&positions,
+                                            neighbour,
+                                            &neighbour->visit_mark);
+        if (position == G_MAXUINT)
+        {
+          continue;
+        }
+        if (discovery[position])
+        {
+          low[frame->index] = MIN (low[frame->index], discovery[position]);
+        }
+        else
+        {
+          /* frame is invalid after pushing. */
+          _g_segraph_snapshot_push_frame (stack,
+                                          discovery,
+                                          low,
+                                          &time,
+                                          position,
+                                          edge);
+        }
+      }
+      else
+      {
+        guint index;
+        GSEGraphEdge* edge;
+
+        index = frame->index;
+        edge = frame->edge;
+        g_array_set_size (stack, stack->len - 1);
+        if (stack->len)
+        {
+          guint parent;
+
+          parent = g_array_index (stack,
+                                  GSEGraphSnapshotFrame,
+                                  stack->len - 1).index;
+          low[parent] = MIN (low[parent], low[index]);
+          if (low[index] > discovery[parent])
+          {
+            guint position;
+
+            position = _g_sgraph_positions_get (&positions,
+                                                edge,
+                                                &edge->visit_mark);
+            if (position != G_MAXUINT)
+            {
+              is_bridge[position - node_count] = TRUE;
+            }
+          }
+        }
+      }
     }
-    other_node = g_segraph_edge_get_node (edge, node);
-    if (!other_node)
+  }
+  _g_sgraph_positions_clear (&positions);
+
+  bridges = g_ptr_array_new ();
+  for (iter = 0; iter < edge_count; ++iter)
+  {
+    if (is_bridge[iter])
     {
-      continue;
+      g_ptr_array_add (bridges, g_ptr_array_index (graph->edge_array, iter));
     }
-    _g_segraph_snapshot_append_DFS (other_node,
-                                    node_array,
-                                    visited_nodes,
-                                    edge_array,
-                                    visited_edges);
   }
+
+  g_array_free (stack, TRUE);
+  g_free (is_bridge);
+  g_free (low);
+  g_free (discovery);
+
+  return bridges;
 }
 
 /**
- * _g_segraph_snapshot_append_BFS:
- * @node: a node, which will be put into arrays with its edges.
- * @node_array: array of all nodes in graph.
- * @visited_nodes: a map of already visited nodes.
- * @edge_array: array of all edges in graph.
- * @visited_edges: a map of already visited edges.
- *
- * Checks all nodes and edges and put them into arrays using breadth first
- * search algorithm.
+ * g_segraph_snapshot_find_blocks:
+ * @graph: a graph.
+ * @articulation_points: return location for articulation points or %NULL.
+ * @edge_blocks: return location for blocks of edges or %NULL.
+ *
+ * Finds biconnected blocks and articulation points of @graph in one
+ * depth-first search, so it takes time linear in order and size of @graph and
+ * @graph is not changed. Search is iterative, so it works for graphs of any
+ * depth. An articulation point is a node, which removal leaves more connected
+ * components. A block is a maximal set of nodes, which stays connected after
+ * removing any one of its nodes. Blocks can share only articulation points
+ * and a node without neighbours is a block by itself. Many edges connecting
+ * the same nodes are all in the same block, loops and half-edges do not
+ * connect anything and edges leading outside of node array are ignored.
+ *
+ * If @articulation_points is not %NULL, it is set to a newly created #GArray
+ * of #guint32 indices of articulation points in node array, in ascending
+ * order. If @edge_blocks is not %NULL, it is set to a newly created #GArray
+ * of #guint32 indices of blocks, i-th element being the block of i-th edge in
+ * edge array or %G_MAXUINT32 if the edge is a loop, a half-edge or it leads
+ * outside of node array. Free them with g_array_free().
+ *
+ * Returns: newly created #GPtrArray of blocks, each being #GArray of #guint32
+ * indices of its nodes in node array, in no particular order. Free each block
+ * with g_array_free() and the array with g_ptr_array_free().
  */
-static void
-_g_segraph_snapshot_append_BFS (GSEGraphNode* node,
-                                GPtrArray* node_array,
-                                GHashTable* visited_nodes,
-                                GPtrArray* edge_array,
-                                GHashTable* visited_edges)
+GPtrArray*
+g_segraph_snapshot_find_blocks (GSEGraphSnapshot* graph,
+                                GArray** articulation_points,
+                                GArray** edge_blocks)
 {
-  GQueue* queue;
+  GSGraphPositions positions;
+  GSGraphBiconnected* biconnected;
+  GArray* stack;
+  guint node_count;
+  guint iter;
+
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->node_array != NULL, NULL);
+  g_return_val_if_fail (edge_blocks == NULL || graph->edge_array != NULL,
+                        NULL);
+
+  node_count = graph->node_array->len;
+  _g_sgraph_positions_init (&positions,
+                            G_SGRAPH_VISITED_DOMAIN_SEGRAPH,
+                            node_count);
+  for (iter = 0; iter < node_count; ++iter)
+  {
+    GSEGraphNode* node;
 
-  queue = g_queue_new ();
+    node = g_ptr_array_index (graph->node_array, iter);
+    _g_sgraph_positions_set (&positions, node, &node->visit_mark, iter);
+  }
+  _g_sgraph_positions_seal (&positions);
 
-  g_hash_table_insert (visited_nodes, node, NULL);
-  g_queue_push_tail (queue, node);
-  if (node_array)
+  biconnected = _g_sgraph_biconnected_new (node_count);
+  stack = g_array_new (FALSE, FALSE, sizeof (GSEGraphSnapshotFrame));
+  for (iter = 0; iter < node_count; ++iter)
   {
-    g_ptr_array_add (node_array, node);
+    GSEGraphSnapshotFrame root;
+
+    if (!_g_sgraph_biconnected_start (biconnected, iter))
+    {
+      continue;
+    }
+    root.index = iter;
+    root.edge = NULL;
+    root.position = 0;
+    g_array_append_val (stack, root);
+    while (stack->len)
+    {
+      GSEGraphSnapshotFrame* frame;
+      GSEGraphNode* node;
+
+      frame = &g_array_index (stack, GSEGraphSnapshotFrame, stack->len - 1);
+      node = g_ptr_array_index (graph->node_array, frame->index);
+      if (frame->position < node->edges->len)
+      {
+        GSEGraphEdge* edge;
+        GSEGraphNode* neighbour;
+        GSEGraphSnapshotFrame child;
+
+        edge = g_ptr_array_index (node->edges, frame->position);
+        ++frame->position;
+        neighbour = (edge->first == node) ? edge->second : edge->first;
+        /* only the edge node was reached by is skipped, so other edges to
+         * its parent are back edges. */
+        if ((edge == frame->edge) || !neighbour || (neighbour == node))
+        {
+          continue;
+        }
+        child.index = _g_sgraph_positions_get (&positions,
+                                               neighbour,
+                                               &neighbour->visit_mark);
+        if (child.index == G_MAXUINT)
+        {
+          continue;
+        }
+        if (_g_sgraph_biconnected_reach (biconnected,
+                                         frame->index,
+                                         child.index))
+        {
+          child.edge = edge;
+          child.position = 0;
+          g_array_append_val (stack, child);
+        }
+      }
+      else
+      {
+        guint index;
+
+        index = frame->index;
+        g_array_set_size (stack, stack->len - 1);
+        if (stack->len)
+        {
+          _g_sgraph_biconnected_finish (biconnected,
+                                        g_array_index (stack,
+                                                       GSEGraphSnapshotFrame,
+                                                       stack->len - 1).index,
+                                        index);
+        }
+        else
+        {
+          _g_sgraph_biconnected_finish_root (biconnected, index);
+        }
+      }
+    }
   }
+  g_array_free (stack, TRUE);
 
-  while (!g_queue_is_empty (queue))
+  if (edge_blocks)
   {
-    GSEGraphNode* temp_node;
-    guint iter;
+    *edge_blocks = g_array_sized_new (FALSE,
+                                      FALSE,
+                                      sizeof (guint32),
+                                      graph->edge_array->len);
+    for (iter = 0; iter < graph->edge_array->len; ++iter)
+    {
+      GSEGraphEdge* edge;
+      guint first;
+      guint second;
+      guint32 label;
 
-    temp_node = g_queue_pop_head (queue);
+      edge = g_ptr_array_index (graph->edge_array, iter);
+      first = G_MAXUINT;
+      second = G_MAXUINT;
+      if (edge->first && edge->second && (edge->first != edge->second))
+      {
+        first = _g_sgraph_positions_get (&positions,
+                                         edge->first,
+                                         &edge->first->visit_mark);
+        second = _g_sgraph_positions_get (&positions,
+                                          edge->second,
+                                          &edge->second->visit_mark);
+      }
+      if ((first == G_MAXUINT) || (second == G_MAXUINT))
+      {
+        label = G_MAXUINT32;
+      }
+      /* edge is in the block its later discovered end was popped into. */
+      else if (biconnected->discovery[first] > biconnected->discovery[second])
+      {
+        label = biconnected->labels[first];
+      }
+      else
+      {
+        label = biconnected->labels[second];
+      }
+      g_array_append_val (*edge_blocks, label);
+    }
+  }
+  _g_sgraph_positions_clear (&positions);
+
+  return _g_sgraph_biconnected_free (biconnected, articulation_points);
+}
+
+/* static function definitions. */
+
+/**
+ * _g_segraph_snapshot_new_general:
+ * @arena: an arena or %NULL.
+ * @data_triplets: array of data triplets.
+ * @count: length of @data_triplets.
+ *
+ * Creates a graph from passed data triplets. If @arena is not %NULL, memory for
+ * nodes and edges is taken from it. See g_segraph_snapshot_new() for details.
+ *
+ * Returns: array of newly created separate graphs or %NULL if no nodes were
+ * created.
+ */
+static GPtrArray*
+_g_segraph_snapshot_new_general (GSEGraphArena* arena,
+                                 GSEGraphDataTriplet** data_triplets,
+                                 guint count)
+{
+  GPtrArray* separate_graphs;
+  GPtrArray* nodes;
+  GPtrArray* edges;
+  GArray* edge_indices;
+  GHashTable* data_to_indices;
+  GSGraphDisjointSet* components;
+  GSEGraphSnapshot** roots_to_graphs;
+  GSEGraphSnapshot* largest_graph;
+  guint largest_order;
+  guint iter;
 
-    for (iter = 0; iter < temp_node->edges->len; ++iter)
+  if (!count)
+  {
+    while (data_triplets[count])
+    {
+      ++count;
+    }
+  }
+
+  if (!count)
+  {
+    return NULL;
+  }
+
+  nodes = g_ptr_array_new ();
+  edges = g_ptr_array_sized_new (count);
+  edge_indices = g_array_sized_new (FALSE, FALSE, sizeof (guint), count);
+  data_to_indices = g_hash_table_new (NULL, NULL);
+  components = _g_sgraph_disjoint_set_new (0);
+  for (iter = 0; iter < count; ++iter)
+  {
+    GSEGraphDataTriplet* data_triplet;
+
+    data_triplet = data_triplets[iter];
+    if (g_segraph_data_triplet_is_valid (data_triplet))
     {
+      GSEGraphNode* first_node;
+      GSEGraphNode* second_node;
       GSEGraphEdge* edge;
-      GSEGraphNode* other_node;
+      guint first_index;
+      guint second_index;
+
+      first_node = NULL;
+      second_node = NULL;
+      first_index = 0;
+      second_index = 0;
+      if (data_triplet->first)
+      {
+        first_index = _g_segraph_snapshot_get_node_index (data_triplet->first,
+                                                          data_to_indices,
+                                                          nodes,
+                                                          components,
+                                                          arena);
+        first_node = g_ptr_array_index (nodes, first_index);
+      }
 
-      edge = g_ptr_array_index (temp_node->edges, iter);
+      if (data_triplet->second)
+      {
+        second_index = _g_segraph_snapshot_get_node_index (data_triplet->second,
+                                                           data_to_indices,
+                                                           nodes,
+                                                           components,
+                                                           arena);
+        second_node = g_ptr_array_index (nodes, second_index);
+      }
 
-      if (g_hash_table_lookup_extended (visited_edges, edge, NULL, NULL))
+      /* half-edges and loops do not join separate graphs. */
+      if (!first_node)
       {
-        continue;
+        first_index = second_index;
       }
-      g_hash_table_insert (visited_edges, edge, NULL);
-      if (edge_array)
+      else if (second_node && (first_node != second_node))
       {
-        g_ptr_array_add (edge_array, edge);
+        _g_sgraph_disjoint_set_union (components, first_index, second_index);
       }
 
-      other_node = g_segraph_edge_get_node (edge, temp_node);
-      if (!other_node)
+      if (arena)
+      {
+        edge = g_segraph_edge_new_in_arena (arena, data_triplet->edge);
+      }
+      else
       {
-        continue;
+        edge = g_segraph_edge_new (data_triplet->edge);
       }
-      if (g_hash_table_lookup_extended (visited_nodes, other_node, NULL, NULL))
+      g_segraph_edge_connect_nodes (edge, first_node, second_node);
+      g_ptr_array_add (edges, edge);
+      g_array_append_val (edge_indices, first_index);
+    }
+  }
+
+  if (!nodes->len)
+  {
+    g_hash_table_unref (data_to_indices);
+    g_ptr_array_free (nodes, TRUE);
+    g_ptr_array_free (edges, TRUE);
+    g_array_free (edge_indices, TRUE);
+    _g_sgraph_disjoint_set_free (components);
+    return NULL;
+  }
+
+  /* all components are known now, so each node and edge is put into its
+   * graph. */
+  separate_graphs = g_ptr_array_new ();
+  roots_to_graphs = g_new0 (GSEGraphSnapshot*, nodes->len);
+  largest_graph = NULL;
+  largest_order = 0;
+  for (iter = 0; iter < nodes->len; ++iter)
+  {
+    guint root;
+    GSEGraphSnapshot* graph;
+
+    root = _g_sgraph_disjoint_set_find (components, iter);
+    graph = roots_to_graphs[root];
+    if (!graph)
+    {
+      guint order;
+
+      order = _g_sgraph_disjoint_set_get_set_size (components, root);
+      graph = _g_segraph_snapshot_new_blank (order, order, TRUE, TRUE);
+      roots_to_graphs[root] = graph;
+      g_ptr_array_add (separate_graphs, graph);
+      if (order > largest_order)
       {
-        continue;
+        largest_graph = graph;
+        largest_order = order;
       }
+    }
+    g_ptr_array_add (graph->node_array, g_ptr_array_index (nodes, iter));
+  }
+
+  /* map of data used during construction becomes a node index of the largest
+   * graph. Entries of other graphs are moved to their own indices. */
+  largest_graph->node_index =
+    _g_sgraph_data_index_new_from_table (data_to_indices);
+  for (iter = 0; iter < nodes->len; ++iter)
+  {
+    GSEGraphNode* node;
+    GSEGraphSnapshot* graph;
 
-      g_hash_table_insert (visited_nodes, other_node, NULL);
-      g_queue_push_tail (queue, other_node);
-      if (node_array)
+    node = g_ptr_array_index (nodes, iter);
+    graph = roots_to_graphs[_g_sgraph_disjoint_set_find (components, iter)];
+    if (graph == largest_graph)
+    {
+      g_hash_table_insert (data_to_indices, node->data, node);
+    }
+    else
+    {
+      g_hash_table_remove (data_to_indices, node->data);
+      if (!graph->node_index)
       {
-        g_ptr_array_add (node_array, other_node);
+        GHashTable* table;
+
+        table = g_hash_table_new (NULL, NULL);
+        graph->node_index = _g_sgraph_data_index_new_from_table (table);
       }
+      _g_sgraph_data_index_insert (graph->node_index, node->data, node);
     }
   }
 
-  g_queue_free (queue);
+  for (iter = 0; iter < edges->len; ++iter)
+  {
+    guint root;
+
+    root = _g_sgraph_disjoint_set_find (components,
+                                        g_array_index (edge_indices,
+                                                       guint,
+                                                       iter));
+    g_ptr_array_add (roots_to_graphs[root]->edge_array,
+                     g_ptr_array_index (edges, iter));
+  }
+
+  g_free (roots_to_graphs);
+  g_ptr_array_free (nodes, TRUE);
+  g_ptr_array_free (edges, TRUE);
+  g_array_free (edge_indices, TRUE);
+  _g_sgraph_disjoint_set_free (components);
+  return separate_graphs;
 }
 
 /**
@@ -937,48 +1818,37 @@ _g_segraph_snapshot_new_from_node_general (GSEGraphNode* node,
                                            gboolean put_edges,
                                            GSEGraphTraverseType traverse_type)
 {
-  typedef void (*GraphSearchFunc) (GSEGraphNode* node,
-                                   GPtrArray* node_array,
-                                   GHashTable* visited_nodes,
-                                   GPtrArray* edge_array,
-                                   GHashTable* visited_edges);
-
   GSEGraphSnapshot* graph;
-  GHashTable* visited_nodes;
-  GHashTable* visited_edges;
-  GraphSearchFunc gsfunc;
+  GSEGraphIter iter;
+  GSEGraphNode* other_node;
+  GSEGraphEdge* edge;
+
+  g_return_val_if_fail ((traverse_type == G_SEGRAPH_TRAVERSE_BFS) ||
+                        (traverse_type == G_SEGRAPH_TRAVERSE_DFS), NULL);
+
+  graph = _g_segraph_snapshot_new_blank (0, 0, put_nodes, put_edges);
 
-  switch (traverse_type)
+  _g_segraph_iter_init (&iter, node, traverse_type, TRUE);
+  while (g_segraph_iter_next (&iter, &other_node, &edge))
   {
-    case G_SEGRAPH_TRAVERSE_BFS:
-    {
-      gsfunc = _g_segraph_snapshot_append_BFS;
-      break;
-    }
-    case G_SEGRAPH_TRAVERSE_DFS:
+    if (edge)
     {
-      gsfunc = _g_segraph_snapshot_append_DFS;
-      break;
+      if (put_edges)
+      {
+        g_ptr_array_add (graph->edge_array, edge);
+      }
+      ++graph->size;
     }
-    default:
+    if (other_node)
     {
-      g_return_val_if_reached (NULL);
+      if (put_nodes)
+      {
+        g_ptr_array_add (graph->node_array, other_node);
+      }
+      ++graph->order;
     }
   }
-
-  graph = _g_segraph_snapshot_new_blank (0, 0, put_nodes, put_edges);
-
-  visited_nodes = g_hash_table_new (NULL, NULL);
-  visited_edges = g_hash_table_new (NULL, NULL);
-
-  (*gsfunc) (node,
-             graph->node_array,
-             visited_nodes,
-             graph->edge_array,
-             visited_edges);
-
-  g_hash_table_unref (visited_nodes);
-  g_hash_table_unref (visited_edges);
+  _g_segraph_iter_clear (&iter);
 
   return graph;
 }
@@ -1025,6 +1895,7 @@ _g_segraph_snapshot_new_from_edge_general (GSEGraphEdge* edge,
     {
       g_ptr_array_add (graph->edge_array, edge);
     }
+    graph->size = 1;
 
     return graph;
   }
@@ -1033,54 +1904,70 @@ _g_segraph_snapshot_new_from_edge_general (GSEGraphEdge* edge,
 /**
  * _g_segraph_snapshot_copy_general:
  * @graph: a graph to be copied.
+ * @arena: an arena for nodes and edges of copy or %NULL.
  * @node_data_copy_func: function copying data in nodes.
  * @node_user_data: data passed to node data copying function.
  * @edge_data_copy_func: function copying data in edges.
  * @edge_user_data: data passed to edge data copying function.
+ * @n_threads: number of threads to use, including the calling one.
  *
  * Does a copy of @graph. Each node data in @graph copy and each edge data
  * are duplicated using passed functions. If @node_data_copy_func or
- * @edge_data_copy_func are NULL, then shallow copy of data is done.
+ * @edge_data_copy_func are NULL, then shallow copy of data is done. If @arena
+ * is not %NULL, memory for nodes and edges is taken from it.
+ *
+ * Every node and edge gets a dense position first, so ends of edges and edges
+ * of nodes are remapped with an array lookup. Nodes and edges are allocated
+ * in the calling thread, then they are filled by @n_threads threads.
  *
  * Returns: A copy of @graph.
  */
 static GSEGraphSnapshot*
 _g_segraph_snapshot_copy_general (GSEGraphSnapshot* graph,
+                                  GSEGraphArena* arena,
                                   GCopyFunc node_data_copy_func,
                                   gpointer node_user_data,
                                   GCopyFunc edge_data_copy_func,
-                                  gpointer edge_user_data)
+                                  gpointer edge_user_data,
+                                  guint n_threads)
 {
-  GHashTable* nodes_to_dups;
-  GHashTable* edges_to_dups;
+  GSEGraphSnapshotCopy copy;
   GSEGraphSnapshot* dup_graph;
+  guint node_count;
   guint iter;
 
-  nodes_to_dups = g_hash_table_new (NULL, NULL);
-  edges_to_dups = g_hash_table_new (NULL, NULL);
-  dup_graph = _g_segraph_snapshot_new_blank (graph->node_array->len,
+  node_count = graph->node_array->len;
+  dup_graph = _g_segraph_snapshot_new_blank (node_count,
                                              graph->edge_array->len,
                                              TRUE,
                                              TRUE);
-
-  for (iter = 0; iter < graph->node_array->len; ++iter)
+  copy.graph = graph;
+  copy.dup_graph = dup_graph;
+  copy.node_data_copy_func = node_data_copy_func;
+  copy.node_user_data = node_user_data;
+  copy.edge_data_copy_func = edge_data_copy_func;
+  copy.edge_user_data = edge_user_data;
+  _g_sgraph_positions_init (&copy.positions,
+                            G_SGRAPH_VISITED_DOMAIN_SEGRAPH,
+                            node_count + graph->edge_array->len);
+
+  for (iter = 0; iter < node_count; ++iter)
   {
     GSEGraphNode* node;
     GSEGraphNode* dup_node;
 
     node = g_ptr_array_index (graph->node_array, iter);
-    dup_node = g_slice_new (GSEGraphNode);
-
-    if (node_data_copy_func)
+    if (arena)
     {
-      dup_node->data = (*node_data_copy_func) (node->data, node_user_data);
+      dup_node = _g_segraph_arena_alloc_node (arena);
     }
     else
     {
-      dup_node->data = node->data;
+      dup_node = g_slice_new (GSEGraphNode);
     }
+    dup_node->arena = arena;
 
-    g_hash_table_insert (nodes_to_dups, node, dup_node);
+    _g_sgraph_positions_set (&copy.positions, node, &node->visit_mark, iter);
     g_ptr_array_add (dup_graph->node_array, dup_node);
   }
 
@@ -1090,46 +1977,423 @@ _g_segraph_snapshot_copy_general (GSEGraphSnapshot* graph,
     GSEGraphEdge* dup_edge;
 
     edge = g_ptr_array_index (graph->edge_array, iter);
-    dup_edge = g_slice_new (GSEGraphEdge);
-    dup_edge->first = g_hash_table_lookup (nodes_to_dups, edge->first);
-    dup_edge->second = g_hash_table_lookup (nodes_to_dups, edge->second);
-
-    if (edge_data_copy_func)
+    if (arena)
     {
-      dup_edge->data = (*edge_data_copy_func) (edge->data, edge_user_data);
+      dup_edge = _g_segraph_arena_alloc_edge (arena);
     }
     else
     {
-      dup_edge->data = edge->data;
+      dup_edge = g_slice_new (GSEGraphEdge);
     }
+    dup_edge->arena = arena;
 
-    g_hash_table_insert (edges_to_dups, edge, dup_edge);
+    _g_sgraph_positions_set (&copy.positions,
+                             edge,
+                             &edge->visit_mark,
+                             node_count + iter);
     g_ptr_array_add (dup_graph->edge_array, dup_edge);
   }
+  _g_sgraph_positions_seal (&copy.positions);
 
-  for (iter = 0; iter < graph->node_array->len; ++iter)
+  _g_sgraph_parallel_for (node_count + graph->edge_array->len,
+                          _g_segraph_snapshot_copy_element,
+                          &copy,
+                          n_threads);
+  _g_sgraph_positions_clear (&copy.positions);
+
+  return dup_graph;
+}
+
+/**
+ * _g_segraph_snapshot_copy_element:
+ * @index: an index of a node or, if greater than number of nodes, of an edge.
+ * @copy: a #GSEGraphSnapshotCopy.
+ *
+ * Fills a copy of a node with duplicated data and edges or a copy of an edge
+ * with duplicated data and ends.
+ */
+static void
+_g_segraph_snapshot_copy_element (guint index,
+                                  gpointer copy)
+{
+  GSEGraphSnapshotCopy* graph_copy;
+  guint node_count;
+
+  graph_copy = copy;
+  node_count = graph_copy->graph->node_array->len;
+  if (index < node_count)
   {
     GSEGraphNode* node;
     GSEGraphNode* dup_node;
     GPtrArray* dup_edges;
-    guint iter2;
+    guint iter;
+
+    node = g_ptr_array_index (graph_copy->graph->node_array, index);
+    dup_node = g_ptr_array_index (graph_copy->dup_graph->node_array, index);
+    dup_node->connectivity = NULL;
+    dup_node->connectivity_index = 0;
+    dup_node->visit_mark = 0;
+    dup_node->keep_edge_order = node->keep_edge_order;
+
+    if (graph_copy->node_data_copy_func)
+    {
+      dup_node->data =
+        (*graph_copy->node_data_copy_func) (node->data,
+                                            graph_copy->node_user_data);
+    }
+    else
+    {
+      dup_node->data = node->data;
+    }
 
-    node = g_ptr_array_index (graph->node_array, iter);
-    dup_node = g_ptr_array_index (dup_graph->node_array, iter);
     dup_edges = g_ptr_array_sized_new (node->edges->len);
+    for (iter = 0; iter < node->edges->len; ++iter)
+    {
+      GSEGraphEdge* edge;
+      guint position;
+
+      edge = g_ptr_array_index (node->edges, iter);
+      position = _g_sgraph_positions_get (&graph_copy->positions,
+                                          edge,
+                                          &edge->visit_mark);
+      if (position == G_MAXUINT)
+      {
+        g_ptr_array_add (dup_edges, NULL);
+      }
+      else
+      {
+        g_ptr_array_add (dup_edges,
+                         g_ptr_array_index (graph_copy->dup_graph->edge_array,
+                                            position - node_count));
+      }
+    }
+    dup_node->edges = dup_edges;
+  }
+  else
+  {
+    GSEGraphEdge* edge;
+    GSEGraphEdge* dup_edge;
+
+    edge = g_ptr_array_index (graph_copy->graph->edge_array,
+                              index - node_count);
+    dup_edge = g_ptr_array_index (graph_copy->dup_graph->edge_array,
+                                  index - node_count);
+    dup_edge->first = _g_segraph_snapshot_get_dup_node (graph_copy,
+                                                        edge->first);
+    dup_edge->second = _g_segraph_snapshot_get_dup_node (graph_copy,
+                                                         edge->second);
+    dup_edge->visit_mark = 0;
+    dup_edge->first_position = edge->first_position;
+    dup_edge->second_position = edge->second_position;
+
+    if (graph_copy->edge_data_copy_func)
+    {
+      dup_edge->data =
+        (*graph_copy->edge_data_copy_func) (edge->data,
+                                            graph_copy->edge_user_data);
+    }
+    else
+    {
+      dup_edge->data = edge->data;
+    }
+  }
+}
+
+/**
+ * _g_segraph_snapshot_get_dup_node:
+ * @copy: a #GSEGraphSnapshotCopy.
+ * @node: a node of copied graph or %NULL.
+ *
+ * Gets a copy of @node.
+ *
+ * Returns: copy of @node or %NULL if @node is %NULL or not in copied graph.
+ */
+static GSEGraphNode*
+_g_segraph_snapshot_get_dup_node (GSEGraphSnapshotCopy* copy,
+                                  GSEGraphNode* node)
+{
+  guint position;
+
+  if (!node)
+  {
+    return NULL;
+  }
+  position = _g_sgraph_positions_get (&copy->positions,
+                                      node,
+                                      &node->visit_mark);
+  if (position >= copy->graph->node_array->len)
+  {
+    return NULL;
+  }
+  return g_ptr_array_index (copy->dup_graph->node_array, position);
+}
+
+/**
+ * _g_segraph_snapshot_compute_ordering:
+ * @csr: a graph in compressed sparse row form.
+ * @ordering: kind of order.
+ *
+ * Computes an order of nodes in @csr. Edges are turned into neighbour indices
+ * first, so the same computation as for simple graphs can be used.
+ *
+ * Returns: #GArray of #guint32 node indices.
+ */
+static GArray*
+_g_segraph_snapshot_compute_ordering (GSEGraphCsr* csr,
+                                      GSEGraphOrdering ordering)
+{
+  GArray* permutation;
+  guint32* neighbours;
+  guint32 iter;
+
+  neighbours = g_new (guint32, csr->offsets[csr->order]);
+  for (iter = 0; iter < csr->order; ++iter)
+  {
+    guint32 iter2;
+
+    for (iter2 = csr->offsets[iter]; iter2 < csr->offsets[iter + 1]; ++iter2)
+    {
+      guint32 edge_index;
+
+      edge_index = csr->edges[iter2];
+      if (csr->firsts[edge_index] == iter)
+      {
+        neighbours[iter2] = csr->seconds[edge_index];
+      }
+      else
+      {
+        neighbours[iter2] = csr->firsts[edge_index];
+      }
+    }
+  }
+
+  /* both ordering enums have the same values. */
+  permutation = _g_sgraph_ordering_compute (csr->order,
+                                            csr->offsets,
+                                            neighbours,
+                                            (GSGraphOrdering)ordering);
+  g_free (neighbours);
+
+  return permutation;
+}
+
+/**
+ * _g_segraph_snapshot_label_general:
+ * @nodes: array of distinct nodes.
+ * @n_components: return location for number of components or %NULL.
+ * @n_threads: number of threads to use, including the calling one.
+ * @graphs: return location for array of components or %NULL.
+ *
+ * Labels connected components of @nodes. If @graphs is not %NULL, it is set
+ * to an array of wrappers, one for each component. See
+ * g_segraph_snapshot_label_components() for details.
+ *
+ * Returns: #GArray of #guint32 labels.
+ */
+static GArray*
+_g_segraph_snapshot_label_general (GPtrArray* nodes,
+                                   guint* n_components,
+                                   guint n_threads,
+                                   GPtrArray** graphs)
+{
+  GSEGraphSnapshotComponents graph_components;
+  GArray* labels;
+  guint count;
+  guint iter;
+
+  graph_components.nodes = nodes;
+  graph_components.components = _g_sgraph_components_new (nodes->len);
+  _g_sgraph_positions_init (&graph_components.positions,
+                            G_SGRAPH_VISITED_DOMAIN_SEGRAPH,
+                            nodes->len);
+  for (iter = 0; iter < nodes->len; ++iter)
+  {
+    GSEGraphNode* node;
+
+    node = g_ptr_array_index (nodes, iter);
+    _g_sgraph_positions_set (&graph_components.positions,
+                             node,
+                             &node->visit_mark,
+                             iter);
+  }
+  _g_sgraph_positions_seal (&graph_components.positions);
+
+  _g_sgraph_parallel_for (nodes->len,
+                          _g_segraph_snapshot_join_neighbours,
+                          &graph_components,
+                          n_threads);
+
+  labels = g_array_sized_new (FALSE, FALSE, sizeof (guint32), nodes->len);
+  g_array_set_size (labels, nodes->len);
+  count = _g_sgraph_components_label (graph_components.components,
+                                      (guint32*)labels->data,
+                                      n_threads);
+  _g_sgraph_components_free (graph_components.components);
+
+  if (graphs)
+  {
+    *graphs = _g_segraph_snapshot_split (&graph_components, labels, count);
+  }
+  _g_sgraph_positions_clear (&graph_components.positions);
+
+  if (n_components)
+  {
+    *n_components = count;
+  }
+  return labels;
+}
+
+/**
+ * _g_segraph_snapshot_join_neighbours:
+ * @index: an index of a node.
+ * @components: a #GSEGraphSnapshotComponents.
+ *
+ * Joins component of @index-th node with components of its neighbours having
+ * higher positions. Edge leading to a neighbour having lower position is
+ * joined by that neighbour.
+ */
+static void
+_g_segraph_snapshot_join_neighbours (guint index,
+                                     gpointer components)
+{
+  GSEGraphSnapshotComponents* graph_components;
+  GSEGraphNode* node;
+  guint iter;
+
+  graph_components = components;
+  node = g_ptr_array_index (graph_components->nodes, index);
+  for (iter = 0; iter < node->edges->len; ++iter)
+  {
+    GSEGraphEdge* edge;
+    GSEGraphNode* neighbour;
+    guint position;
+
+    edge = g_ptr_array_index (node->edges, iter);
+    neighbour = (edge->first == node) ? edge->second : edge->first;
+    if (!neighbour)
+    {
+      continue;
+    }
+    position = _g_sgraph_positions_get (&graph_components->positions,
+                                        neighbour,
+                                        &neighbour->visit_mark);
+    if ((position != G_MAXUINT) && (position > index))
+    {
+      _g_sgraph_components_union (graph_components->components,
+                                  index,
+                                  position);
+    }
+  }
+}
+
+/**
+ * _g_segraph_snapshot_split:
+ * @graph_components: labelled components with positions still set.
+ * @labels: labels of nodes.
+ * @n_components: number of components.
+ *
+ * Creates a wrapper for each component. An edge is put into component of its
+ * first end if that end is in labelled nodes, otherwise into component of its
+ * second end. Positions of edges in edge arrays of their ends tell which
+ * occurrence of a loop is the first one.
+ *
+ * Returns: #GPtrArray of #GSEGraphSnapshot<!-- -->s.
+ */
+static GPtrArray*
+_g_segraph_snapshot_split (GSEGraphSnapshotComponents* graph_components,
+                           GArray* labels,
+                           guint n_components)
+{
+  GPtrArray* graphs;
+  GPtrArray* nodes;
+  guint iter;
+
+  nodes = graph_components->nodes;
+  graphs = g_ptr_array_sized_new (n_components);
+  for (iter = 0; iter < n_components; ++iter)
+  {
+    g_ptr_array_add (graphs, _g_segraph_snapshot_new_blank (0, 0, TRUE, TRUE));
+  }
+
+  for (iter = 0; iter < nodes->len; ++iter)
+  {
+    GSEGraphSnapshot* graph;
+    GSEGraphNode* node;
+    guint iter2;
 
+    graph = g_ptr_array_index (graphs, g_array_index (labels, guint32, iter));
+    node = g_ptr_array_index (nodes, iter);
+    g_ptr_array_add (graph->node_array, node);
     for (iter2 = 0; iter2 < node->edges->len; ++iter2)
     {
-      GSEGraphEdge* edge = g_ptr_array_index (node->edges, iter2);
-      GSEGraphEdge* dup_edge = g_hash_table_lookup (edges_to_dups, edge);
-      g_ptr_array_add (dup_edges, dup_edge);
+      GSEGraphEdge* edge;
+      gboolean owned;
+
+      edge = g_ptr_array_index (node->edges, iter2);
+      if ((edge->first == node) && (edge->first_position == iter2))
+      {
+        owned = TRUE;
+      }
+      else if ((edge->second == node) && (edge->second_position == iter2))
+      {
+        owned = (!edge->first ||
+                 (_g_sgraph_positions_get (&graph_components->positions,
+                                           edge->first,
+                                           &edge->first->visit_mark) ==
+                  G_MAXUINT));
+      }
+      else
+      {
+        owned = FALSE;
+      }
+
+      if (owned)
+      {
+        g_ptr_array_add (graph->edge_array, edge);
+      }
     }
-    dup_node->edges = dup_edges;
   }
 
-  g_hash_table_unref (nodes_to_dups);
-  g_hash_table_unref (edges_to_dups);
-  return dup_graph;
+  for (iter = 0; iter < n_components; ++iter)
+  {
+    GSEGraphSnapshot* graph;
+
+    graph = g_ptr_array_index (graphs, iter);
+    graph->order = graph->node_array->len;
+    graph->size = graph->edge_array->len;
+  }
+
+  return graphs;
+}
+
+/**
+ * _g_segraph_snapshot_push_frame:
+ * @stack: stack of #GSEGraphSnapshotFrame<!-- -->s.
+ * @discovery: discovery times of nodes, 0 for not yet discovered.
+ * @low: lowest discovery times reachable from subtrees of nodes.
+ * @time: last used discovery time.
+ * @index: position of a discovered node.
+ * @edge: edge by which the node was reached or %NULL for a root.
+ *
+ * Gives next discovery time to @index-th node and pushes its frame on @stack.
+ */
+static void
+_g_segraph_snapshot_push_frame (GArray* stack,
+                                guint32* discovery,
+                                guint32* low,
+                                guint32* time,
+                                guint index,
+                                GSEGraphEdge* edge)
+{
+  GSEGraphSnapshotFrame frame;
+
+  ++*time;
+  discovery[index] = *time;
+  low[index] = *time;
+  frame.index = index;
+  frame.edge = edge;
+  frame.position = 0;
+  g_array_append_val (stack, frame);
 }
 
 /**
@@ -1171,5 +2435,78 @@ _g_segraph_snapshot_new_blank (guint node_array_size,
     graph->edge_array = NULL;
   }
 
+  graph->order = 0;
+  graph->size = 0;
+  graph->node_index = NULL;
+  graph->edge_index = NULL;
+
   return graph;
 }
+
+/**
+ * _g_segraph_snapshot_get_node_index:
+ * @data: data of a node.
+ * @data_to_indices: map of data to indices of nodes holding them.
+ * @nodes: array of already created nodes.
+ * @components: disjoint-set forest of components created nodes belong to.
+ * @arena: an arena for created nodes or %NULL.
+ *
+ * Gets an index of node holding @data. If there is no such node yet, it is
+ * created, put at the end of @nodes and added to @components as a separate
+ * component.
+ *
+ * Returns: index of node holding @data.
+ */
+static guint
+_g_segraph_snapshot_get_node_index (gpointer data,
+                                    GHashTable* data_to_indices,
+                                    GPtrArray* nodes,
+                                    GSGraphDisjointSet* components,
+                                    GSEGraphArena* arena)
+{
+  gpointer index;
+
+  if (!g_hash_table_lookup_extended (data_to_indices, data, NULL, &index))
+  {
+    index = GUINT_TO_POINTER (_g_sgraph_disjoint_set_add (components));
+    if (arena)
+    {
+      g_ptr_array_add (nodes, g_segraph_node_new_in_arena (arena, data));
+    }
+    else
+    {
+      g_ptr_array_add (nodes, g_segraph_node_new (data));
+    }
+    g_hash_table_insert (data_to_indices, data, index);
+  }
+
+  return GPOINTER_TO_UINT (index);
+}
+
+/**
+ * _g_segraph_snapshot_get_node_data:
+ * @node: a node.
+ *
+ * Gets data of @node. Used as a key function of node index.
+ *
+ * Returns: data of @node.
+ */
+static gpointer
+_g_segraph_snapshot_get_node_data (gpointer node)
+{
+  return ((GSEGraphNode*)node)->data;
+}
+
+/**
+ * _g_segraph_snapshot_get_edge_data:
+ * @edge: an edge.
+ *
+ * Gets data of @edge. Used as a key function of edge index.
+ *
+ * Returns: data of @edge.
+ */
+static gpointer
+_g_segraph_snapshot_get_edge_data (gpointer edge)
+{
+  return ((GSEGraphEdge*)edge)->data;
+}
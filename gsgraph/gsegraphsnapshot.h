@@ -45,12 +45,23 @@ struct _GSEGraphSnapshot
 {
   GPtrArray* node_array;
   GPtrArray* edge_array;
+
+  /*< private >*/
+  guint order;
+  guint size;
+  gpointer node_index;
+  gpointer edge_index;
 };
 
 GPtrArray*
 g_segraph_snapshot_new (GSEGraphDataTriplet** data_triplets,
                         guint count);
 
+GPtrArray*
+g_segraph_snapshot_new_in_arena (GSEGraphArena* arena,
+                                 GSEGraphDataTriplet** data_triplets,
+                                 guint count);
+
 GSEGraphSnapshot*
 g_segraph_snapshot_new_from_node (GSEGraphNode* node,
                                   GSEGraphTraverseType traverse_type);
@@ -77,6 +88,31 @@ g_segraph_snapshot_copy_deep (GSEGraphSnapshot* graph,
                               GCopyFunc edge_data_copy_func,
                               gpointer edge_user_data);
 
+GSEGraphSnapshot*
+g_segraph_snapshot_copy_deep_parallel (GSEGraphSnapshot* graph,
+                                       GCopyFunc node_data_copy_func,
+                                       gpointer node_user_data,
+                                       GCopyFunc edge_data_copy_func,
+                                       gpointer edge_user_data,
+                                       guint n_threads);
+
+GSEGraphSnapshot*
+g_segraph_snapshot_copy_in_arena (GSEGraphSnapshot* graph,
+                                  GSEGraphArena* arena,
+                                  GCopyFunc node_data_copy_func,
+                                  gpointer node_user_data,
+                                  GCopyFunc edge_data_copy_func,
+                                  gpointer edge_user_data);
+
+GArray*
+g_segraph_snapshot_get_ordering (GSEGraphSnapshot* graph,
+                                 GSEGraphOrdering ordering);
+
+GSEGraphSnapshot*
+g_segraph_snapshot_reorder (GSEGraphSnapshot* graph,
+                            GSEGraphArena* arena,
+                            GSEGraphOrdering ordering);
+
 void
 g_segraph_snapshot_free (GSEGraphSnapshot* graph,
                          gboolean deep_free);
@@ -87,6 +123,38 @@ g_segraph_snapshot_get_order (GSEGraphSnapshot* graph);
 guint
 g_segraph_snapshot_get_size (GSEGraphSnapshot* graph);
 
+void
+g_segraph_snapshot_build_node_index (GSEGraphSnapshot* graph,
+                                     GHashFunc hash_func,
+                                     GEqualFunc key_equal_func,
+                                     guint n_threads);
+
+void
+g_segraph_snapshot_drop_node_index (GSEGraphSnapshot* graph);
+
+gboolean
+g_segraph_snapshot_has_node_index (GSEGraphSnapshot* graph);
+
+GSEGraphNode*
+g_segraph_snapshot_lookup_node (GSEGraphSnapshot* graph,
+                                gconstpointer data);
+
+void
+g_segraph_snapshot_build_edge_index (GSEGraphSnapshot* graph,
+                                     GHashFunc hash_func,
+                                     GEqualFunc key_equal_func,
+                                     guint n_threads);
+
+void
+g_segraph_snapshot_drop_edge_index (GSEGraphSnapshot* graph);
+
+gboolean
+g_segraph_snapshot_has_edge_index (GSEGraphSnapshot* graph);
+
+GSEGraphEdge*
+g_segraph_snapshot_lookup_edge (GSEGraphSnapshot* graph,
+                                gconstpointer data);
+
 void
 g_segraph_snapshot_foreach_node (GSEGraphSnapshot* graph,
                                  GFunc func,
@@ -107,6 +175,47 @@ g_segraph_snapshot_find_edge_custom (GSEGraphSnapshot* graph,
                                      gpointer user_data,
                                      GEqualFunc func) G_GNUC_WARN_UNUSED_RESULT;
 
+void
+g_segraph_snapshot_foreach_node_parallel (GSEGraphSnapshot* graph,
+                                          GFunc func,
+                                          gpointer user_data,
+                                          guint n_threads);
+
+void
+g_segraph_snapshot_foreach_edge_parallel (GSEGraphSnapshot* graph,
+                                          GFunc func,
+                                          gpointer user_data,
+                                          guint n_threads);
+
+GSEGraphNode*
+g_segraph_snapshot_find_node_custom_parallel (GSEGraphSnapshot* graph,
+                                              gpointer user_data,
+                                              GEqualFunc func,
+                                              guint n_threads) G_GNUC_WARN_UNUSED_RESULT;
+
+GSEGraphEdge*
+g_segraph_snapshot_find_edge_custom_parallel (GSEGraphSnapshot* graph,
+                                              gpointer user_data,
+                                              GEqualFunc func,
+                                              guint n_threads) G_GNUC_WARN_UNUSED_RESULT;
+
+GArray*
+g_segraph_snapshot_label_components (GPtrArray* nodes,
+                                     guint* n_components,
+                                     guint n_threads) G_GNUC_WARN_UNUSED_RESULT;
+
+GPtrArray*
+g_segraph_snapshot_split_components (GPtrArray* nodes,
+                                     guint n_threads) G_GNUC_WARN_UNUSED_RESULT;
+
+GPtrArray*
+g_segraph_snapshot_find_bridges (GSEGraphSnapshot* graph) G_GNUC_WARN_UNUSED_RESULT;
+
+GPtrArray*
+g_segraph_snapshot_find_blocks (GSEGraphSnapshot* graph,
+                                GArray** articulation_points,
+                                GArray** edge_blocks) G_GNUC_WARN_UNUSED_RESULT;
+
 G_END_DECLS
 
 #endif /* _G_SEGRAPH_SNAPSHOT_H_ */
@@ -25,6 +25,10 @@
  * This header exist because there are circular dependencies:
  * .-> GSEGraphNode -> GPtrArray -> GSEGraphEdge -.
  * `----------------------------------------------'
+ * .-> GSEGraphNode -> GSEGraphConnectivity -.
+ * `-----------------------------------------'
+ * .-> GSEGraphNode -> GSEGraphArena -.
+ * `----------------------------------'
  *
  * So here typedefs to these structs exist. It should be enough, because none of
  * them needs information about sizes of other structs.
@@ -41,6 +45,10 @@ typedef struct _GSEGraphEdge GSEGraphEdge;
 
 typedef struct _GSEGraphNode GSEGraphNode;
 
+typedef struct _GSEGraphConnectivity GSEGraphConnectivity;
+
+typedef struct _GSEGraphArena GSEGraphArena;
+
 G_END_DECLS
 
 #endif /* _G_GRAPH_TYPEDEFS_H_ */
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsegraphvisitmarks.h"
+
+#include "gsegraphnode.h"
+#include "gsegraphedge.h"
+#include "gsgraphvisited.h"
+
+/**
+ * SECTION: gsegraphvisitmarks
+ * @title: Simple edged graph visit marks
+ * @short_description: allocation free bookkeeping of traversals.
+ * @include: gsgraph/gsegraph.h
+ * @see_also: #GSEGraphNode, #GSEGraphEdge, #GSEGraphSnapshot
+ *
+ * Every traversal has to remember which nodes and edges it already visited.
+ * By default it uses hash tables, which cost an allocation per visited element
+ * and hashing on every step. When visit marks are enabled, each node and edge
+ * carries a 32-bit mark and a traversal claims a new epoch, so checking whether
+ * an element was visited is a single comparison and nothing is allocated.
+ *
+ * To enable or disable visit marks, use g_segraph_visit_marks_set_enabled().
+ *
+ * To check if they are enabled, use g_segraph_visit_marks_get_enabled().
+ *
+ * To clear marks in a graph, use g_segraph_visit_marks_clear().
+ *
+ * <note>
+ *   <para>
+ *     Only one traversal at a time can use marks. A traversal running while
+ *     marks are in use, either in another thread or nested in the same one,
+ *     silently uses a hash table instead, so concurrent traversals of unchanged
+ *     graphs stay safe. With GLib older than 2.32 this requires thread system
+ *     to be initialized.
+ *   </para>
+ *   <para>
+ *     After about four billion traversals epochs run out. Then a warning is
+ *     printed and marks get disabled. To enable them again, clear marks in all
+ *     existing graphs first.
+ *   </para>
+ * </note>
+ */
+
+/* public function definitions. */
+
+/**
+ * g_segraph_visit_marks_set_enabled:
+ * @enabled: whether traversals should use visit marks.
+ *
+ * Enables or disables visit marks for #GSEGraphNode traversals. When enabling
+ * marks that got disabled because epochs ran out, marks of all existing nodes
+ * and edges must be 0 - which can be ensured with
+ * g_segraph_visit_marks_clear(). Marks disabled with this function can be
+ * enabled again without clearing. Marks are disabled by default.
+ */
+void
+g_segraph_visit_marks_set_enabled (gboolean enabled)
+{
+  _g_sgraph_visited_set_enabled (G_SGRAPH_VISITED_DOMAIN_SEGRAPH, enabled);
+}
+
+/**
+ * g_segraph_visit_marks_get_enabled:
+ *
+ * Checks if visit marks are enabled for #GSEGraphNode traversals. They can get
+ * disabled when epochs run out.
+ *
+ * Returns: %TRUE if visit marks are enabled, otherwise %FALSE.
+ */
+gboolean
+g_segraph_visit_marks_get_enabled (void)
+{
+  return _g_sgraph_visited_get_enabled (G_SGRAPH_VISITED_DOMAIN_SEGRAPH);
+}
+
+/**
+ * g_segraph_visit_marks_clear:
+ * @graph: a graph.
+ *
+ * Sets marks of all nodes and edges in @graph to 0. Must not be called while
+ * a traversal is running.
+ */
+void
+g_segraph_visit_marks_clear (GSEGraphSnapshot* graph)
+{
+  guint iter;
+
+  g_return_if_fail (graph != NULL);
+  g_return_if_fail (graph->node_array != NULL);
+  g_return_if_fail (graph->edge_array != NULL);
+
+  for (iter = 0; iter < graph->node_array->len; ++iter)
+  {
+    GSEGraphNode* node;
+
+    node = g_ptr_array_index (graph->node_array, iter);
+    node->visit_mark = 0;
+  }
+  for (iter = 0; iter < graph->edge_array->len; ++iter)
+  {
+    GSEGraphEdge* edge;
+
+    edge = g_ptr_array_index (graph->edge_array, iter);
+    edge->visit_mark = 0;
+  }
+}
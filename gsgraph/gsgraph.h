@@ -22,9 +22,17 @@
 
 #define _G_SGRAPH_H_INSIDE_
 
+#include <gsgraph/gsgraphtypedefs.h>
+
 #include <gsgraph/gsgraphnode.h>
 #include <gsgraph/gsgraphenums.h>
 #include <gsgraph/gsgraphsnapshot.h>
+#include <gsgraph/gsgraphbuilder.h>
+#include <gsgraph/gsgraphiter.h>
+#include <gsgraph/gsgraphcsr.h>
+#include <gsgraph/gsgraphconnectivity.h>
+#include <gsgraph/gsgrapharena.h>
+#include <gsgraph/gsgraphvisitmarks.h>
 #include <gsgraph/gsgraphdatapair.h>
 
 #undef _G_SGRAPH_H_INSIDE_
@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsgrapharena.h"
+#include "gsgrapharenaprivate.h"
+
+#include "gsgraphnodeprivate.h"
+#include "gsgraphblocks.h"
+
+/**
+ * SECTION: gsgrapharena
+ * @title: Simple graph arena
+ * @short_description: allocator of nodes freed all at once.
+ * @include: gsgraph/gsgraph.h
+ * @see_also: #GSGraphNode, g_sgraph_node_new_in_arena()
+ *
+ * Allocator handing out nodes from big blocks of memory. Nodes themselves
+ * take one allocation per thousand nodes instead of one per node and their
+ * memory is released in bulk. Every node still owns its neighbours array,
+ * which is a #GPtrArray allocated by GLib, so creating a node allocates that
+ * array and freeing the arena walks all nodes to free their arrays and data.
+ * Freeing an arena therefore takes time linear in number of nodes created in
+ * it.
+ *
+ * To create an arena, use g_sgraph_arena_new().
+ *
+ * To create a node in arena, use g_sgraph_node_new_in_arena(). To build whole
+ * graphs in arena, use g_sgraph_snapshot_new_in_arena() or
+ * g_sgraph_snapshot_copy_in_arena().
+ *
+ * To free an arena with all its nodes, use g_sgraph_arena_free().
+ *
+ * To check its memory use, use g_sgraph_arena_get_node_count(),
+ * g_sgraph_arena_get_reserved_size() and g_sgraph_arena_get_used_size().
+ *
+ * <note>
+ *   <para>
+ *     Nodes from an arena can be freed with g_sgraph_node_free() - their
+ *     memory is reused by next nodes created in the arena. Arena is not
+ *     thread safe.
+ *   </para>
+ * </note>
+ */
+
+/* internal types. */
+
+struct _GSGraphArena
+{
+  GSGraphBlocks nodes;
+};
+
+/* static function declarations. */
+
+static void
+_g_sgraph_arena_free_node (gpointer element,
+                           gpointer data_destroy_func_ptr);
+
+/* public function definitions. */
+
+/**
+ * g_sgraph_arena_new:
+ *
+ * Creates new empty arena.
+ *
+ * Returns: newly created #GSGraphArena.
+ */
+GSGraphArena*
+g_sgraph_arena_new (void)
+{
+  GSGraphArena* arena;
+
+  arena = g_slice_new (GSGraphArena);
+  _g_sgraph_blocks_init (&arena->nodes, sizeof (GSGraphNode));
+
+  return arena;
+}
+
+/**
+ * g_sgraph_arena_free:
+ * @arena: arena to free.
+ * @data_destroy_func: function freeing data of nodes or %NULL.
+ *
+ * Frees @arena together with all nodes allocated from it. Memory of nodes is
+ * released in blocks, but neighbours array of every node not freed before is
+ * freed separately, so it takes time linear in number of nodes created in
+ * @arena. Nodes from @arena must not be connected to nodes from outside of it,
+ * because such nodes would keep pointers to freed memory.
+ */
+void
+g_sgraph_arena_free (GSGraphArena* arena,
+                     GDestroyNotify data_destroy_func)
+{
+  g_return_if_fail (arena != NULL);
+
+  _g_sgraph_blocks_foreach (&arena->nodes,
+                            _g_sgraph_arena_free_node,
+                            &data_destroy_func);
+  _g_sgraph_blocks_clear (&arena->nodes);
+  g_slice_free (GSGraphArena, arena);
+}
+
+/**
+ * g_sgraph_arena_get_node_count:
+ * @arena: an arena.
+ *
+ * Gets number of nodes in @arena which were not freed.
+ *
+ * Returns: number of nodes.
+ */
+guint
+g_sgraph_arena_get_node_count (GSGraphArena* arena)
+{
+  g_return_val_if_fail (arena != NULL, 0);
+
+  return arena->nodes.count;
+}
+
+/**
+ * g_sgraph_arena_get_reserved_size:
+ * @arena: an arena.
+ *
+ * Gets number of bytes @arena reserved for nodes.
+ *
+ * Returns: reserved size in bytes.
+ */
+gsize
+g_sgraph_arena_get_reserved_size (GSGraphArena* arena)
+{
+  g_return_val_if_fail (arena != NULL, 0);
+
+  return _g_sgraph_blocks_get_reserved_size (&arena->nodes);
+}
+
+/**
+ * g_sgraph_arena_get_used_size:
+ * @arena: an arena.
+ *
+ * Gets number of bytes taken by nodes in @arena which were not freed. Memory
+ * of their neighbours arrays is not counted.
+ *
+ * Returns: used size in bytes.
+ */
+gsize
+g_sgraph_arena_get_used_size (GSGraphArena* arena)
+{
+  g_return_val_if_fail (arena != NULL, 0);
+
+  return (gsize)arena->nodes.count * sizeof (GSGraphNode);
+}
+
+/* internal function definitions. */
+
+/**
+ * _g_sgraph_arena_alloc_node:
+ * @arena: an arena.
+ *
+ * Hands out memory for a node. Node has to be initialized by caller.
+ *
+ * Returns: uninitialized node.
+ */
+GSGraphNode*
+_g_sgraph_arena_alloc_node (GSGraphArena* arena)
+{
+  return _g_sgraph_blocks_alloc (&arena->nodes);
+}
+
+/**
+ * _g_sgraph_arena_release_node:
+ * @arena: an arena.
+ * @node: a disposed node allocated from @arena.
+ *
+ * Gives memory of @node back to @arena.
+ */
+void
+_g_sgraph_arena_release_node (GSGraphArena* arena,
+                              GSGraphNode* node)
+{
+  _g_sgraph_blocks_release (&arena->nodes, node);
+}
+
+/* static function definitions. */
+
+/**
+ * _g_sgraph_arena_free_node:
+ * @element: a node slot.
+ * @data_destroy_func_ptr: pointer to #GDestroyNotify freeing data of node.
+ *
+ * Disposes a node in @element, unless it was already freed.
+ */
+static void
+_g_sgraph_arena_free_node (gpointer element,
+                           gpointer data_destroy_func_ptr)
+{
+  GSGraphNode* node;
+  GDestroyNotify data_destroy_func;
+
+  node = element;
+  if (!node->neighbours)
+  {
+    return;
+  }
+  data_destroy_func = *(GDestroyNotify*)data_destroy_func_ptr;
+  if (data_destroy_func)
+  {
+    (*data_destroy_func) (node->data);
+  }
+  _g_sgraph_node_dispose (node);
+}
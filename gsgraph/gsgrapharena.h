@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined (G_DISABLE_SINGLE_INCLUDES) && !defined (_G_SGRAPH_H_INSIDE_) && !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "Only <gsgraph/gsgraph.h> can be included directly."
+#endif
+
+#ifndef _G_SGRAPH_ARENA_H_
+#define _G_SGRAPH_ARENA_H_
+
+#include <glib.h>
+
+#include <gsgraph/gsgraphtypedefs.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GSGraphArena:
+ *
+ * Opaque allocator of nodes which are freed all at once.
+ */
+
+GSGraphArena*
+g_sgraph_arena_new (void) G_GNUC_WARN_UNUSED_RESULT;
+
+void
+g_sgraph_arena_free (GSGraphArena* arena,
+                     GDestroyNotify data_destroy_func);
+
+guint
+g_sgraph_arena_get_node_count (GSGraphArena* arena);
+
+gsize
+g_sgraph_arena_get_reserved_size (GSGraphArena* arena);
+
+gsize
+g_sgraph_arena_get_used_size (GSGraphArena* arena);
+
+G_END_DECLS
+
+#endif /* _G_SGRAPH_ARENA_H_ */
@@ -0,0 +1,459 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "gsgraphbfs.h"
+#include "gsgraphparallel.h"
+
+/* Internal level-synchronous breadth first search running on many threads.
+ * Graph is given as arrays of offsets and neighbour indices, like in
+ * #GSGraphCsr. Each level is split into chunks processed by
+ * _g_sgraph_parallel_for() and each chunk collects nodes it found in its own
+ * buffer, so threads share only a bitmap of visited nodes, which is updated
+ * with atomic operations.
+ *
+ * A level is expanded either top-down, by checking all neighbours of frontier
+ * nodes, or bottom-up, by checking whether any neighbour of a not yet visited
+ * node is in the frontier. Bottom-up steps pay off when frontier is large,
+ * because most of unvisited nodes find their parent after checking few
+ * neighbours. Search switches to bottom-up when the frontier is growing and its
+ * edges outnumber a fraction of edges of unvisited nodes and back to top-down
+ * when the frontier gets small again. Small frontiers are expanded by the
+ * calling thread alone.
+ */
+
+/* internal macros */
+
+/* number of chunks each level is split into per thread. */
+#define G_SGRAPH_BFS_CHUNKS_PER_THREAD 8
+
+/* top-down steps are used while frontier edges are fewer than unchecked edges
+ * divided by this. */
+#define G_SGRAPH_BFS_ALPHA 14
+
+/* bottom-up steps are used while frontier nodes are more than all nodes
+ * divided by this. */
+#define G_SGRAPH_BFS_BETA 24
+
+/* top-down steps over frontiers with fewer edges than this are done by the
+ * calling thread only, because waking up pool threads would take longer. */
+#define G_SGRAPH_BFS_SEQUENTIAL_EDGES 4096
+
+/* number of bits in a bitmap word. */
+#define G_SGRAPH_BFS_WORD_BITS 32
+
+/* internal types. */
+
+/**
+ * GSGraphBfsChunk:
+ * @found: nodes found by this chunk in current level.
+ * @degree_sum: sum of degrees of nodes in @found.
+ *
+ * Output of one chunk of a level.
+ */
+typedef struct _GSGraphBfsChunk GSGraphBfsChunk;
+
+struct _GSGraphBfsChunk
+{
+  GArray* found;
+  guint64 degree_sum;
+};
+
+/**
+ * GSGraphBfs:
+ * @order: number of nodes.
+ * @offsets: offsets into @neighbours.
+ * @neighbours: neighbour indices.
+ * @depths: depth of every node.
+ * @parents: parent of every node or %NULL.
+ * @visited: bitmap of visited nodes.
+ * @frontier_bits: bitmap of frontier nodes, filled for bottom-up steps only.
+ * @frontier: nodes of current level.
+ * @frontier_length: number of nodes in @frontier.
+ * @level: depth of nodes in @frontier.
+ * @chunks: outputs of chunks.
+ * @n_chunks: number of chunks.
+ *
+ * Internal state of a search, shared by threads.
+ */
+typedef struct _GSGraphBfs GSGraphBfs;
+
+struct _GSGraphBfs
+{
+  guint32 order;
+  const guint32* offsets;
+  const guint32* neighbours;
+  guint32* depths;
+  guint32* parents;
+  gint* visited;
+  gint* frontier_bits;
+  guint32* frontier;
+  guint32 frontier_length;
+  guint32 level;
+  GSGraphBfsChunk* chunks;
+  guint n_chunks;
+};
+
+/* static function declarations. */
+
+static void
+_g_sgraph_bfs_step_top_down (guint chunk_index,
+                             gpointer bfs);
+
+static void
+_g_sgraph_bfs_step_bottom_up (guint chunk_index,
+                              gpointer bfs);
+
+static void
+_g_sgraph_bfs_add (GSGraphBfs* bfs,
+                   GSGraphBfsChunk* chunk,
+                   guint32 index,
+                   guint32 parent);
+
+static gboolean
+_g_sgraph_bfs_mark_visited (GSGraphBfs* bfs,
+                            guint32 index);
+
+static gboolean
+_g_sgraph_bfs_is_visited (GSGraphBfs* bfs,
+                          guint32 index);
+
+/* function definitions. */
+
+/**
+ * _g_sgraph_bfs_parallel:
+ * @order: number of nodes.
+ * @offsets: array of @order + 1 offsets into @neighbours.
+ * @neighbours: array of neighbour indices.
+ * @start: index of starting node.
+ * @depths: array of @order elements to fill with depths.
+ * @parents: array of @order elements to fill with parents or %NULL.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Does breadth first search from @start. Unreachable nodes get %G_MAXUINT32
+ * as their depth and parent. Parent of @start is @start itself. Depths are the
+ * same as sequential search would give, parents can differ between runs if
+ * a node has many neighbours in previous level.
+ */
+void
+_g_sgraph_bfs_parallel (guint32 order,
+                        const guint32* offsets,
+                        const guint32* neighbours,
+                        guint32 start,
+                        guint32* depths,
+                        guint32* parents,
+                        guint n_threads)
+{
+  GSGraphBfs bfs;
+  guint64 unchecked_edges;
+  guint64 frontier_edges;
+  guint32 previous_length;
+  guint words;
+  gboolean bottom_up;
+  guint iter;
+
+  words = order / G_SGRAPH_BFS_WORD_BITS + 1;
+  bfs.order = order;
+  bfs.offsets = offsets;
+  bfs.neighbours = neighbours;
+  bfs.depths = depths;
+  bfs.parents = parents;
+  bfs.visited = g_new0 (gint, words);
+  bfs.frontier_bits = g_new (gint, words);
+  bfs.frontier = g_new (guint32, order);
+  bfs.n_chunks = MAX (n_threads, 1) * G_SGRAPH_BFS_CHUNKS_PER_THREAD;
+  bfs.chunks = g_new (GSGraphBfsChunk, bfs.n_chunks);
+  for (iter = 0; iter < bfs.n_chunks; ++iter)
+  {
+    bfs.chunks[iter].found = g_array_new (FALSE, FALSE, sizeof (guint32));
+  }
+  memset (depths, 0xff, order * sizeof (guint32));
+  if (parents)
+  {
+    memset (parents, 0xff, order * sizeof (guint32));
+  }
+
+  _g_sgraph_bfs_mark_visited (&bfs, start);
+  depths[start] = 0;
+  if (parents)
+  {
+    parents[start] = start;
+  }
+  bfs.frontier[0] = start;
+  bfs.frontier_length = 1;
+  bfs.level = 0;
+  previous_length = 0;
+  frontier_edges = offsets[start + 1] - offsets[start];
+  unchecked_edges = offsets[order] - frontier_edges;
+  bottom_up = FALSE;
+
+  while (bfs.frontier_length)
+  {
+    guint32 length;
+
+    /* near the end of search few edges are left unchecked, so frontier
+     * has to be growing too. */
+    if (!bottom_up)
+    {
+      bottom_up = ((bfs.frontier_length > previous_length) &&
+                   (frontier_edges > unchecked_edges / G_SGRAPH_BFS_ALPHA));
+    }
+    else
+    {
+      bottom_up = (bfs.frontier_length > order / G_SGRAPH_BFS_BETA);
+    }
+
+    for (iter = 0; iter < bfs.n_chunks; ++iter)
+    {
+      g_array_set_size (bfs.chunks[iter].found, 0);
+      bfs.chunks[iter].degree_sum = 0;
+    }
+
+    if (bottom_up)
+    {
+      memset (bfs.frontier_bits, 0, words * sizeof (gint));
+      for (iter = 0; iter < bfs.frontier_length; ++iter)
+      {
+        guint32 index;
+
+        index = bfs.frontier[iter];
+        bfs.frontier_bits[index / G_SGRAPH_BFS_WORD_BITS] |=
+          1u << (index % G_SGRAPH_BFS_WORD_BITS);
+      }
+      _g_sgraph_parallel_for (bfs.n_chunks,
+                              _g_sgraph_bfs_step_bottom_up,
+                              &bfs,
+                              n_threads);
+    }
+    else
+    {
+      _g_sgraph_parallel_for (bfs.n_chunks,
+                              _g_sgraph_bfs_step_top_down,
+                              &bfs,
+                              (frontier_edges < G_SGRAPH_BFS_SEQUENTIAL_EDGES) ?
+                              1 : n_threads);
+    }
+
+    length = 0;
+    frontier_edges = 0;
+    for (iter = 0; iter < bfs.n_chunks; ++iter)
+    {
+      GSGraphBfsChunk* chunk;
+
+      chunk = bfs.chunks + iter;
+      if (!chunk->found->len)
+      {
+        continue;
+      }
+      memcpy (bfs.frontier + length,
+              chunk->found->data,
+              chunk->found->len * sizeof (guint32));
+      length += chunk->found->len;
+      frontier_edges += chunk->degree_sum;
+    }
+    previous_length = bfs.frontier_length;
+    bfs.frontier_length = length;
+    unchecked_edges -= frontier_edges;
+    ++bfs.level;
+  }
+
+  for (iter = 0; iter < bfs.n_chunks; ++iter)
+  {
+    g_array_free (bfs.chunks[iter].found, TRUE);
+  }
+  g_free (bfs.chunks);
+  g_free (bfs.frontier);
+  g_free (bfs.frontier_bits);
+  g_free (bfs.visited);
+}
+
+/* static function definitions. */
+
+/**
+ * _g_sgraph_bfs_step_top_down:
+ * @chunk_index: index of a chunk.
+ * @bfs: a #GSGraphBfs.
+ *
+ * Checks all neighbours of frontier nodes in @chunk_index-th part of the
+ * frontier. Neighbours not visited yet are claimed atomically, so each of
+ * them is found by exactly one chunk.
+ */
+static void
+_g_sgraph_bfs_step_top_down (guint chunk_index,
+                             gpointer bfs)
+{
+  GSGraphBfs* search;
+  GSGraphBfsChunk* chunk;
+  guint32 iter;
+  guint32 end;
+
+  search = bfs;
+  chunk = search->chunks + chunk_index;
+  iter = ((guint64)search->frontier_length * chunk_index) / search->n_chunks;
+  end = ((guint64)search->frontier_length * (chunk_index + 1)) /
+    search->n_chunks;
+  for (; iter < end; ++iter)
+  {
+    guint32 index;
+    guint32 iter2;
+
+    index = search->frontier[iter];
+    for (iter2 = search->offsets[index];
+         iter2 < search->offsets[index + 1];
+         ++iter2)
+    {
+      guint32 other_index;
+
+      other_index = search->neighbours[iter2];
+      if (!_g_sgraph_bfs_is_visited (search, other_index) &&
+          _g_sgraph_bfs_mark_visited (search, other_index))
+      {
+        _g_sgraph_bfs_add (search, chunk, other_index, index);
+      }
+    }
+  }
+}
+
+/**
+ * _g_sgraph_bfs_step_bottom_up:
+ * @chunk_index: index of a chunk.
+ * @bfs: a #GSGraphBfs.
+ *
+ * Looks for a frontier neighbour of every unvisited node in @chunk_index-th
+ * part of all nodes. Checking neighbours of a node stops at first one found
+ * in the frontier.
+ */
+static void
+_g_sgraph_bfs_step_bottom_up (guint chunk_index,
+                              gpointer bfs)
+{
+  GSGraphBfs* search;
+  GSGraphBfsChunk* chunk;
+  guint32 iter;
+  guint32 end;
+
+  search = bfs;
+  chunk = search->chunks + chunk_index;
+  iter = ((guint64)search->order * chunk_index) / search->n_chunks;
+  end = ((guint64)search->order * (chunk_index + 1)) / search->n_chunks;
+  for (; iter < end; ++iter)
+  {
+    guint32 iter2;
+
+    if (_g_sgraph_bfs_is_visited (search, iter))
+    {
+      continue;
+    }
+
+    for (iter2 = search->offsets[iter];
+         iter2 < search->offsets[iter + 1];
+         ++iter2)
+    {
+      guint32 other_index;
+      guint word;
+
+      other_index = search->neighbours[iter2];
+      word = search->frontier_bits[other_index / G_SGRAPH_BFS_WORD_BITS];
+      if (word & (1u << (other_index % G_SGRAPH_BFS_WORD_BITS)))
+      {
+        /* no other chunk checks this node, but it shares bitmap word with
+         * nodes of neighbouring chunks. */
+        _g_sgraph_bfs_mark_visited (search, iter);
+        _g_sgraph_bfs_add (search, chunk, iter, other_index);
+        break;
+      }
+    }
+  }
+}
+
+/**
+ * _g_sgraph_bfs_add:
+ * @bfs: a #GSGraphBfs.
+ * @chunk: a chunk which found a node.
+ * @index: index of found node.
+ * @parent: index of its parent.
+ *
+ * Records a node found in current level.
+ */
+static void
+_g_sgraph_bfs_add (GSGraphBfs* bfs,
+                   GSGraphBfsChunk* chunk,
+                   guint32 index,
+                   guint32 parent)
+{
+  bfs->depths[index] = bfs->level + 1;
+  if (bfs->parents)
+  {
+    bfs->parents[index] = parent;
+  }
+  g_array_append_val (chunk->found, index);
+  chunk->degree_sum += bfs->offsets[index + 1] - bfs->offsets[index];
+}
+
+/**
+ * _g_sgraph_bfs_mark_visited:
+ * @bfs: a #GSGraphBfs.
+ * @index: index of a node.
+ *
+ * Atomically sets visited bit of a node.
+ *
+ * Returns: %TRUE if bit was set by this call, %FALSE if it was already set.
+ */
+static gboolean
+_g_sgraph_bfs_mark_visited (GSGraphBfs* bfs,
+                            guint32 index)
+{
+  gint* word;
+  guint mask;
+  gint old_word;
+
+  word = bfs->visited + index / G_SGRAPH_BFS_WORD_BITS;
+  mask = 1u << (index % G_SGRAPH_BFS_WORD_BITS);
+  do
+  {
+    old_word = g_atomic_int_get (word);
+    if ((guint)old_word & mask)
+    {
+      return FALSE;
+    }
+  } while (!g_atomic_int_compare_and_exchange (word,
+                                               old_word,
+                                               (gint)((guint)old_word | mask)));
+  return TRUE;
+}
+
+/**
+ * _g_sgraph_bfs_is_visited:
+ * @bfs: a #GSGraphBfs.
+ * @index: index of a node.
+ *
+ * Checks visited bit of a node.
+ *
+ * Returns: %TRUE if node is visited.
+ */
+static gboolean
+_g_sgraph_bfs_is_visited (GSGraphBfs* bfs,
+                          guint32 index)
+{
+  guint word;
+
+  word = g_atomic_int_get (bfs->visited + index / G_SGRAPH_BFS_WORD_BITS);
+  return (word & (1u << (index % G_SGRAPH_BFS_WORD_BITS))) != 0;
+}
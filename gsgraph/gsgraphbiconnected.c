@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsgraphbiconnected.h"
+
+/* Internal state of Hopcroft-Tarjan algorithm finding biconnected blocks.
+ * Every discovered node is pushed on a stack. When a child finishes and its
+ * subtree cannot reach above its parent, the parent separates the subtree from
+ * the rest of the graph, so nodes are popped off the stack down to the child
+ * and, together with the parent, they form a block. Root of a search tree is
+ * an articulation point only if it has more than one child.
+ */
+
+/* static function declarations. */
+
+static void
+_g_sgraph_biconnected_discover (GSGraphBiconnected* biconnected,
+                                guint index);
+
+static void
+_g_sgraph_biconnected_pop_block (GSGraphBiconnected* biconnected,
+                                 guint index,
+                                 guint child);
+
+/* function definitions. */
+
+/**
+ * _g_sgraph_biconnected_new:
+ * @count: number of nodes.
+ *
+ * Creates new state for finding blocks of @count nodes, none of them being
+ * discovered yet.
+ *
+ * Returns: new #GSGraphBiconnected.
+ */
+GSGraphBiconnected*
+_g_sgraph_biconnected_new (guint count)
+{
+  GSGraphBiconnected* biconnected;
+  guint iter;
+
+  biconnected = g_slice_new (GSGraphBiconnected);
+  biconnected->discovery = g_new0 (guint32, count);
+  biconnected->low = g_new (guint32, count);
+  biconnected->labels = g_new (guint32, count);
+  biconnected->is_articulation = g_new0 (gboolean, count);
+  biconnected->stack = g_array_new (FALSE, FALSE, sizeof (guint32));
+  biconnected->blocks = g_ptr_array_new ();
+  biconnected->time = 0;
+  biconnected->root = 0;
+  biconnected->root_children = 0;
+  biconnected->count = count;
+  for (iter = 0; iter < count; ++iter)
+  {
+    biconnected->labels[iter] = G_MAXUINT32;
+  }
+
+  return biconnected;
+}
+
+/**
+ * _g_sgraph_biconnected_free:
+ * @biconnected: a state.
+ * @articulation_points: return location for articulation points or %NULL.
+ *
+ * Frees memory allocated to @biconnected. If @articulation_points is not
+ * %NULL, it is set to #GArray of #guint32 positions of articulation points, in
+ * ascending order.
+ *
+ * Returns: #GPtrArray of blocks, each being #GArray of #guint32 positions of
+ * nodes.
+ */
+GPtrArray*
+_g_sgraph_biconnected_free (GSGraphBiconnected* biconnected,
+                            GArray** articulation_points)
+{
+  GPtrArray* blocks;
+
+  if (articulation_points)
+  {
+    guint32 iter;
+
+    *articulation_points = g_array_new (FALSE, FALSE, sizeof (guint32));
+    for (iter = 0; iter < biconnected->count; ++iter)
+    {
+      if (biconnected->is_articulation[iter])
+      {
+        g_array_append_val (*articulation_points, iter);
+      }
+    }
+  }
+
+  blocks = biconnected->blocks;
+  g_array_free (biconnected->stack, TRUE);
+  g_free (biconnected->is_articulation);
+  g_free (biconnected->labels);
+  g_free (biconnected->low);
+  g_free (biconnected->discovery);
+  g_slice_free (GSGraphBiconnected, biconnected);
+
+  return blocks;
+}
+
+/**
+ * _g_sgraph_biconnected_start:
+ * @biconnected: a state.
+ * @index: position of a node.
+ *
+ * Starts new depth-first search tree from @index-th node, unless it was
+ * already discovered.
+ *
+ * Returns: %TRUE if search was started, %FALSE if node was already discovered.
+ */
+gboolean
+_g_sgraph_biconnected_start (GSGraphBiconnected* biconnected,
+                             guint index)
+{
+  if (biconnected->discovery[index])
+  {
+    return FALSE;
+  }
+  biconnected->root = index;
+  biconnected->root_children = 0;
+  _g_sgraph_biconnected_discover (biconnected, index);
+
+  return TRUE;
+}
+
+/**
+ * _g_sgraph_biconnected_reach:
+ * @biconnected: a state.
+ * @index: position of a node being visited.
+ * @neighbour: position of its neighbour, other than its parent.
+ *
+ * Discovers @neighbour-th node as a child of @index-th node or, if it was
+ * already discovered, lowers lowest discovery time reachable from @index-th
+ * node.
+ *
+ * Returns: %TRUE if neighbour was discovered and should be visited next.
+ */
+gboolean
+_g_sgraph_biconnected_reach (GSGraphBiconnected* biconnected,
+                             guint index,
+                             guint neighbour)
+{
+  guint32 discovery;
+
+  discovery = biconnected->discovery[neighbour];
+  if (!discovery)
+  {
+    _g_sgraph_biconnected_discover (biconnected, neighbour);
+    return TRUE;
+  }
+  biconnected->low[index] = MIN (biconnected->low[index], discovery);
+
+  return FALSE;
+}
+
+/**
+ * _g_sgraph_biconnected_finish:
+ * @biconnected: a state.
+ * @index: position of a node.
+ * @child: position of its child, which has no more neighbours to visit.
+ *
+ * Passes lowest discovery time reachable from @child-th node's subtree to its
+ * parent and forms a block if the parent separates the subtree.
+ */
+void
+_g_sgraph_biconnected_finish (GSGraphBiconnected* biconnected,
+                              guint index,
+                              guint child)
+{
+  guint32 child_low;
+
+  child_low = biconnected->low[child];
+  biconnected->low[index] = MIN (biconnected->low[index], child_low);
+  if (index == biconnected->root)
+  {
+    ++biconnected->root_children;
+    if (biconnected->root_children > 1)
+    {
+      biconnected->is_articulation[index] = TRUE;
+    }
+    _g_sgraph_biconnected_pop_block (biconnected, index, child);
+  }
+  else if (child_low >= biconnected->discovery[index])
+  {
+    biconnected->is_articulation[index] = TRUE;
+    _g_sgraph_biconnected_pop_block (biconnected, index, child);
+  }
+}
+
+/**
+ * _g_sgraph_biconnected_finish_root:
+ * @biconnected: a state.
+ * @index: position of root, which has no more neighbours to visit.
+ *
+ * Ends current depth-first search tree. Root without children forms a block
+ * alone.
+ */
+void
+_g_sgraph_biconnected_finish_root (GSGraphBiconnected* biconnected,
+                                   guint index)
+{
+  g_array_set_size (biconnected->stack, biconnected->stack->len - 1);
+  if (!biconnected->root_children)
+  {
+    GArray* block;
+    guint32 position;
+
+    block = g_array_sized_new (FALSE, FALSE, sizeof (guint32), 1);
+    position = index;
+    g_array_append_val (block, position);
+    biconnected->labels[index] = biconnected->blocks->len;
+    g_ptr_array_add (biconnected->blocks, block);
+  }
+}
+
+/* static function definitions. */
+
+/**
+ * _g_sgraph_biconnected_discover:
+ * @biconnected: a state.
+ * @index: position of a node.
+ *
+ * Gives next discovery time to @index-th node and pushes it on the stack.
+ */
+static void
+_g_sgraph_biconnected_discover (GSGraphBiconnected* biconnected,
+                                guint index)
+{
+  guint32 position;
+
+  ++biconnected->time;
+  biconnected->discovery[index] = biconnected->time;
+  biconnected->low[index] = biconnected->time;
+  position = index;
+  g_array_append_val (biconnected->stack, position);
+}
+
+/**
+ * _g_sgraph_biconnected_pop_block:
+ * @biconnected: a state.
+ * @index: position of a node separating a block.
+ * @child: position of its child starting the block.
+ *
+ * Pops nodes off the stack down to @child-th one and puts them into new block
+ * together with @index-th node, which stays on the stack.
+ */
+static void
+_g_sgraph_biconnected_pop_block (GSGraphBiconnected* biconnected,
+                                 guint index,
+                                 guint child)
+{
+  GArray* block;
+  guint32 label;
+  guint32 position;
+
+  block = g_array_new (FALSE, FALSE, sizeof (guint32));
+  label = biconnected->blocks->len;
+  do
+  {
+    position = g_array_index (biconnected->stack,
+                              guint32,
+                              biconnected->stack->len - 1);
+    g_array_set_size (biconnected->stack, biconnected->stack->len - 1);
+    biconnected->labels[position] = label;
+    g_array_append_val (block, position);
+  }
+  while (position != child);
+  position = index;
+  g_array_append_val (block, position);
+  g_ptr_array_add (biconnected->blocks, block);
+}
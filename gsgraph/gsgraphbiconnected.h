@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "This is a private header, it must not be included outside libggraph."
+#endif
+
+#ifndef _G_SGRAPH_BICONNECTED_H_
+#define _G_SGRAPH_BICONNECTED_H_
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GSGraphBiconnected:
+ * @discovery: discovery time of each node, 0 for not yet discovered.
+ * @low: lowest discovery time reachable from subtree of each node.
+ * @labels: block each node was popped into or %G_MAXUINT32.
+ * @is_articulation: whether each node is an articulation point.
+ * @stack: #GArray of #guint32 positions of nodes not yet put into a block.
+ * @blocks: #GPtrArray of found blocks.
+ * @time: last used discovery time.
+ * @root: position of root of current depth-first search tree.
+ * @root_children: number of children of @root.
+ * @count: number of nodes.
+ *
+ * Internal state of finding biconnected blocks and articulation points during
+ * depth-first search over positions of nodes. Search itself is driven by
+ * caller, which knows how to walk neighbours of a node.
+ */
+typedef struct _GSGraphBiconnected GSGraphBiconnected;
+
+struct _GSGraphBiconnected
+{
+  guint32* discovery;
+  guint32* low;
+  guint32* labels;
+  gboolean* is_articulation;
+  GArray* stack;
+  GPtrArray* blocks;
+  guint32 time;
+  guint root;
+  guint root_children;
+  guint count;
+};
+
+G_GNUC_INTERNAL GSGraphBiconnected*
+_g_sgraph_biconnected_new (guint count);
+
+G_GNUC_INTERNAL GPtrArray*
+_g_sgraph_biconnected_free (GSGraphBiconnected* biconnected,
+                            GArray** articulation_points);
+
+G_GNUC_INTERNAL gboolean
+_g_sgraph_biconnected_start (GSGraphBiconnected* biconnected,
+                             guint index);
+
+G_GNUC_INTERNAL gboolean
+_g_sgraph_biconnected_reach (GSGraphBiconnected* biconnected,
+                             guint index,
+                             guint neighbour);
+
+G_GNUC_INTERNAL void
+_g_sgraph_biconnected_finish (GSGraphBiconnected* biconnected,
+                              guint index,
+                              guint child);
+
+G_GNUC_INTERNAL void
+_g_sgraph_biconnected_finish_root (GSGraphBiconnected* biconnected,
+                                   guint index);
+
+G_END_DECLS
+
+#endif /* _G_SGRAPH_BICONNECTED_H_ */
@@ -0,0 +1,507 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <glib/gstdio.h>
+
+#include "gsgraphbinary.h"
+
+/* Binary graph files are meant to be mapped into memory and used in place, so
+ * every section is aligned and stored in native byte order. Files written on
+ * a machine with different byte order are refused. Everything read from a
+ * file is validated before use, so a damaged file results in an error, not in
+ * reading out of bounds.
+ */
+
+/* static function declarations. */
+
+static gboolean
+_g_sgraph_binary_write_raw (GSGraphBinaryWriter* writer,
+                            gconstpointer data,
+                            gsize length,
+                            GError** error);
+
+static gboolean
+_g_sgraph_binary_write_padding (GSGraphBinaryWriter* writer,
+                                GError** error);
+
+static void
+_g_sgraph_binary_set_file_error (GSGraphBinaryWriter* writer,
+                                 GError** error);
+
+/* function definitions. */
+
+/**
+ * _g_sgraph_binary_writer_open:
+ * @writer: a writer to initialize.
+ * @filename: name of a file to write.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Opens @filename for writing. Room for a header is left at the beginning, it
+ * is written by _g_sgraph_binary_writer_close().
+ *
+ * Returns: %TRUE on success, %FALSE if an error occured.
+ */
+gboolean
+_g_sgraph_binary_writer_open (GSGraphBinaryWriter* writer,
+                              const gchar* filename,
+                              GError** error)
+{
+  GSGraphBinaryHeader header;
+
+  writer->filename = filename;
+  writer->written = 0;
+  writer->file = g_fopen (filename, "wb");
+  if (!writer->file)
+  {
+    _g_sgraph_binary_set_file_error (writer, error);
+    return FALSE;
+  }
+
+  memset (&header, 0, sizeof (GSGraphBinaryHeader));
+  if (!_g_sgraph_binary_write (writer,
+                               &header,
+                               sizeof (GSGraphBinaryHeader),
+                               error))
+  {
+    _g_sgraph_binary_writer_abort (writer);
+    return FALSE;
+  }
+  return TRUE;
+}
+
+/**
+ * _g_sgraph_binary_write:
+ * @writer: a writer.
+ * @data: data to write.
+ * @length: length of @data.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Writes a section holding @data, padded to %G_SGRAPH_BINARY_ALIGNMENT.
+ *
+ * Returns: %TRUE on success, %FALSE if an error occured.
+ */
+gboolean
+_g_sgraph_binary_write (GSGraphBinaryWriter* writer,
+                        gconstpointer data,
+                        gsize length,
+                        GError** error)
+{
+  return (_g_sgraph_binary_write_raw (writer, data, length, error) &&
+          _g_sgraph_binary_write_padding (writer, error));
+}
+
+/**
+ * _g_sgraph_binary_write_payloads:
+ * @writer: a writer.
+ * @data: array of data to serialize.
+ * @count: length of @data.
+ * @save_func: function serializing data.
+ * @user_data: data passed to @save_func.
+ * @payloads_length: return location for length of payloads blob.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Writes a payloads section. Every element of @data is serialized with
+ * @save_func and written right away, so all payloads are never held in memory
+ * at once.
+ *
+ * Returns: %TRUE on success, %FALSE if an error occured.
+ */
+gboolean
+_g_sgraph_binary_write_payloads (GSGraphBinaryWriter* writer,
+                                 gpointer* data,
+                                 guint32 count,
+                                 GSGraphBinarySaveFunc save_func,
+                                 gpointer user_data,
+                                 guint64* payloads_length,
+                                 GError** error)
+{
+  GString* buffer;
+  guint64* offsets;
+  gboolean result;
+  guint32 iter;
+
+  buffer = g_string_new (NULL);
+  offsets = g_new (guint64, count + 1);
+  offsets[0] = 0;
+  result = TRUE;
+  for (iter = 0; result && (iter < count); ++iter)
+  {
+    g_string_truncate (buffer, 0);
+    (*save_func) (data[iter], buffer, user_data);
+    offsets[iter + 1] = offsets[iter] + buffer->len;
+    result = _g_sgraph_binary_write_raw (writer,
+                                         buffer->str,
+                                         buffer->len,
+                                         error);
+  }
+
+  if (result)
+  {
+    *payloads_length = offsets[count];
+    result = (_g_sgraph_binary_write_padding (writer, error) &&
+              _g_sgraph_binary_write (writer,
+                                      offsets,
+                                      sizeof (guint64) * (count + 1),
+                                      error));
+  }
+
+  g_free (offsets);
+  g_string_free (buffer, TRUE);
+  return result;
+}
+
+/**
+ * _g_sgraph_binary_writer_close:
+ * @writer: a writer.
+ * @header: a header of written file.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Writes @header at the beginning of the file and closes it. If an error
+ * occurs, the file is removed.
+ *
+ * Returns: %TRUE on success, %FALSE if an error occured.
+ */
+gboolean
+_g_sgraph_binary_writer_close (GSGraphBinaryWriter* writer,
+                               const GSGraphBinaryHeader* header,
+                               GError** error)
+{
+  if (fseek (writer->file, 0, SEEK_SET) ||
+      (fwrite (header, sizeof (GSGraphBinaryHeader), 1, writer->file) != 1) ||
+      fflush (writer->file))
+  {
+    _g_sgraph_binary_set_file_error (writer, error);
+    _g_sgraph_binary_writer_abort (writer);
+    return FALSE;
+  }
+
+  if (fclose (writer->file))
+  {
+    writer->file = NULL;
+    _g_sgraph_binary_set_file_error (writer, error);
+    g_remove (writer->filename);
+    return FALSE;
+  }
+  writer->file = NULL;
+  return TRUE;
+}
+
+/**
+ * _g_sgraph_binary_writer_abort:
+ * @writer: a writer.
+ *
+ * Closes and removes the file being written.
+ */
+void
+_g_sgraph_binary_writer_abort (GSGraphBinaryWriter* writer)
+{
+  if (writer->file)
+  {
+    fclose (writer->file);
+    writer->file = NULL;
+  }
+  g_remove (writer->filename);
+}
+
+/**
+ * _g_sgraph_binary_header_init:
+ * @header: a header to initialize.
+ * @magic: 8 bytes identifying kind of graph.
+ *
+ * Fills @header with @magic, current version and byte order mark. Other
+ * fields are zeroed.
+ */
+void
+_g_sgraph_binary_header_init (GSGraphBinaryHeader* header,
+                              const gchar* magic)
+{
+  memset (header, 0, sizeof (GSGraphBinaryHeader));
+  memcpy (header->magic, magic, sizeof (header->magic));
+  header->version = G_SGRAPH_BINARY_VERSION;
+  header->byte_order_mark = G_SGRAPH_BINARY_BYTE_ORDER_MARK;
+}
+
+/**
+ * _g_sgraph_binary_reader_init:
+ * @reader: a reader to initialize.
+ * @contents: contents of a file.
+ * @length: length of @contents.
+ * @magic: 8 bytes identifying expected kind of graph.
+ * @domain: error domain of errors to set.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Checks header of a file and prepares @reader for reading sections following
+ * it. @contents must be aligned to %G_SGRAPH_BINARY_ALIGNMENT, which is always
+ * true for mapped files.
+ *
+ * Returns: header of a file or %NULL if an error occured.
+ */
+const GSGraphBinaryHeader*
+_g_sgraph_binary_reader_init (GSGraphBinaryReader* reader,
+                              const gchar* contents,
+                              gsize length,
+                              const gchar* magic,
+                              GQuark domain,
+                              GError** error)
+{
+  const GSGraphBinaryHeader* header;
+
+  if (!contents || (length < sizeof (GSGraphBinaryHeader)))
+  {
+    g_set_error (error, domain, G_SGRAPH_BINARY_ERROR_FORMAT,
+                 "File is too short to be a graph file.");
+    return NULL;
+  }
+
+  header = (const GSGraphBinaryHeader*)contents;
+  if (memcmp (header->magic, magic, sizeof (header->magic)))
+  {
+    g_set_error (error, domain, G_SGRAPH_BINARY_ERROR_FORMAT,
+                 "File does not hold a graph of expected kind.");
+    return NULL;
+  }
+  if (header->byte_order_mark ==
+      GUINT32_SWAP_LE_BE (G_SGRAPH_BINARY_BYTE_ORDER_MARK))
+  {
+    g_set_error (error, domain, G_SGRAPH_BINARY_ERROR_BYTE_ORDER,
+                 "File was written on a machine with different byte order.");
+    return NULL;
+  }
+  if (header->byte_order_mark != G_SGRAPH_BINARY_BYTE_ORDER_MARK)
+  {
+    g_set_error (error, domain, G_SGRAPH_BINARY_ERROR_FORMAT,
+                 "File has broken header.");
+    return NULL;
+  }
+  if (header->version != G_SGRAPH_BINARY_VERSION)
+  {
+    g_set_error (error, domain, G_SGRAPH_BINARY_ERROR_VERSION,
+                 "File has version %u, only version %u is supported.",
+                 header->version, G_SGRAPH_BINARY_VERSION);
+    return NULL;
+  }
+
+  reader->contents = contents;
+  reader->length = length;
+  reader->position = sizeof (GSGraphBinaryHeader);
+  return header;
+}
+
+/**
+ * _g_sgraph_binary_read:
+ * @reader: a reader.
+ * @length: length of a section.
+ *
+ * Gets next section of a file.
+ *
+ * Returns: beginning of a section or %NULL if file is too short.
+ */
+gconstpointer
+_g_sgraph_binary_read (GSGraphBinaryReader* reader,
+                       guint64 length)
+{
+  gconstpointer section;
+  guint64 padded;
+
+  if (length > reader->length - reader->position)
+  {
+    return NULL;
+  }
+  section = reader->contents + reader->position;
+  padded = length + G_SGRAPH_BINARY_ALIGNMENT - 1;
+  padded -= padded % G_SGRAPH_BINARY_ALIGNMENT;
+  reader->position += MIN (padded, reader->length - reader->position);
+  return section;
+}
+
+/**
+ * _g_sgraph_binary_read_payloads:
+ * @reader: a reader.
+ * @count: number of elements.
+ * @payloads_length: length of payloads blob.
+ * @payloads: return location for payloads blob.
+ * @offsets: return location for @count + 1 offsets into @payloads.
+ *
+ * Gets a payloads section and checks its offsets.
+ *
+ * Returns: %TRUE if section is valid, otherwise %FALSE.
+ */
+gboolean
+_g_sgraph_binary_read_payloads (GSGraphBinaryReader* reader,
+                                guint32 count,
+                                guint64 payloads_length,
+                                const gchar** payloads,
+                                const guint64** offsets)
+{
+  guint32 iter;
+
+  *payloads = _g_sgraph_binary_read (reader, payloads_length);
+  *offsets = _g_sgraph_binary_read (reader,
+                                    sizeof (guint64) * ((guint64)count + 1));
+  if (!*payloads || !*offsets || (*offsets)[0])
+  {
+    return FALSE;
+  }
+  for (iter = 0; iter < count; ++iter)
+  {
+    if ((*offsets)[iter] > (*offsets)[iter + 1])
+    {
+      return FALSE;
+    }
+  }
+  return ((*offsets)[count] == payloads_length);
+}
+
+/**
+ * _g_sgraph_binary_check_offsets:
+ * @offsets: array of @count + 1 offsets.
+ * @count: number of ranges.
+ * @entries: length of array @offsets point into.
+ *
+ * Checks if @offsets describe @count consecutive ranges covering whole array
+ * of @entries elements.
+ *
+ * Returns: %TRUE if @offsets are valid, otherwise %FALSE.
+ */
+gboolean
+_g_sgraph_binary_check_offsets (const guint32* offsets,
+                                guint32 count,
+                                guint32 entries)
+{
+  guint32 iter;
+
+  if (offsets[0])
+  {
+    return FALSE;
+  }
+  for (iter = 0; iter < count; ++iter)
+  {
+    if (offsets[iter] > offsets[iter + 1])
+    {
+      return FALSE;
+    }
+  }
+  return (offsets[count] == entries);
+}
+
+/**
+ * _g_sgraph_binary_check_indices:
+ * @indices: array of indices.
+ * @count: length of @indices.
+ * @limit: upper bound of indices (exclusive).
+ * @allow_none: whether %G_MAXUINT32 is allowed as no index.
+ *
+ * Checks if all @indices are in bounds.
+ *
+ * Returns: %TRUE if @indices are valid, otherwise %FALSE.
+ */
+gboolean
+_g_sgraph_binary_check_indices (const guint32* indices,
+                                guint32 count,
+                                guint32 limit,
+                                gboolean allow_none)
+{
+  guint32 iter;
+
+  for (iter = 0; iter < count; ++iter)
+  {
+    if ((indices[iter] >= limit) &&
+        (!allow_none || (indices[iter] != G_MAXUINT32)))
+    {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
+/* static function definitions. */
+
+/**
+ * _g_sgraph_binary_write_raw:
+ * @writer: a writer.
+ * @data: data to write.
+ * @length: length of @data.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Writes @length bytes of @data without any padding and counts them as
+ * written.
+ *
+ * Returns: %TRUE on success, %FALSE if an error occured.
+ */
+static gboolean
+_g_sgraph_binary_write_raw (GSGraphBinaryWriter* writer,
+                            gconstpointer data,
+                            gsize length,
+                            GError** error)
+{
+  if (length && (fwrite (data, 1, length, writer->file) != length))
+  {
+    _g_sgraph_binary_set_file_error (writer, error);
+    return FALSE;
+  }
+  writer->written += length;
+  return TRUE;
+}
+
+/**
+ * _g_sgraph_binary_write_padding:
+ * @writer: a writer.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Writes zeros until number of written bytes is a multiple of
+ * %G_SGRAPH_BINARY_ALIGNMENT.
+ *
+ * Returns: %TRUE on success, %FALSE if an error occured.
+ */
+static gboolean
+_g_sgraph_binary_write_padding (GSGraphBinaryWriter* writer,
+                                GError** error)
+{
+  static const gchar zeros[G_SGRAPH_BINARY_ALIGNMENT] = {0};
+  gsize padding;
+
+  padding = writer->written % G_SGRAPH_BINARY_ALIGNMENT;
+  if (padding)
+  {
+    padding = G_SGRAPH_BINARY_ALIGNMENT - padding;
+  }
+  return _g_sgraph_binary_write_raw (writer, zeros, padding, error);
+}
+
+/**
+ * _g_sgraph_binary_set_file_error:
+ * @writer: a writer.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Sets @error to a #G_FILE_ERROR describing current errno.
+ */
+static void
+_g_sgraph_binary_set_file_error (GSGraphBinaryWriter* writer,
+                                 GError** error)
+{
+  gint saved_errno;
+
+  saved_errno = errno;
+  g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (saved_errno),
+               "Could not write `%s': %s", writer->filename,
+               g_strerror (saved_errno));
+}
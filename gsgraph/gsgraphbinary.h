@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "This is a private header, it must not be included outside libggraph."
+#endif
+
+#ifndef _G_SGRAPH_BINARY_H_
+#define _G_SGRAPH_BINARY_H_
+
+#include <stdio.h>
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* version of binary format, bumped on every incompatible change. */
+#define G_SGRAPH_BINARY_VERSION 1
+
+/* written in native byte order, so loader can tell if it matches. */
+#define G_SGRAPH_BINARY_BYTE_ORDER_MARK 0x01020304
+
+/* all sections start at offsets being multiples of this. */
+#define G_SGRAPH_BINARY_ALIGNMENT 8
+
+/**
+ * GSGraphBinaryFlags:
+ * @G_SGRAPH_BINARY_NODE_PAYLOADS: file holds node payloads.
+ * @G_SGRAPH_BINARY_EDGE_PAYLOADS: file holds edge payloads.
+ *
+ * Internal flags of binary file header.
+ */
+typedef enum
+{
+  G_SGRAPH_BINARY_NODE_PAYLOADS = 1 << 0,
+  G_SGRAPH_BINARY_EDGE_PAYLOADS = 1 << 1
+} GSGraphBinaryFlags;
+
+/**
+ * GSGraphBinaryError:
+ * @G_SGRAPH_BINARY_ERROR_FORMAT: file is not a graph file or it is damaged.
+ * @G_SGRAPH_BINARY_ERROR_VERSION: file has unsupported version.
+ * @G_SGRAPH_BINARY_ERROR_BYTE_ORDER: file was written on a machine with
+ * different byte order.
+ *
+ * Internal error codes, the same as codes of public errors of both graph
+ * kinds.
+ */
+typedef enum
+{
+  G_SGRAPH_BINARY_ERROR_FORMAT,
+  G_SGRAPH_BINARY_ERROR_VERSION,
+  G_SGRAPH_BINARY_ERROR_BYTE_ORDER
+} GSGraphBinaryError;
+
+/**
+ * GSGraphBinaryHeader:
+ * @magic: identifies kind of graph.
+ * @version: version of format.
+ * @byte_order_mark: %G_SGRAPH_BINARY_BYTE_ORDER_MARK in byte order of writer.
+ * @order: number of nodes.
+ * @size: number of connections or edges.
+ * @entries: length of adjacency array.
+ * @flags: #GSGraphBinaryFlags.
+ * @node_payloads_length: length of node payloads blob.
+ * @edge_payloads_length: length of edge payloads blob.
+ *
+ * Internal header starting every binary graph file. It is followed by
+ * sections, each padded to %G_SGRAPH_BINARY_ALIGNMENT bytes. A payloads
+ * section is a blob of all payloads followed by #guint64 offsets into it, one
+ * more than number of elements.
+ */
+typedef struct _GSGraphBinaryHeader GSGraphBinaryHeader;
+
+struct _GSGraphBinaryHeader
+{
+  gchar magic[8];
+  guint32 version;
+  guint32 byte_order_mark;
+  guint32 order;
+  guint32 size;
+  guint32 entries;
+  guint32 flags;
+  guint64 node_payloads_length;
+  guint64 edge_payloads_length;
+};
+
+/**
+ * GSGraphBinarySaveFunc:
+ * @data: data to save.
+ * @buffer: buffer to append serialized @data to.
+ * @user_data: user data.
+ *
+ * Internal type of payload serializing functions.
+ */
+typedef void (*GSGraphBinarySaveFunc) (gpointer data,
+                                       GString* buffer,
+                                       gpointer user_data);
+
+/**
+ * GSGraphBinaryWriter:
+ * @file: file being written.
+ * @filename: name of @file.
+ * @written: number of bytes written so far.
+ *
+ * Internal state of binary file writing.
+ */
+typedef struct _GSGraphBinaryWriter GSGraphBinaryWriter;
+
+struct _GSGraphBinaryWriter
+{
+  FILE* file;
+  const gchar* filename;
+  guint64 written;
+};
+
+/**
+ * GSGraphBinaryReader:
+ * @contents: contents of a file.
+ * @length: length of @contents.
+ * @position: position of next section.
+ *
+ * Internal state of binary file reading.
+ */
+typedef struct _GSGraphBinaryReader GSGraphBinaryReader;
+
+struct _GSGraphBinaryReader
+{
+  const gchar* contents;
+  gsize length;
+  gsize position;
+};
+
+G_GNUC_INTERNAL gboolean
+_g_sgraph_binary_writer_open (GSGraphBinaryWriter* writer,
+                              const gchar* filename,
+                              GError** error);
+
+G_GNUC_INTERNAL gboolean
+_g_sgraph_binary_write (GSGraphBinaryWriter* writer,
+                        gconstpointer data,
+                        gsize length,
+                        GError** error);
+
+G_GNUC_INTERNAL gboolean
+_g_sgraph_binary_write_payloads (GSGraphBinaryWriter* writer,
+                                 gpointer* data,
+                                 guint32 count,
+                                 GSGraphBinarySaveFunc save_func,
+                                 gpointer user_data,
+                                 guint64* payloads_length,
+                                 GError** error);
+
+G_GNUC_INTERNAL gboolean
+_g_sgraph_binary_writer_close (GSGraphBinaryWriter* writer,
+                               const GSGraphBinaryHeader* header,
+                               GError** error);
+
+G_GNUC_INTERNAL void
+_g_sgraph_binary_writer_abort (GSGraphBinaryWriter* writer);
+
+G_GNUC_INTERNAL void
+_g_sgraph_binary_header_init (GSGraphBinaryHeader* header,
+                              const gchar* magic);
+
+G_GNUC_INTERNAL const GSGraphBinaryHeader*
+_g_sgraph_binary_reader_init (GSGraphBinaryReader* reader,
+                              const gchar* contents,
+                              gsize length,
+                              const gchar* magic,
+                              GQuark domain,
+                              GError** error);
+
+G_GNUC_INTERNAL gconstpointer
+_g_sgraph_binary_read (GSGraphBinaryReader* reader,
+                       guint64 length);
+
+G_GNUC_INTERNAL gboolean
+_g_sgraph_binary_read_payloads (GSGraphBinaryReader* reader,
+                                guint32 count,
+                                guint64 payloads_length,
+                                const gchar** payloads,
+                                const guint64** offsets);
+
+G_GNUC_INTERNAL gboolean
+_g_sgraph_binary_check_offsets (const guint32* offsets,
+                                guint32 count,
+                                guint32 entries);
+
+G_GNUC_INTERNAL gboolean
+_g_sgraph_binary_check_indices (const guint32* indices,
+                                guint32 count,
+                                guint32 limit,
+                                gboolean allow_none);
+
+G_END_DECLS
+
+#endif /* _G_SGRAPH_BINARY_H_ */
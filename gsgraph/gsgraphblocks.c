@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsgraphblocks.h"
+
+/* Internal block allocator. Elements are handed out from blocks holding
+ * G_SGRAPH_BLOCKS_LENGTH elements each, so allocating many small structures
+ * costs one malloc per block and freeing them costs one free per block.
+ * Released elements are kept in a list threaded through their first pointer
+ * and are handed out again before the last block is used further.
+ */
+
+/* internal macros */
+
+/**
+ * G_SGRAPH_BLOCKS_LENGTH:
+ *
+ * Number of elements in one block.
+ */
+#define G_SGRAPH_BLOCKS_LENGTH 1024
+
+/* function definitions. */
+
+/**
+ * _g_sgraph_blocks_init:
+ * @blocks: an allocator.
+ * @element_size: size of single element, at least size of a pointer.
+ *
+ * Initializes empty allocator.
+ */
+void
+_g_sgraph_blocks_init (GSGraphBlocks* blocks,
+                       gsize element_size)
+{
+  blocks->blocks = g_ptr_array_new ();
+  blocks->element_size = element_size;
+  blocks->used = G_SGRAPH_BLOCKS_LENGTH;
+  blocks->free_list = NULL;
+  blocks->count = 0;
+}
+
+/**
+ * _g_sgraph_blocks_clear:
+ * @blocks: an allocator.
+ *
+ * Frees all blocks at once. All elements handed out by @blocks become invalid.
+ */
+void
+_g_sgraph_blocks_clear (GSGraphBlocks* blocks)
+{
+  guint iter;
+
+  for (iter = 0; iter < blocks->blocks->len; ++iter)
+  {
+    g_free (g_ptr_array_index (blocks->blocks, iter));
+  }
+  g_ptr_array_free (blocks->blocks, TRUE);
+  blocks->blocks = NULL;
+  blocks->free_list = NULL;
+  blocks->count = 0;
+}
+
+/**
+ * _g_sgraph_blocks_alloc:
+ * @blocks: an allocator.
+ *
+ * Hands out an uninitialized element. Released elements are reused first.
+ *
+ * Returns: pointer to an element.
+ */
+gpointer
+_g_sgraph_blocks_alloc (GSGraphBlocks* blocks)
+{
+  gpointer element;
+
+  if (blocks->free_list)
+  {
+    element = blocks->free_list;
+    blocks->free_list = *(gpointer*)element;
+  }
+  else
+  {
+    if (blocks->used == G_SGRAPH_BLOCKS_LENGTH)
+    {
+      g_ptr_array_add (blocks->blocks,
+                       g_malloc (blocks->element_size *
+                                 G_SGRAPH_BLOCKS_LENGTH));
+      blocks->used = 0;
+    }
+    element = (gchar*)g_ptr_array_index (blocks->blocks,
+                                         blocks->blocks->len - 1) +
+              blocks->element_size * blocks->used;
+    ++blocks->used;
+  }
+  ++blocks->count;
+
+  return element;
+}
+
+/**
+ * _g_sgraph_blocks_release:
+ * @blocks: an allocator.
+ * @element: an element handed out by @blocks.
+ *
+ * Gives @element back to @blocks, so it can be handed out again. Only first
+ * pointer in @element is overwritten.
+ */
+void
+_g_sgraph_blocks_release (GSGraphBlocks* blocks,
+                          gpointer element)
+{
+  *(gpointer*)element = blocks->free_list;
+  blocks->free_list = element;
+  --blocks->count;
+}
+
+/**
+ * _g_sgraph_blocks_foreach:
+ * @blocks: an allocator.
+ * @func: function to call.
+ * @user_data: data passed to @func.
+ *
+ * Calls @func on every element ever handed out by @blocks, including released
+ * ones. Telling them apart is up to caller.
+ */
+void
+_g_sgraph_blocks_foreach (GSGraphBlocks* blocks,
+                          GFunc func,
+                          gpointer user_data)
+{
+  guint iter;
+
+  for (iter = 0; iter < blocks->blocks->len; ++iter)
+  {
+    gchar* block;
+    guint length;
+    guint iter2;
+
+    block = g_ptr_array_index (blocks->blocks, iter);
+    length = (iter + 1 == blocks->blocks->len) ? blocks->used :
+                                                 G_SGRAPH_BLOCKS_LENGTH;
+    for (iter2 = 0; iter2 < length; ++iter2)
+    {
+      (*func) (block + blocks->element_size * iter2, user_data);
+    }
+  }
+}
+
+/**
+ * _g_sgraph_blocks_get_reserved_size:
+ * @blocks: an allocator.
+ *
+ * Gets number of bytes reserved by @blocks for elements.
+ *
+ * Returns: reserved size.
+ */
+gsize
+_g_sgraph_blocks_get_reserved_size (GSGraphBlocks* blocks)
+{
+  return (gsize)blocks->blocks->len * G_SGRAPH_BLOCKS_LENGTH *
+         blocks->element_size;
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "This is a private header, it must not be included outside libggraph."
+#endif
+
+#ifndef _G_SGRAPH_BLOCKS_H_
+#define _G_SGRAPH_BLOCKS_H_
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GSGraphBlocks:
+ * @blocks: #GPtrArray of blocks of memory.
+ * @element_size: size of single element.
+ * @used: number of elements handed out from last block.
+ * @free_list: linked list of released elements.
+ * @count: number of elements in use.
+ *
+ * Internal allocator handing out elements of the same size from big blocks of
+ * memory. Released elements are reused and all blocks are freed at once.
+ */
+typedef struct _GSGraphBlocks GSGraphBlocks;
+
+struct _GSGraphBlocks
+{
+  GPtrArray* blocks;
+  gsize element_size;
+  guint used;
+  gpointer free_list;
+  guint count;
+};
+
+G_GNUC_INTERNAL void
+_g_sgraph_blocks_init (GSGraphBlocks* blocks,
+                       gsize element_size);
+
+G_GNUC_INTERNAL void
+_g_sgraph_blocks_clear (GSGraphBlocks* blocks);
+
+G_GNUC_INTERNAL gpointer
+_g_sgraph_blocks_alloc (GSGraphBlocks* blocks);
+
+G_GNUC_INTERNAL void
+_g_sgraph_blocks_release (GSGraphBlocks* blocks,
+                          gpointer element);
+
+G_GNUC_INTERNAL void
+_g_sgraph_blocks_foreach (GSGraphBlocks* blocks,
+                          GFunc func,
+                          gpointer user_data);
+
+G_GNUC_INTERNAL gsize
+_g_sgraph_blocks_get_reserved_size (GSGraphBlocks* blocks);
+
+G_END_DECLS
+
+#endif /* _G_SGRAPH_BLOCKS_H_ */
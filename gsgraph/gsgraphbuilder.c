@@ -0,0 +1,961 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "gsgraphbuilder.h"
+#include "gsgraphsnapshotprivate.h"
+
+#include "gsgraphdisjointset.h"
+#include "gsgraphdataindex.h"
+
+/**
+ * SECTION: gsgraphbuilder
+ * @title: Simple graph builder
+ * @short_description: incremental construction of graphs from pairs.
+ * @include: gsgraph/gsgraph.h
+ * @see_also: #GSGraphSnapshot, #GSGraphEdgeListFormat
+ *
+ * Builds graphs from pairs of node data fed one at a time, so there is no need
+ * to create an array of #GSGraphDataPair<!-- -->s first. Nodes are created
+ * when their data are seen for the first time and pairs are connected right
+ * away, so memory used during construction is the graph itself and a map of
+ * data to nodes. Result is the same as result of g_sgraph_snapshot_new() for
+ * the same pairs.
+ *
+ * To create a builder, use g_sgraph_builder_new() or
+ * g_sgraph_builder_new_in_arena().
+ *
+ * To feed it with pairs, use g_sgraph_builder_add_pair().
+ *
+ * To read pairs from an edge list, use g_sgraph_builder_load_file() or
+ * g_sgraph_builder_load_channel(). Edge list is read in fixed-size chunks and
+ * parsed as it comes, so it is never held in memory as a whole.
+ *
+ * To find a node created so far, use g_sgraph_builder_lookup_node().
+ *
+ * To get created graphs, use g_sgraph_builder_finish(). To drop them instead,
+ * use g_sgraph_builder_free().
+ */
+
+/* internal macros */
+
+/* size of chunks edge lists are read in. */
+#define G_SGRAPH_BUILDER_CHUNK_SIZE 65536
+
+/* size of a pair in binary edge list. */
+#define G_SGRAPH_BUILDER_PAIR_SIZE (2 * sizeof (guint32))
+
+/* internal types. */
+
+struct _GSGraphBuilder
+{
+  GSGraphArena* arena;
+  GPtrArray* nodes;
+  GHashTable* data_to_indices;
+  GSGraphDisjointSet* components;
+  GHashFunc hash_func;
+  GEqualFunc key_equal_func;
+};
+
+/**
+ * GSGraphBuilderLoad:
+ * @builder: a builder pairs are fed to.
+ * @format: format of edge list.
+ * @pending: part of a line or a pair carried over to next chunk.
+ * @key: buffer for a string key.
+ * @line_number: number of lines read so far.
+ *
+ * Internal state of edge list loading.
+ */
+typedef struct _GSGraphBuilderLoad GSGraphBuilderLoad;
+
+struct _GSGraphBuilderLoad
+{
+  GSGraphBuilder* builder;
+  GSGraphEdgeListFormat format;
+  GString* pending;
+  GString* key;
+  guint line_number;
+};
+
+/* static function declarations. */
+
+static GSGraphBuilder*
+_g_sgraph_builder_new_general (GSGraphArena* arena,
+                               GHashFunc hash_func,
+                               GEqualFunc key_equal_func);
+
+static void
+_g_sgraph_builder_clear (GSGraphBuilder* builder);
+
+static guint
+_g_sgraph_builder_get_node_index (GSGraphBuilder* builder,
+                                  gpointer data);
+
+static void
+_g_sgraph_builder_connect (GSGraphBuilder* builder,
+                           guint first_index,
+                           guint second_index);
+
+static gboolean
+_g_sgraph_builder_load_chunk (GSGraphBuilderLoad* load,
+                              const gchar* chunk,
+                              gsize length,
+                              GError** error);
+
+static gboolean
+_g_sgraph_builder_load_end (GSGraphBuilderLoad* load,
+                            GError** error);
+
+static gboolean
+_g_sgraph_builder_load_pairs (GSGraphBuilderLoad* load,
+                              const gchar* chunk,
+                              gsize length);
+
+static gboolean
+_g_sgraph_builder_load_lines (GSGraphBuilderLoad* load,
+                              const gchar* chunk,
+                              gsize length,
+                              GError** error);
+
+static gboolean
+_g_sgraph_builder_load_line (GSGraphBuilderLoad* load,
+                             const gchar* line,
+                             gsize length,
+                             GError** error);
+
+static gboolean
+_g_sgraph_builder_load_key (GSGraphBuilderLoad* load,
+                            const gchar* key,
+                            gsize length,
+                            guint* index,
+                            GError** error);
+
+static gboolean
+_g_sgraph_builder_is_separator (gchar c);
+
+/* public function definitions. */
+
+/**
+ * g_sgraph_builder_error_quark:
+ *
+ * Gets the error domain of edge list loading.
+ *
+ * Returns: error quark.
+ */
+GQuark
+g_sgraph_builder_error_quark (void)
+{
+  return g_quark_from_static_string ("g-sgraph-builder-error-quark");
+}
+
+/**
+ * g_sgraph_builder_new:
+ * @hash_func: a function hashing node data or %NULL.
+ * @key_equal_func: a function comparing node data or %NULL.
+ *
+ * Creates new builder. Pairs with equal data are connecting the same nodes.
+ * If @hash_func and @key_equal_func are %NULL, data are compared directly,
+ * like in g_sgraph_snapshot_new().
+ *
+ * Returns: new #GSGraphBuilder.
+ */
+GSGraphBuilder*
+g_sgraph_builder_new (GHashFunc hash_func,
+                      GEqualFunc key_equal_func)
+{
+  return _g_sgraph_builder_new_general (NULL, hash_func, key_equal_func);
+}
+
+/**
+ * g_sgraph_builder_new_in_arena:
+ * @arena: an arena.
+ * @hash_func: a function hashing node data or %NULL.
+ * @key_equal_func: a function comparing node data or %NULL.
+ *
+ * Does the same as g_sgraph_builder_new(), but memory for nodes is taken from
+ * @arena.
+ *
+ * Returns: new #GSGraphBuilder.
+ */
+GSGraphBuilder*
+g_sgraph_builder_new_in_arena (GSGraphArena* arena,
+                               GHashFunc hash_func,
+                               GEqualFunc key_equal_func)
+{
+  g_return_val_if_fail (arena != NULL, NULL);
+
+  return _g_sgraph_builder_new_general (arena, hash_func, key_equal_func);
+}
+
+/**
+ * g_sgraph_builder_free:
+ * @builder: #GSGraphBuilder to free.
+ * @data_destroy_func: a function freeing node data or %NULL.
+ *
+ * Frees memory allocated to @builder together with all nodes created so far.
+ * If @data_destroy_func is not %NULL, it is called for data of every node.
+ */
+void
+g_sgraph_builder_free (GSGraphBuilder* builder,
+                       GDestroyNotify data_destroy_func)
+{
+  guint iter;
+
+  g_return_if_fail (builder != NULL);
+
+  for (iter = 0; iter < builder->nodes->len; ++iter)
+  {
+    gpointer data;
+
+    data = g_sgraph_node_free (g_ptr_array_index (builder->nodes, iter));
+    if (data_destroy_func)
+    {
+      (*data_destroy_func) (data);
+    }
+  }
+  g_hash_table_unref (builder->data_to_indices);
+  _g_sgraph_builder_clear (builder);
+}
+
+/**
+ * g_sgraph_builder_add_pair:
+ * @builder: a builder.
+ * @first: data of first node.
+ * @second: data of second node.
+ *
+ * Connects nodes holding @first and @second, creating them if needed. If
+ * @first and @second are equal, only a node is created, because simple graph
+ * has no loops.
+ */
+void
+g_sgraph_builder_add_pair (GSGraphBuilder* builder,
+                           gpointer first,
+                           gpointer second)
+{
+  guint first_index;
+  guint second_index;
+
+  g_return_if_fail (builder != NULL);
+
+  first_index = _g_sgraph_builder_get_node_index (builder, first);
+  second_index = _g_sgraph_builder_get_node_index (builder, second);
+  _g_sgraph_builder_connect (builder, first_index, second_index);
+}
+
+/**
+ * g_sgraph_builder_lookup_node:
+ * @builder: a builder.
+ * @data: data of a node.
+ *
+ * Finds a node holding @data among nodes created so far.
+ *
+ * Returns: found node or %NULL if there is none.
+ */
+GSGraphNode*
+g_sgraph_builder_lookup_node (GSGraphBuilder* builder,
+                              gconstpointer data)
+{
+  gpointer index;
+
+  g_return_val_if_fail (builder != NULL, NULL);
+
+  if (!g_hash_table_lookup_extended (builder->data_to_indices,
+                                     data,
+                                     NULL,
+                                     &index))
+  {
+    return NULL;
+  }
+  return g_ptr_array_index (builder->nodes, GPOINTER_TO_UINT (index));
+}
+
+/**
+ * g_sgraph_builder_get_order:
+ * @builder: a builder.
+ *
+ * Gets number of nodes created so far.
+ *
+ * Returns: number of nodes.
+ */
+guint
+g_sgraph_builder_get_order (GSGraphBuilder* builder)
+{
+  g_return_val_if_fail (builder != NULL, 0);
+
+  return builder->nodes->len;
+}
+
+/**
+ * g_sgraph_builder_finish:
+ * @builder: a builder.
+ *
+ * Splits created nodes into separate graphs and frees @builder. Separate
+ * graphs are ordered by first appearance of their nodes and nodes in each
+ * graph are in order of their creation. Each graph gets an index of its nodes
+ * by data, so they can be found with g_sgraph_snapshot_lookup_node().
+ *
+ * Returns: array of newly created separate graphs or %NULL if no nodes were
+ * created.
+ */
+GPtrArray*
+g_sgraph_builder_finish (GSGraphBuilder* builder)
+{
+  GPtrArray* separate_graphs;
+  GPtrArray* nodes;
+  GHashTable* data_to_indices;
+  GSGraphDisjointSet* components;
+  GSGraphSnapshot** roots_to_graphs;
+  GSGraphSnapshot* largest_graph;
+  guint largest_order;
+  guint iter;
+
+  g_return_val_if_fail (builder != NULL, NULL);
+
+  nodes = builder->nodes;
+  data_to_indices = builder->data_to_indices;
+  components = builder->components;
+  if (!nodes->len)
+  {
+    g_hash_table_unref (data_to_indices);
+    _g_sgraph_builder_clear (builder);
+    return NULL;
+  }
+
+  /* all components are known now, so each node is put into its graph. */
+  separate_graphs = g_ptr_array_new ();
+  roots_to_graphs = g_new0 (GSGraphSnapshot*, nodes->len);
+  largest_graph = NULL;
+  largest_order = 0;
+  for (iter = 0; iter < nodes->len; ++iter)
+  {
+    guint root;
+    GSGraphSnapshot* graph;
+
+    root = _g_sgraph_disjoint_set_find (components, iter);
+    graph = roots_to_graphs[root];
+    if (!graph)
+    {
+      guint order;
+
+      order = _g_sgraph_disjoint_set_get_set_size (components, root);
+      graph = _g_sgraph_snapshot_new_blank (order);
+      roots_to_graphs[root] = graph;
+      g_ptr_array_add (separate_graphs, graph);
+      if (order > largest_order)
+      {
+        largest_graph = graph;
+        largest_order = order;
+      }
+    }
+    g_ptr_array_add (graph->node_array, g_ptr_array_index (nodes, iter));
+  }
+
+  /* map of data used during construction becomes an index of the largest
+   * graph. Entries of other graphs are moved to their own indices. */
+  largest_graph->node_index =
+    _g_sgraph_data_index_new_from_table (data_to_indices);
+  for (iter = 0; iter < nodes->len; ++iter)
+  {
+    GSGraphNode* node;
+    GSGraphSnapshot* graph;
+
+    node = g_ptr_array_index (nodes, iter);
+    graph = roots_to_graphs[_g_sgraph_disjoint_set_find (components, iter)];
+    if (graph == largest_graph)
+    {
+      g_hash_table_insert (data_to_indices, node->data, node);
+    }
+    else
+    {
+      g_hash_table_remove (data_to_indices, node->data);
+      if (!graph->node_index)
+      {
+        GHashTable* table;
+
+        table = g_hash_table_new (builder->hash_func, builder->key_equal_func);
+        graph->node_index = _g_sgraph_data_index_new_from_table (table);
+      }
+      _g_sgraph_data_index_insert (graph->node_index, node->data, node);
+    }
+  }
+
+  g_free (roots_to_graphs);
+  _g_sgraph_builder_clear (builder);
+  return separate_graphs;
+}
+
+/**
+ * g_sgraph_builder_load_file:
+ * @builder: a builder.
+ * @filename: name of a file holding an edge list.
+ * @format: format of edge list.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Reads an edge list from @filename and feeds @builder with its pairs. See
+ * g_sgraph_builder_load_channel() for details.
+ *
+ * Returns: %TRUE on success, %FALSE if an error occured.
+ */
+gboolean
+g_sgraph_builder_load_file (GSGraphBuilder* builder,
+                            const gchar* filename,
+                            GSGraphEdgeListFormat format,
+                            GError** error)
+{
+  GIOChannel* channel;
+  gboolean result;
+
+  g_return_val_if_fail (builder != NULL, FALSE);
+  g_return_val_if_fail (filename != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  channel = g_io_channel_new_file (filename, "r", error);
+  if (!channel)
+  {
+    return FALSE;
+  }
+
+  result = ((g_io_channel_set_encoding (channel, NULL, error) ==
+             G_IO_STATUS_NORMAL) &&
+            g_sgraph_builder_load_channel (builder, channel, format, error));
+
+  g_io_channel_shutdown (channel, FALSE, NULL);
+  g_io_channel_unref (channel);
+  return result;
+}
+
+/**
+ * g_sgraph_builder_load_channel:
+ * @builder: a builder.
+ * @channel: a blocking channel with %NULL encoding.
+ * @format: format of edge list.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Reads an edge list from @channel until its end and feeds @builder with its
+ * pairs. Channel is read in fixed-size chunks and each chunk is parsed right
+ * away.
+ *
+ * Text edge lists hold a pair per line. Keys in a line are separated with
+ * whitespace or commas and anything after second key is ignored, so CSV files
+ * and lists with weights can be read too. Blank lines and lines starting with
+ * '#' or '%' are skipped. With %G_SGRAPH_EDGE_LIST_INTEGERS keys are decimal
+ * numbers and node data are keys converted with GUINT_TO_POINTER(), so
+ * @builder has to compare data directly. With %G_SGRAPH_EDGE_LIST_STRINGS
+ * node data are newly allocated copies of keys, which should be freed with
+ * g_free(), so @builder has to be created with g_str_hash() and g_str_equal().
+ *
+ * Binary edge lists are streams of pairs of #guint32 keys in native byte order
+ * and node data are created the same way as for
+ * %G_SGRAPH_EDGE_LIST_INTEGERS.
+ *
+ * If an error occurs, pairs read so far stay in @builder.
+ *
+ * Returns: %TRUE on success, %FALSE if an error occured.
+ */
+gboolean
+g_sgraph_builder_load_channel (GSGraphBuilder* builder,
+                               GIOChannel* channel,
+                               GSGraphEdgeListFormat format,
+                               GError** error)
+{
+  GSGraphBuilderLoad load;
+  GIOStatus status;
+  gchar* chunk;
+  gboolean result;
+
+  g_return_val_if_fail (builder != NULL, FALSE);
+  g_return_val_if_fail (channel != NULL, FALSE);
+  g_return_val_if_fail ((format == G_SGRAPH_EDGE_LIST_INTEGERS) ||
+                        (format == G_SGRAPH_EDGE_LIST_STRINGS) ||
+                        (format == G_SGRAPH_EDGE_LIST_BINARY), FALSE);
+  g_return_val_if_fail ((format == G_SGRAPH_EDGE_LIST_STRINGS) ==
+                        (builder->key_equal_func == g_str_equal), FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  load.builder = builder;
+  load.format = format;
+  load.pending = g_string_new (NULL);
+  load.key = g_string_new (NULL);
+  load.line_number = 0;
+
+  chunk = g_new (gchar, G_SGRAPH_BUILDER_CHUNK_SIZE);
+  result = TRUE;
+  do
+  {
+    gsize length;
+
+    length = 0;
+    status = g_io_channel_read_chars (channel,
+                                      chunk,
+                                      G_SGRAPH_BUILDER_CHUNK_SIZE,
+                                      &length,
+                                      error);
+    if ((status == G_IO_STATUS_ERROR) ||
+        !_g_sgraph_builder_load_chunk (&load, chunk, length, error))
+    {
+      result = FALSE;
+      break;
+    }
+  }
+  while (status != G_IO_STATUS_EOF);
+
+  if (result)
+  {
+    result = _g_sgraph_builder_load_end (&load, error);
+  }
+
+  g_free (chunk);
+  g_string_free (load.pending, TRUE);
+  g_string_free (load.key, TRUE);
+  return result;
+}
+
+/* static function definitions. */
+
+/**
+ * _g_sgraph_builder_new_general:
+ * @arena: an arena or %NULL.
+ * @hash_func: a function hashing node data or %NULL.
+ * @key_equal_func: a function comparing node data or %NULL.
+ *
+ * Creates new builder. If @arena is not %NULL, memory for nodes is taken from
+ * it.
+ *
+ * Returns: new #GSGraphBuilder.
+ */
+static GSGraphBuilder*
+_g_sgraph_builder_new_general (GSGraphArena* arena,
+                               GHashFunc hash_func,
+                               GEqualFunc key_equal_func)
+{
+  GSGraphBuilder* builder;
+
+  builder = g_slice_new (GSGraphBuilder);
+  builder->arena = arena;
+  builder->nodes = g_ptr_array_new ();
+  builder->data_to_indices = g_hash_table_new (hash_func, key_equal_func);
+  builder->components = _g_sgraph_disjoint_set_new (0);
+  builder->hash_func = hash_func;
+  builder->key_equal_func = key_equal_func;
+
+  return builder;
+}
+
+/**
+ * _g_sgraph_builder_clear:
+ * @builder: a builder.
+ *
+ * Frees memory allocated to @builder, except nodes and map of data.
+ */
+static void
+_g_sgraph_builder_clear (GSGraphBuilder* builder)
+{
+  g_ptr_array_free (builder->nodes, TRUE);
+  _g_sgraph_disjoint_set_free (builder->components);
+  g_slice_free (GSGraphBuilder, builder);
+}
+
+/**
+ * _g_sgraph_builder_get_node_index:
+ * @builder: a builder.
+ * @data: data of a node.
+ *
+ * Gets an index of node holding @data. If there is no such node yet, it is
+ * created, put at the end of nodes array and added to components as a
+ * separate component.
+ *
+ * Returns: index of node holding @data.
+ */
+static guint
+_g_sgraph_builder_get_node_index (GSGraphBuilder* builder,
+                                  gpointer data)
+{
+  gpointer index;
+
+  if (!g_hash_table_lookup_extended (builder->data_to_indices,
+                                     data,
+                                     NULL,
+                                     &index))
+  {
+    index = GUINT_TO_POINTER (_g_sgraph_disjoint_set_add (builder->components));
+    if (builder->arena)
+    {
+      g_ptr_array_add (builder->nodes,
+                       g_sgraph_node_new_in_arena (builder->arena, data));
+    }
+    else
+    {
+      g_ptr_array_add (builder->nodes, g_sgraph_node_new (data));
+    }
+    g_hash_table_insert (builder->data_to_indices, data, index);
+  }
+
+  return GPOINTER_TO_UINT (index);
+}
+
+/**
+ * _g_sgraph_builder_connect:
+ * @builder: a builder.
+ * @first_index: index of first node.
+ * @second_index: index of second node.
+ *
+ * Connects nodes with given indices and joins their components. Loops are
+ * skipped.
+ */
+static void
+_g_sgraph_builder_connect (GSGraphBuilder* builder,
+                           guint first_index,
+                           guint second_index)
+{
+  if (first_index == second_index)
+  {
+    return;
+  }
+
+  g_sgraph_node_connect (g_ptr_array_index (builder->nodes, first_index),
+                         g_ptr_array_index (builder->nodes, second_index));
+  _g_sgraph_disjoint_set_union (builder->components,
+                                first_index,
+                                second_index);
+}
+
+/**
+ * _g_sgraph_builder_load_chunk:
+ * @load: state of loading.
+ * @chunk: a chunk of edge list.
+ * @length: length of @chunk.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Parses @chunk according to format of edge list.
+ *
+ * Returns: %TRUE on success, %FALSE if @chunk is malformed.
+ */
+static gboolean
+_g_sgraph_builder_load_chunk (GSGraphBuilderLoad* load,
+                              const gchar* chunk,
+                              gsize length,
+                              GError** error)
+{
+  if (load->format == G_SGRAPH_EDGE_LIST_BINARY)
+  {
+    return _g_sgraph_builder_load_pairs (load, chunk, length);
+  }
+  return _g_sgraph_builder_load_lines (load, chunk, length, error);
+}
+
+/**
+ * _g_sgraph_builder_load_end:
+ * @load: state of loading.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Handles whatever is left after last chunk. Last line of text edge list does
+ * not need to end with a newline, but binary edge list must not end in the
+ * middle of a pair.
+ *
+ * Returns: %TRUE on success, %FALSE if edge list ends prematurely.
+ */
+static gboolean
+_g_sgraph_builder_load_end (GSGraphBuilderLoad* load,
+                            GError** error)
+{
+  if (!load->pending->len)
+  {
+    return TRUE;
+  }
+  if (load->format == G_SGRAPH_EDGE_LIST_BINARY)
+  {
+    g_set_error (error, G_SGRAPH_BUILDER_ERROR, G_SGRAPH_BUILDER_ERROR_PARSE,
+                 "Edge list ends in the middle of a pair.");
+    return FALSE;
+  }
+  return _g_sgraph_builder_load_line (load,
+                                      load->pending->str,
+                                      load->pending->len,
+                                      error);
+}
+
+/**
+ * _g_sgraph_builder_load_pairs:
+ * @load: state of loading.
+ * @chunk: a chunk of binary edge list.
+ * @length: length of @chunk.
+ *
+ * Feeds builder with pairs in @chunk. Bytes of a pair split between chunks are
+ * kept until the next chunk.
+ *
+ * Returns: %TRUE.
+ */
+static gboolean
+_g_sgraph_builder_load_pairs (GSGraphBuilderLoad* load,
+                              const gchar* chunk,
+                              gsize length)
+{
+  const gchar* end;
+
+  end = chunk + length;
+  if (load->pending->len)
+  {
+    guint32 keys[2];
+    gsize missing;
+
+    missing = MIN (G_SGRAPH_BUILDER_PAIR_SIZE - load->pending->len, length);
+    g_string_append_len (load->pending, chunk, missing);
+    chunk += missing;
+    if (load->pending->len < G_SGRAPH_BUILDER_PAIR_SIZE)
+    {
+      return TRUE;
+    }
+    memcpy (keys, load->pending->str, G_SGRAPH_BUILDER_PAIR_SIZE);
+    g_string_truncate (load->pending, 0);
+    g_sgraph_builder_add_pair (load->builder,
+                               GUINT_TO_POINTER (keys[0]),
+                               GUINT_TO_POINTER (keys[1]));
+  }
+
+  for (; (gsize)(end - chunk) >= G_SGRAPH_BUILDER_PAIR_SIZE;
+       chunk += G_SGRAPH_BUILDER_PAIR_SIZE)
+  {
+    guint32 keys[2];
+
+    /* chunk is not aligned, so keys are copied out of it. */
+    memcpy (keys, chunk, G_SGRAPH_BUILDER_PAIR_SIZE);
+    g_sgraph_builder_add_pair (load->builder,
+                               GUINT_TO_POINTER (keys[0]),
+                               GUINT_TO_POINTER (keys[1]));
+  }
+  g_string_append_len (load->pending, chunk, end - chunk);
+
+  return TRUE;
+}
+
+/**
+ * _g_sgraph_builder_load_lines:
+ * @load: state of loading.
+ * @chunk: a chunk of text edge list.
+ * @length: length of @chunk.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Parses lines in @chunk. Lines are parsed in place, only a line split between
+ * chunks is copied.
+ *
+ * Returns: %TRUE on success, %FALSE if a line is malformed.
+ */
+static gboolean
+_g_sgraph_builder_load_lines (GSGraphBuilderLoad* load,
+                              const gchar* chunk,
+                              gsize length,
+                              GError** error)
+{
+  const gchar* end;
+
+  end = chunk + length;
+  while (chunk < end)
+  {
+    const gchar* newline;
+    gboolean result;
+
+    newline = memchr (chunk, '\n', end - chunk);
+    if (!newline)
+    {
+      g_string_append_len (load->pending, chunk, end - chunk);
+      break;
+    }
+
+    if (load->pending->len)
+    {
+      g_string_append_len (load->pending, chunk, newline - chunk);
+      result = _g_sgraph_builder_load_line (load,
+                                            load->pending->str,
+                                            load->pending->len,
+                                            error);
+      g_string_truncate (load->pending, 0);
+    }
+    else
+    {
+      result = _g_sgraph_builder_load_line (load,
+                                            chunk,
+                                            newline - chunk,
+                                            error);
+    }
+    if (!result)
+    {
+      return FALSE;
+    }
+    chunk = newline + 1;
+  }
+
+  return TRUE;
+}
+
+/**
+ * _g_sgraph_builder_load_line:
+ * @load: state of loading.
+ * @line: a line of text edge list, without newline.
+ * @length: length of @line.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Parses two keys from @line and feeds builder with them. Blank lines and
+ * comments are skipped.
+ *
+ * Returns: %TRUE on success, %FALSE if @line is malformed.
+ */
+static gboolean
+_g_sgraph_builder_load_line (GSGraphBuilderLoad* load,
+                             const gchar* line,
+                             gsize length,
+                             GError** error)
+{
+  const gchar* keys[2];
+  gsize lengths[2];
+  guint indices[2];
+  gsize position;
+  guint found;
+
+  ++load->line_number;
+  position = 0;
+  for (found = 0; found < 2; ++found)
+  {
+    while ((position < length) &&
+           _g_sgraph_builder_is_separator (line[position]))
+    {
+      ++position;
+    }
+    if ((position == length) ||
+        (!found && ((line[position] == '#') || (line[position] == '%'))))
+    {
+      break;
+    }
+
+    keys[found] = line + position;
+    while ((position < length) &&
+           !_g_sgraph_builder_is_separator (line[position]))
+    {
+      ++position;
+    }
+    lengths[found] = line + position - keys[found];
+  }
+
+  if (!found)
+  {
+    return TRUE;
+  }
+  if (found < 2)
+  {
+    g_set_error (error, G_SGRAPH_BUILDER_ERROR, G_SGRAPH_BUILDER_ERROR_PARSE,
+                 "Line %u: expected two keys.", load->line_number);
+    return FALSE;
+  }
+
+  /* keys are turned into nodes first, so a new string key appearing twice in
+   * a line is copied only once. */
+  for (found = 0; found < 2; ++found)
+  {
+    if (!_g_sgraph_builder_load_key (load,
+                                     keys[found],
+                                     lengths[found],
+                                     &indices[found],
+                                     error))
+    {
+      return FALSE;
+    }
+  }
+  _g_sgraph_builder_connect (load->builder, indices[0], indices[1]);
+
+  return TRUE;
+}
+
+/**
+ * _g_sgraph_builder_load_key:
+ * @load: state of loading.
+ * @key: a key.
+ * @length: length of @key.
+ * @index: return location for index of node.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Gets an index of node for @key, creating it if needed.
+ *
+ * Returns: %TRUE on success, %FALSE if @key is not a valid integer key.
+ */
+static gboolean
+_g_sgraph_builder_load_key (GSGraphBuilderLoad* load,
+                            const gchar* key,
+                            gsize length,
+                            guint* index,
+                            GError** error)
+{
+  GSGraphBuilder* builder;
+  guint64 value;
+  gsize iter;
+
+  builder = load->builder;
+  if (load->format == G_SGRAPH_EDGE_LIST_STRINGS)
+  {
+    GSGraphNode* node;
+
+    g_string_truncate (load->key, 0);
+    g_string_append_len (load->key, key, length);
+    node = g_sgraph_builder_lookup_node (builder, load->key->str);
+    *index = _g_sgraph_builder_get_node_index (builder,
+                                               node ?
+                                               node->data :
+                                               g_strndup (key, length));
+    return TRUE;
+  }
+
+  value = 0;
+  for (iter = 0; iter < length; ++iter)
+  {
+    if (!g_ascii_isdigit (key[iter]))
+    {
+      break;
+    }
+    value = value * 10 + g_ascii_digit_value (key[iter]);
+    if (value > G_MAXUINT32)
+    {
+      break;
+    }
+  }
+  if (iter < length)
+  {
+    g_set_error (error, G_SGRAPH_BUILDER_ERROR, G_SGRAPH_BUILDER_ERROR_PARSE,
+                 "Line %u: invalid key `%.*s'.",
+                 load->line_number, (gint)length, key);
+    return FALSE;
+  }
+
+  *index = _g_sgraph_builder_get_node_index (builder,
+                                             GUINT_TO_POINTER (value));
+  return TRUE;
+}
+
+/**
+ * _g_sgraph_builder_is_separator:
+ * @c: a character.
+ *
+ * Checks whether @c separates keys in text edge list.
+ *
+ * Returns: %TRUE if @c is a separator.
+ */
+static gboolean
+_g_sgraph_builder_is_separator (gchar c)
+{
+  return ((c == ' ') || (c == '\t') || (c == '\r') || (c == ','));
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined (G_DISABLE_SINGLE_INCLUDES) && !defined (_G_SGRAPH_H_INSIDE_) && !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "Only <gsgraph/gsgraph.h> can be included directly."
+#endif
+
+#ifndef _G_SGRAPH_BUILDER_H_
+#define _G_SGRAPH_BUILDER_H_
+
+#include <glib.h>
+
+#include <gsgraph/gsgraphtypedefs.h>
+#include <gsgraph/gsgraphenums.h>
+#include <gsgraph/gsgraphnode.h>
+
+G_BEGIN_DECLS
+
+/**
+ * G_SGRAPH_BUILDER_ERROR:
+ *
+ * Error domain for loading edge lists into #GSGraphBuilder. Errors in this
+ * domain will be from the #GSGraphBuilderError enumeration.
+ */
+#define G_SGRAPH_BUILDER_ERROR g_sgraph_builder_error_quark ()
+
+/**
+ * GSGraphBuilder:
+ *
+ * Opaque structure building graphs from pairs of node data fed one by one.
+ */
+typedef struct _GSGraphBuilder GSGraphBuilder;
+
+GQuark
+g_sgraph_builder_error_quark (void);
+
+GSGraphBuilder*
+g_sgraph_builder_new (GHashFunc hash_func,
+                      GEqualFunc key_equal_func) G_GNUC_WARN_UNUSED_RESULT;
+
+GSGraphBuilder*
+g_sgraph_builder_new_in_arena (GSGraphArena* arena,
+                               GHashFunc hash_func,
+                               GEqualFunc key_equal_func) G_GNUC_WARN_UNUSED_RESULT;
+
+void
+g_sgraph_builder_free (GSGraphBuilder* builder,
+                       GDestroyNotify data_destroy_func);
+
+void
+g_sgraph_builder_add_pair (GSGraphBuilder* builder,
+                           gpointer first,
+                           gpointer second);
+
+GSGraphNode*
+g_sgraph_builder_lookup_node (GSGraphBuilder* builder,
+                              gconstpointer data);
+
+guint
+g_sgraph_builder_get_order (GSGraphBuilder* builder);
+
+GPtrArray*
+g_sgraph_builder_finish (GSGraphBuilder* builder) G_GNUC_WARN_UNUSED_RESULT;
+
+gboolean
+g_sgraph_builder_load_file (GSGraphBuilder* builder,
+                            const gchar* filename,
+                            GSGraphEdgeListFormat format,
+                            GError** error);
+
+gboolean
+g_sgraph_builder_load_channel (GSGraphBuilder* builder,
+                               GIOChannel* channel,
+                               GSGraphEdgeListFormat format,
+                               GError** error);
+
+G_END_DECLS
+
+#endif /* _G_SGRAPH_BUILDER_H_ */
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsgraphcomponents.h"
+#include "gsgraphparallel.h"
+
+/* Internal disjoint-set forest for labelling connected components with many
+ * threads. Every element points to a parent with lower index, so a root is
+ * always the lowest element of its set. Joining hooks the higher of two roots
+ * onto the lower one with an atomic compare-and-exchange, like in
+ * Shiloach-Vishkin algorithm. When the exchange fails, because other thread
+ * hooked the root in the meantime, both elements move up the forest and
+ * joining is retried, so no locks are needed. Paths are compressed once,
+ * after all joins.
+ */
+
+/* static function declarations. */
+
+static void
+_g_sgraph_components_compress (guint element,
+                               gpointer components);
+
+/* function definitions. */
+
+/**
+ * _g_sgraph_components_new:
+ * @count: number of elements.
+ *
+ * Creates new forest of @count elements, each being its own set.
+ *
+ * Returns: new #GSGraphComponents.
+ */
+GSGraphComponents*
+_g_sgraph_components_new (guint count)
+{
+  GSGraphComponents* components;
+  guint iter;
+
+  g_return_val_if_fail (count < G_MAXINT, NULL);
+
+  components = g_slice_new (GSGraphComponents);
+  components->parents = g_new (gint, count);
+  components->count = count;
+  for (iter = 0; iter < count; ++iter)
+  {
+    components->parents[iter] = iter;
+  }
+
+  return components;
+}
+
+/**
+ * _g_sgraph_components_free:
+ * @components: a forest.
+ *
+ * Frees memory allocated to @components.
+ */
+void
+_g_sgraph_components_free (GSGraphComponents* components)
+{
+  g_free (components->parents);
+  g_slice_free (GSGraphComponents, components);
+}
+
+/**
+ * _g_sgraph_components_union:
+ * @components: a forest.
+ * @element: an element.
+ * @other_element: other element.
+ *
+ * Joins sets containing @element and @other_element. It is safe to call it
+ * from many threads at once.
+ */
+void
+_g_sgraph_components_union (GSGraphComponents* components,
+                            guint element,
+                            guint other_element)
+{
+  gint* parents;
+  gint parent;
+  gint other_parent;
+
+  parents = components->parents;
+  parent = g_atomic_int_get (parents + element);
+  other_parent = g_atomic_int_get (parents + other_element);
+  while (parent != other_parent)
+  {
+    gint high;
+    gint low;
+    gint high_parent;
+
+    high = MAX (parent, other_parent);
+    low = MIN (parent, other_parent);
+    high_parent = g_atomic_int_get (parents + high);
+    if (high_parent == low)
+    {
+      return;
+    }
+    if ((high_parent == high) &&
+        g_atomic_int_compare_and_exchange (parents + high, high, low))
+    {
+      return;
+    }
+    parent = g_atomic_int_get (parents + high_parent);
+    other_parent = g_atomic_int_get (parents + low);
+  }
+}
+
+/**
+ * _g_sgraph_components_label:
+ * @components: a forest.
+ * @labels: array of elements' count to fill with labels.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Gives every set a dense label. Sets are labelled in order of their lowest
+ * elements. Must not be called while sets are still joined.
+ *
+ * Returns: number of sets.
+ */
+guint
+_g_sgraph_components_label (GSGraphComponents* components,
+                            guint32* labels,
+                            guint n_threads)
+{
+  guint count;
+  guint iter;
+
+  _g_sgraph_parallel_for (components->count,
+                          _g_sgraph_components_compress,
+                          components,
+                          n_threads);
+
+  count = 0;
+  for (iter = 0; iter < components->count; ++iter)
+  {
+    guint parent;
+
+    /* root is the lowest element, so it is labelled before its children. */
+    parent = components->parents[iter];
+    if (parent == iter)
+    {
+      labels[iter] = count++;
+    }
+    else
+    {
+      labels[iter] = labels[parent];
+    }
+  }
+
+  return count;
+}
+
+/* static function definitions. */
+
+/**
+ * _g_sgraph_components_compress:
+ * @element: an element.
+ * @components: a #GSGraphComponents.
+ *
+ * Makes root of @element's set its parent.
+ */
+static void
+_g_sgraph_components_compress (guint element,
+                               gpointer components)
+{
+  gint* parents;
+  gint root;
+
+  parents = ((GSGraphComponents*)components)->parents;
+  root = g_atomic_int_get (parents + element);
+  while (g_atomic_int_get (parents + root) != root)
+  {
+    root = g_atomic_int_get (parents + root);
+  }
+  g_atomic_int_set (parents + element, root);
+}
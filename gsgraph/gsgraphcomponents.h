@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "This is a private header, it must not be included outside libggraph."
+#endif
+
+#ifndef _G_SGRAPH_COMPONENTS_H_
+#define _G_SGRAPH_COMPONENTS_H_
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GSGraphComponents:
+ * @parents: parent of each element.
+ * @count: number of elements.
+ *
+ * Internal disjoint-set forest over fixed number of elements, which can be
+ * joined by many threads at once without locks.
+ */
+typedef struct _GSGraphComponents GSGraphComponents;
+
+struct _GSGraphComponents
+{
+  gint* parents;
+  guint count;
+};
+
+G_GNUC_INTERNAL GSGraphComponents*
+_g_sgraph_components_new (guint count);
+
+G_GNUC_INTERNAL void
+_g_sgraph_components_free (GSGraphComponents* components);
+
+G_GNUC_INTERNAL void
+_g_sgraph_components_union (GSGraphComponents* components,
+                            guint element,
+                            guint other_element);
+
+G_GNUC_INTERNAL guint
+_g_sgraph_components_label (GSGraphComponents* components,
+                            guint32* labels,
+                            guint n_threads);
+
+G_END_DECLS
+
+#endif /* _G_SGRAPH_COMPONENTS_H_ */
@@ -0,0 +1,470 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsgraphconnectivity.h"
+#include "gsgraphconnectivityprivate.h"
+
+#include "gsgraphdisjointset.h"
+
+/**
+ * SECTION: gsgraphconnectivity
+ * @title: Simple graph connectivity index
+ * @short_description: fast answers to questions about separation of nodes.
+ * @include: gsgraph/gsgraph.h
+ * @see_also: #GSGraphNode, g_sgraph_node_are_separate()
+ *
+ * Index of connected components of nodes kept in a disjoint-set forest. When
+ * a node is added to the index, all nodes reachable from it are added too.
+ * Nodes connected with g_sgraph_node_connect() to indexed nodes are added
+ * automatically and their components are joined incrementally, so as long as
+ * the graph is only growing, g_sgraph_node_are_separate() answers in nearly
+ * constant time instead of traversing the graph.
+ *
+ * Removing a connection can split a component, which disjoint-set forest
+ * cannot express. So g_sgraph_node_disconnect() marks the index as invalid and
+ * g_sgraph_node_are_separate() falls back to traversing the graph until
+ * g_sgraph_connectivity_rebuild() is called.
+ *
+ * To create an index, use g_sgraph_connectivity_new().
+ *
+ * To free it, use g_sgraph_connectivity_free().
+ *
+ * To add nodes to it, use g_sgraph_connectivity_add_node() or
+ * g_sgraph_connectivity_add_graph().
+ *
+ * To check if it is valid, use g_sgraph_connectivity_is_valid().
+ *
+ * To make it valid again, use g_sgraph_connectivity_rebuild().
+ *
+ * To get number of components in it, use g_sgraph_connectivity_get_count().
+ *
+ * <note>
+ *   <para>
+ *     A node can be held by at most one index. Connecting nodes from two
+ *     different indices invalidates both of them. Changing neighbours array of
+ *     a node by hand bypasses the index and makes its answers wrong.
+ *   </para>
+ * </note>
+ */
+
+/* internal types. */
+
+struct _GSGraphConnectivity
+{
+  GPtrArray* nodes;
+  GSGraphDisjointSet* set;
+  guint count;
+  gboolean valid;
+};
+
+/* static function declarations. */
+
+static void
+_g_sgraph_connectivity_register (GSGraphConnectivity* connectivity,
+                                 GSGraphNode* node);
+
+static void
+_g_sgraph_connectivity_add_component (GSGraphConnectivity* connectivity,
+                                      GSGraphNode* node);
+
+static void
+_g_sgraph_connectivity_join (GSGraphConnectivity* connectivity,
+                             GSGraphNode* node,
+                             GSGraphNode* other_node);
+
+/* public function definitions. */
+
+/**
+ * g_sgraph_connectivity_new:
+ *
+ * Creates new empty connectivity index.
+ *
+ * Returns: newly created #GSGraphConnectivity.
+ */
+GSGraphConnectivity*
+g_sgraph_connectivity_new (void)
+{
+  GSGraphConnectivity* connectivity;
+
+  connectivity = g_slice_new (GSGraphConnectivity);
+  connectivity->nodes = g_ptr_array_new ();
+  connectivity->set = _g_sgraph_disjoint_set_new (0);
+  connectivity->count = 0;
+  connectivity->valid = TRUE;
+
+  return connectivity;
+}
+
+/**
+ * g_sgraph_connectivity_free:
+ * @connectivity: index to free.
+ *
+ * Frees memory allocated to @connectivity. Nodes held by it are not freed, but
+ * they stop being indexed.
+ */
+void
+g_sgraph_connectivity_free (GSGraphConnectivity* connectivity)
+{
+  guint iter;
+
+  g_return_if_fail (connectivity != NULL);
+
+  for (iter = 0; iter < connectivity->nodes->len; ++iter)
+  {
+    GSGraphNode* node;
+
+    node = g_ptr_array_index (connectivity->nodes, iter);
+    if (node)
+    {
+      node->connectivity = NULL;
+    }
+  }
+  g_ptr_array_free (connectivity->nodes, TRUE);
+  _g_sgraph_disjoint_set_free (connectivity->set);
+  g_slice_free (GSGraphConnectivity, connectivity);
+}
+
+/**
+ * g_sgraph_connectivity_add_node:
+ * @connectivity: an index.
+ * @node: a node.
+ *
+ * Adds @node and all nodes reachable from it to @connectivity. If @node is
+ * already in @connectivity, nothing happens. If @node is held by another
+ * index, both of them become invalid.
+ */
+void
+g_sgraph_connectivity_add_node (GSGraphConnectivity* connectivity,
+                                GSGraphNode* node)
+{
+  g_return_if_fail (connectivity != NULL);
+  g_return_if_fail (node != NULL);
+
+  if (!node->connectivity)
+  {
+    _g_sgraph_connectivity_add_component (connectivity, node);
+  }
+  else if (node->connectivity != connectivity)
+  {
+    node->connectivity->valid = FALSE;
+    connectivity->valid = FALSE;
+  }
+}
+
+/**
+ * g_sgraph_connectivity_add_graph:
+ * @connectivity: an index.
+ * @graph: a graph.
+ *
+ * Adds all nodes in @graph to @connectivity, as
+ * g_sgraph_connectivity_add_node() does.
+ */
+void
+g_sgraph_connectivity_add_graph (GSGraphConnectivity* connectivity,
+                                 GSGraphSnapshot* graph)
+{
+  guint iter;
+
+  g_return_if_fail (connectivity != NULL);
+  g_return_if_fail (graph != NULL);
+
+  for (iter = 0; iter < graph->node_array->len; ++iter)
+  {
+    g_sgraph_connectivity_add_node (connectivity,
+                                    g_ptr_array_index (graph->node_array,
+                                                       iter));
+  }
+}
+
+/**
+ * g_sgraph_connectivity_is_valid:
+ * @connectivity: an index.
+ *
+ * Checks if @connectivity can be used to answer whether two nodes are
+ * separate. Index becomes invalid when any of its nodes is disconnected.
+ *
+ * Returns: %TRUE if @connectivity is valid, otherwise %FALSE.
+ */
+gboolean
+g_sgraph_connectivity_is_valid (GSGraphConnectivity* connectivity)
+{
+  g_return_val_if_fail (connectivity != NULL, FALSE);
+
+  return connectivity->valid;
+}
+
+/**
+ * g_sgraph_connectivity_rebuild:
+ * @connectivity: an index.
+ *
+ * Computes components of all nodes held by @connectivity from scratch in
+ * O(V+E) time, so it becomes valid again. Slots of freed nodes are dropped.
+ */
+void
+g_sgraph_connectivity_rebuild (GSGraphConnectivity* connectivity)
+{
+  GPtrArray* old_nodes;
+  guint iter;
+
+  g_return_if_fail (connectivity != NULL);
+
+  old_nodes = connectivity->nodes;
+  for (iter = 0; iter < old_nodes->len; ++iter)
+  {
+    GSGraphNode* node;
+
+    node = g_ptr_array_index (old_nodes, iter);
+    if (node)
+    {
+      node->connectivity = NULL;
+    }
+  }
+
+  _g_sgraph_disjoint_set_free (connectivity->set);
+  connectivity->nodes = g_ptr_array_sized_new (old_nodes->len);
+  connectivity->set = _g_sgraph_disjoint_set_new (old_nodes->len);
+  connectivity->count = 0;
+  connectivity->valid = TRUE;
+
+  for (iter = 0; iter < old_nodes->len; ++iter)
+  {
+    GSGraphNode* node;
+
+    node = g_ptr_array_index (old_nodes, iter);
+    if (node && !node->connectivity)
+    {
+      _g_sgraph_connectivity_add_component (connectivity, node);
+    }
+  }
+  g_ptr_array_free (old_nodes, TRUE);
+}
+
+/**
+ * g_sgraph_connectivity_get_count:
+ * @connectivity: an index.
+ *
+ * Gets number of connected components in @connectivity. Meaningful only if
+ * @connectivity is valid.
+ *
+ * Returns: number of components.
+ */
+guint
+g_sgraph_connectivity_get_count (GSGraphConnectivity* connectivity)
+{
+  g_return_val_if_fail (connectivity != NULL, 0);
+
+  return connectivity->count;
+}
+
+/* internal function definitions. */
+
+/**
+ * _g_sgraph_connectivity_node_connected:
+ * @node: a node.
+ * @other_node: other node.
+ *
+ * Updates index after @node and @other_node were connected. If only one of
+ * them is indexed, component of the other one is added to the index.
+ */
+void
+_g_sgraph_connectivity_node_connected (GSGraphNode* node,
+                                       GSGraphNode* other_node)
+{
+  if (!node->connectivity)
+  {
+    if (other_node->connectivity)
+    {
+      _g_sgraph_connectivity_add_component (other_node->connectivity, node);
+    }
+  }
+  else if (!other_node->connectivity)
+  {
+    _g_sgraph_connectivity_add_component (node->connectivity, other_node);
+  }
+  else
+  {
+    _g_sgraph_connectivity_join (node->connectivity, node, other_node);
+  }
+}
+
+/**
+ * _g_sgraph_connectivity_node_disconnected:
+ * @node: a node.
+ *
+ * Invalidates index holding @node, if any.
+ */
+void
+_g_sgraph_connectivity_node_disconnected (GSGraphNode* node)
+{
+  if (node->connectivity)
+  {
+    node->connectivity->valid = FALSE;
+  }
+}
+
+/**
+ * _g_sgraph_connectivity_node_freed:
+ * @node: a node.
+ *
+ * Removes @node from index holding it, if any.
+ */
+void
+_g_sgraph_connectivity_node_freed (GSGraphNode* node)
+{
+  if (node->connectivity)
+  {
+    g_ptr_array_index (node->connectivity->nodes,
+                       node->connectivity_index) = NULL;
+  }
+}
+
+/**
+ * _g_sgraph_connectivity_check:
+ * @node: a node.
+ * @other_node: other node.
+ * @are_separate: place where answer is stored.
+ *
+ * Tries to answer whether @node and @other_node are separate using index
+ * holding any of them. Set of nodes in valid index is closed under
+ * neighbourhood, so a node outside of it is always separate from nodes inside.
+ *
+ * Returns: %TRUE if answer was stored in @are_separate, %FALSE if there is no
+ * valid index to use.
+ */
+gboolean
+_g_sgraph_connectivity_check (GSGraphNode* node,
+                              GSGraphNode* other_node,
+                              gboolean* are_separate)
+{
+  GSGraphConnectivity* connectivity;
+
+  connectivity = node->connectivity;
+  if (!connectivity || !connectivity->valid)
+  {
+    connectivity = other_node->connectivity;
+    if (!connectivity || !connectivity->valid)
+    {
+      return FALSE;
+    }
+  }
+
+  if ((node->connectivity != connectivity) ||
+      (other_node->connectivity != connectivity))
+  {
+    *are_separate = TRUE;
+  }
+  else
+  {
+    guint root;
+    guint other_root;
+
+    root = _g_sgraph_disjoint_set_find (connectivity->set,
+                                        node->connectivity_index);
+    other_root = _g_sgraph_disjoint_set_find (connectivity->set,
+                                              other_node->connectivity_index);
+    *are_separate = (root != other_root);
+  }
+  return TRUE;
+}
+
+/* static function definitions. */
+
+/**
+ * _g_sgraph_connectivity_register:
+ * @connectivity: an index.
+ * @node: a node not held by any index.
+ *
+ * Puts @node into @connectivity as a separate component.
+ */
+static void
+_g_sgraph_connectivity_register (GSGraphConnectivity* connectivity,
+                                 GSGraphNode* node)
+{
+  node->connectivity = connectivity;
+  node->connectivity_index = _g_sgraph_disjoint_set_add (connectivity->set);
+  g_ptr_array_add (connectivity->nodes, node);
+  ++connectivity->count;
+}
+
+/**
+ * _g_sgraph_connectivity_add_component:
+ * @connectivity: an index.
+ * @node: a node not held by any index.
+ *
+ * Adds @node and all not indexed nodes reachable from it to @connectivity and
+ * joins them with their indexed neighbours. Newly added part of nodes array
+ * serves as a breadth first search queue.
+ */
+static void
+_g_sgraph_connectivity_add_component (GSGraphConnectivity* connectivity,
+                                      GSGraphNode* node)
+{
+  guint head;
+
+  head = connectivity->nodes->len;
+  _g_sgraph_connectivity_register (connectivity, node);
+
+  for (; head < connectivity->nodes->len; ++head)
+  {
+    GSGraphNode* temp_node;
+    guint iter;
+
+    temp_node = g_ptr_array_index (connectivity->nodes, head);
+    for (iter = 0; iter < temp_node->neighbours->len; ++iter)
+    {
+      GSGraphNode* neighbour;
+
+      neighbour = g_ptr_array_index (temp_node->neighbours, iter);
+      if (!neighbour->connectivity)
+      {
+        _g_sgraph_connectivity_register (connectivity, neighbour);
+      }
+      _g_sgraph_connectivity_join (connectivity, temp_node, neighbour);
+    }
+  }
+}
+
+/**
+ * _g_sgraph_connectivity_join:
+ * @connectivity: an index holding @node.
+ * @node: a node.
+ * @other_node: other node.
+ *
+ * Joins components of @node and @other_node. If @other_node is held by another
+ * index, both indices are invalidated.
+ */
+static void
+_g_sgraph_connectivity_join (GSGraphConnectivity* connectivity,
+                             GSGraphNode* node,
+                             GSGraphNode* other_node)
+{
+  if (other_node->connectivity != connectivity)
+  {
+    other_node->connectivity->valid = FALSE;
+    connectivity->valid = FALSE;
+    return;
+  }
+
+  if (_g_sgraph_disjoint_set_union (connectivity->set,
+                                    node->connectivity_index,
+                                    other_node->connectivity_index))
+  {
+    --connectivity->count;
+  }
+}
@@ -0,0 +1,716 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsgraphcsr.h"
+#include "gsgraphbinary.h"
+#include "gsgraphbfs.h"
+
+/**
+ * SECTION: gsgraphcsr
+ * @title: Simple graph in compressed sparse row form
+ * @short_description: immutable, contiguous copy of a simple graph.
+ * @include: gsgraph/gsgraph.h
+ * @see_also: #GSGraphSnapshot, #GSGraphTraverseType
+ *
+ * Frozen copy of a graph held by #GSGraphSnapshot. All neighbours of all nodes
+ * are stored in one array of 32-bit node indices and each node owns a
+ * contiguous range of it, described by an offsets array. Node data are stored
+ * in a parallel array. Such layout makes scans over the graph touch memory
+ * sequentially instead of chasing pointers to separately allocated nodes.
+ *
+ * Node with index i in #GSGraphCsr is the i-th node of snapshot's node array
+ * and order of neighbours of each node is preserved, so traversing a
+ * #GSGraphCsr visits nodes in the same order as traversing the nodes it was
+ * created from.
+ *
+ * To create a structure, use g_sgraph_csr_new().
+ *
+ * To free it, use g_sgraph_csr_free().
+ *
+ * To get number of nodes, connections or neighbours of a node, use
+ * g_sgraph_csr_get_order(), g_sgraph_csr_get_size() or
+ * g_sgraph_csr_get_degree().
+ *
+ * To get indices of nodes in traversal order, use g_sgraph_csr_traverse().
+ *
+ * To get depths and parents of all nodes in breadth first search tree using
+ * many threads, use g_sgraph_csr_bfs_parallel().
+ *
+ * To save a graph in a binary file, use g_sgraph_csr_save(). To save
+ * a #GSGraphSnapshot, create a #GSGraphCsr from it first. To load a graph
+ * saved this way, use g_sgraph_csr_load(). Loaded file is mapped into memory
+ * and offsets and neighbours arrays point straight into the mapping, so
+ * loading takes time needed to validate the file, not to rebuild the graph.
+ * Node data are saved as payloads serialized with #GSGraphCsrSaveFunc. They
+ * can be deserialized during loading with #GSGraphCsrLoadFunc or read in
+ * place with g_sgraph_csr_get_payload().
+ *
+ * <note>
+ *   <para>
+ *     #GSGraphCsr is not updated when nodes it was created from change. Node
+ *     data are shared with original nodes, so freeing #GSGraphCsr does not free
+ *     them.
+ *   </para>
+ * </note>
+ */
+
+/* internal macros */
+
+/* identifies binary files holding #GSGraphCsr. */
+#define G_SGRAPH_CSR_MAGIC "GSGRAPH"
+
+/* internal types. */
+
+/**
+ * GSGraphCsrFrame:
+ * @index: index of node.
+ * @position: position in neighbours array of next neighbour to check.
+ *
+ * Internal struct used as a depth first search stack frame.
+ */
+typedef struct _GSGraphCsrFrame GSGraphCsrFrame;
+
+struct _GSGraphCsrFrame
+{
+  guint32 index;
+  guint32 position;
+};
+
+/* static function declarations. */
+
+static void
+_g_sgraph_csr_append_DFS (GSGraphCsr* csr,
+                          guint32 index,
+                          GArray* indices,
+                          guint8* visited);
+
+static void
+_g_sgraph_csr_append_BFS (GSGraphCsr* csr,
+                          guint32 index,
+                          GArray* indices,
+                          guint8* visited);
+
+/* public function definitions. */
+
+/**
+ * g_sgraph_csr_error_quark:
+ *
+ * Gets the error domain of #GSGraphCsr file loading.
+ *
+ * Returns: error quark.
+ */
+GQuark
+g_sgraph_csr_error_quark (void)
+{
+  return g_quark_from_static_string ("g-sgraph-csr-error-quark");
+}
+
+/**
+ * g_sgraph_csr_new:
+ * @graph: a graph.
+ *
+ * Creates a #GSGraphCsr holding the same graph as @graph in O(V+E) time. All
+ * neighbours of nodes in @graph must also be in @graph, which is always true
+ * for snapshots created by g_sgraph_snapshot_new() and
+ * g_sgraph_snapshot_new_from_node().
+ *
+ * Returns: new #GSGraphCsr or %NULL if @graph is not closed or too large.
+ */
+GSGraphCsr*
+g_sgraph_csr_new (GSGraphSnapshot* graph)
+{
+  GSGraphCsr* csr;
+  GHashTable* nodes_to_indices;
+  guint64 total;
+  guint iter;
+
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->node_array != NULL, NULL);
+
+  total = 0;
+  for (iter = 0; iter < graph->node_array->len; ++iter)
+  {
+    GSGraphNode* node;
+
+    node = g_ptr_array_index (graph->node_array, iter);
+    total += node->neighbours->len;
+  }
+  g_return_val_if_fail (total < G_MAXUINT32, NULL);
+
+  nodes_to_indices = g_hash_table_new (NULL, NULL);
+  for (iter = 0; iter < graph->node_array->len; ++iter)
+  {
+    g_hash_table_insert (nodes_to_indices,
+                         g_ptr_array_index (graph->node_array, iter),
+                         GUINT_TO_POINTER (iter));
+  }
+
+  csr = g_slice_new (GSGraphCsr);
+  csr->order = graph->node_array->len;
+  csr->size = total / 2;
+  csr->offsets = g_new (guint32, csr->order + 1);
+  csr->neighbours = g_new (guint32, total);
+  csr->data = g_new (gpointer, csr->order);
+  csr->mapped_file = NULL;
+  csr->payloads = NULL;
+  csr->payload_offsets = NULL;
+
+  csr->offsets[0] = 0;
+  for (iter = 0; iter < csr->order; ++iter)
+  {
+    GSGraphNode* node;
+    guint32 offset;
+    guint iter2;
+
+    node = g_ptr_array_index (graph->node_array, iter);
+    offset = csr->offsets[iter];
+    csr->data[iter] = node->data;
+    for (iter2 = 0; iter2 < node->neighbours->len; ++iter2)
+    {
+      gpointer neighbour_index;
+
+      if (!g_hash_table_lookup_extended (nodes_to_indices,
+                                         g_ptr_array_index (node->neighbours,
+                                                            iter2),
+                                         NULL,
+                                         &neighbour_index))
+      {
+        g_hash_table_unref (nodes_to_indices);
+        g_sgraph_csr_free (csr);
+        g_return_val_if_reached (NULL);
+      }
+      csr->neighbours[offset + iter2] = GPOINTER_TO_UINT (neighbour_index);
+    }
+    csr->offsets[iter + 1] = offset + node->neighbours->len;
+  }
+
+  g_hash_table_unref (nodes_to_indices);
+  return csr;
+}
+
+/**
+ * g_sgraph_csr_free:
+ * @csr: #GSGraphCsr to free.
+ *
+ * Frees memory allocated to @csr. Node data are not freed.
+ */
+void
+g_sgraph_csr_free (GSGraphCsr* csr)
+{
+  g_return_if_fail (csr != NULL);
+
+  if (csr->mapped_file)
+  {
+    g_mapped_file_free (csr->mapped_file);
+  }
+  else
+  {
+    g_free (csr->offsets);
+    g_free (csr->neighbours);
+  }
+  g_free (csr->data);
+  g_slice_free (GSGraphCsr, csr);
+}
+
+/**
+ * g_sgraph_csr_get_order:
+ * @csr: a graph.
+ *
+ * Gets @csr's order, that is - number of nodes in graph.
+ *
+ * Returns: number of nodes in graph.
+ */
+guint
+g_sgraph_csr_get_order (GSGraphCsr* csr)
+{
+  g_return_val_if_fail (csr != NULL, 0);
+
+  return csr->order;
+}
+
+/**
+ * g_sgraph_csr_get_size:
+ * @csr: a graph.
+ *
+ * Gets @csr's size, that is - number of connections in graph. Unlike
+ * g_sgraph_snapshot_get_size() it does not need to visit all nodes.
+ *
+ * Returns: number of connections in graph.
+ */
+guint
+g_sgraph_csr_get_size (GSGraphCsr* csr)
+{
+  g_return_val_if_fail (csr != NULL, 0);
+
+  return csr->size;
+}
+
+/**
+ * g_sgraph_csr_get_degree:
+ * @csr: a graph.
+ * @index: index of a node.
+ *
+ * Gets number of neighbours of node with @index.
+ *
+ * Returns: degree of a node.
+ */
+guint
+g_sgraph_csr_get_degree (GSGraphCsr* csr,
+                         guint32 index)
+{
+  g_return_val_if_fail (csr != NULL, 0);
+  g_return_val_if_fail (index < csr->order, 0);
+
+  return csr->offsets[index + 1] - csr->offsets[index];
+}
+
+/**
+ * g_sgraph_csr_traverse:
+ * @csr: a graph.
+ * @index: index of a starting node.
+ * @traverse_type: which traversing algorithm to use.
+ *
+ * Gets indices of all nodes reachable from node with @index in order specified
+ * by @traverse_type. This order is the same as order of nodes in
+ * #GSGraphSnapshot created by g_sgraph_snapshot_new_from_node() from
+ * corresponding node. Neither of traversals is recursive.
+ *
+ * Returns: newly created #GArray of #guint32 node indices. Free it with
+ * g_array_free().
+ */
+GArray*
+g_sgraph_csr_traverse (GSGraphCsr* csr,
+                       guint32 index,
+                       GSGraphTraverseType traverse_type)
+{
+  typedef void (*GraphSearchFunc) (GSGraphCsr* csr,
+                                   guint32 index,
+                                   GArray* indices,
+                                   guint8* visited);
+
+  GArray* indices;
+  guint8* visited;
+  GraphSearchFunc gsfunc;
+
+  g_return_val_if_fail (csr != NULL, NULL);
+  g_return_val_if_fail (index < csr->order, NULL);
+
+  switch (traverse_type)
+  {
+    case G_SGRAPH_TRAVERSE_BFS:
+    {
+      gsfunc = _g_sgraph_csr_append_BFS;
+      break;
+    }
+    case G_SGRAPH_TRAVERSE_DFS:
+    {
+      gsfunc = _g_sgraph_csr_append_DFS;
+      break;
+    }
+    default:
+    {
+      g_return_val_if_reached (NULL);
+    }
+  }
+
+  indices = g_array_new (FALSE, FALSE, sizeof (guint32));
+  visited = g_new0 (guint8, csr->order);
+
+  (*gsfunc) (csr, index, indices, visited);
+
+  g_free (visited);
+  return indices;
+}
+
+/**
+ * g_sgraph_csr_bfs_parallel:
+ * @csr: a graph.
+ * @index: index of a starting node.
+ * @parents: return location for parents array or %NULL.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Does breadth first search from node with @index using at most @n_threads
+ * threads. Search goes level by level. Levels with few nodes are expanded by
+ * checking neighbours of their nodes, large levels by looking for a neighbour
+ * in the level among neighbours of all unvisited nodes, which checks far less
+ * edges on graphs with small diameter. Visited nodes are marked in a bitmap
+ * with atomic operations and every thread collects nodes found in the next
+ * level in its own buffer.
+ *
+ * If @parents is not %NULL, it is set to an array holding index of parent of
+ * every node in the search tree. Parent of starting node is the node itself.
+ * If a node has many neighbours in previous level, any of them can become its
+ * parent.
+ *
+ * If threads are not supported, that is - g_thread_init() was not called with
+ * older GLib, search runs in the calling thread only.
+ *
+ * Returns: newly created #GArray of #guint32 depths of all nodes, that is -
+ * their distances from starting node. Nodes unreachable from it get
+ * %G_MAXUINT32 as their depth and parent. Free arrays with g_array_free().
+ */
+GArray*
+g_sgraph_csr_bfs_parallel (GSGraphCsr* csr,
+                           guint32 index,
+                           GArray** parents,
+                           guint n_threads)
+{
+  GArray* depths;
+  guint32* parents_data;
+
+  g_return_val_if_fail (csr != NULL, NULL);
+  g_return_val_if_fail (index < csr->order, NULL);
+
+  depths = g_array_sized_new (FALSE, FALSE, sizeof (guint32), csr->order);
+  g_array_set_size (depths, csr->order);
+  parents_data = NULL;
+  if (parents)
+  {
+    *parents = g_array_sized_new (FALSE, FALSE, sizeof (guint32), csr->order);
+    g_array_set_size (*parents, csr->order);
+    parents_data = (guint32*)(*parents)->data;
+  }
+
+  _g_sgraph_bfs_parallel (csr->order,
+                          csr->offsets,
+                          csr->neighbours,
+                          index,
+                          (guint32*)depths->data,
+                          parents_data,
+                          n_threads);
+
+  return depths;
+}
+
+/**
+ * g_sgraph_csr_save:
+ * @csr: a graph.
+ * @filename: name of a file to write.
+ * @save_func: a function serializing node data or %NULL.
+ * @user_data: user data passed to @save_func.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Saves @csr in a binary file. If @save_func is not %NULL, it is called for
+ * each node data and its output is saved as node payload. Files are written
+ * in native byte order and can be loaded only on machines having the same
+ * one. If an error occurs, partially written file is removed.
+ *
+ * Returns: %TRUE on success, %FALSE if an error occured.
+ */
+gboolean
+g_sgraph_csr_save (GSGraphCsr* csr,
+                   const gchar* filename,
+                   GSGraphCsrSaveFunc save_func,
+                   gpointer user_data,
+                   GError** error)
+{
+  GSGraphBinaryWriter writer;
+  GSGraphBinaryHeader header;
+
+  g_return_val_if_fail (csr != NULL, FALSE);
+  g_return_val_if_fail (filename != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  _g_sgraph_binary_header_init (&header, G_SGRAPH_CSR_MAGIC);
+  header.order = csr->order;
+  header.size = csr->size;
+  header.entries = csr->offsets[csr->order];
+
+  if (!_g_sgraph_binary_writer_open (&writer, filename, error))
+  {
+    return FALSE;
+  }
+  if (!_g_sgraph_binary_write (&writer,
+                               csr->offsets,
+                               sizeof (guint32) * (csr->order + 1),
+                               error) ||
+      !_g_sgraph_binary_write (&writer,
+                               csr->neighbours,
+                               sizeof (guint32) * header.entries,
+                               error))
+  {
+    _g_sgraph_binary_writer_abort (&writer);
+    return FALSE;
+  }
+  if (save_func)
+  {
+    header.flags |= G_SGRAPH_BINARY_NODE_PAYLOADS;
+    if (!_g_sgraph_binary_write_payloads (&writer,
+                                          csr->data,
+                                          csr->order,
+                                          save_func,
+                                          user_data,
+                                          &header.node_payloads_length,
+                                          error))
+    {
+      _g_sgraph_binary_writer_abort (&writer);
+      return FALSE;
+    }
+  }
+
+  return _g_sgraph_binary_writer_close (&writer, &header, error);
+}
+
+/**
+ * g_sgraph_csr_load:
+ * @filename: name of a file to load.
+ * @load_func: a function deserializing node data or %NULL.
+ * @user_data: user data passed to @load_func.
+ * @error: return location for a #GError or %NULL.
+ *
+ * Loads a graph saved with g_sgraph_csr_save(). The file is mapped into memory
+ * and stays mapped until returned #GSGraphCsr is freed. If the file holds node
+ * payloads and @load_func is not %NULL, it is called for each of them and its
+ * result becomes node data. Otherwise node data are %NULL. The whole file is
+ * validated, so a damaged file results in an error.
+ *
+ * Returns: new #GSGraphCsr or %NULL if an error occured.
+ */
+GSGraphCsr*
+g_sgraph_csr_load (const gchar* filename,
+                   GSGraphCsrLoadFunc load_func,
+                   gpointer user_data,
+                   GError** error)
+{
+  GMappedFile* mapped_file;
+  const gchar* contents;
+  gsize length;
+  GSGraphBinaryReader reader;
+  const GSGraphBinaryHeader* header;
+  const guint32* offsets;
+  const guint32* neighbours;
+  const gchar* payloads;
+  const guint64* payload_offsets;
+  GSGraphCsr* csr;
+  guint32 iter;
+
+  g_return_val_if_fail (filename != NULL, NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+  mapped_file = g_mapped_file_new (filename, FALSE, error);
+  if (!mapped_file)
+  {
+    return NULL;
+  }
+
+  contents = g_mapped_file_get_contents (mapped_file);
+  length = g_mapped_file_get_length (mapped_file);
+  header = _g_sgraph_binary_reader_init (&reader,
+                                         contents,
+                                         length,
+                                         G_SGRAPH_CSR_MAGIC,
+                                         G_SGRAPH_CSR_ERROR,
+                                         error);
+  if (!header)
+  {
+    g_mapped_file_free (mapped_file);
+    return NULL;
+  }
+
+  payloads = NULL;
+  payload_offsets = NULL;
+  offsets = _g_sgraph_binary_read (&reader,
+                                   sizeof (guint32) *
+                                   ((guint64)header->order + 1));
+  neighbours = _g_sgraph_binary_read (&reader,
+                                      sizeof (guint32) *
+                                      (guint64)header->entries);
+  if (!offsets || !neighbours || (header->order == G_MAXUINT32) ||
+      !_g_sgraph_binary_check_offsets (offsets,
+                                       header->order,
+                                       header->entries) ||
+      !_g_sgraph_binary_check_indices (neighbours,
+                                       header->entries,
+                                       header->order,
+                                       FALSE) ||
+      ((header->flags & G_SGRAPH_BINARY_NODE_PAYLOADS) &&
+       !_g_sgraph_binary_read_payloads (&reader,
+                                        header->order,
+                                        header->node_payloads_length,
+                                        &payloads,
+                                        &payload_offsets)))
+  {
+    g_set_error (error, G_SGRAPH_CSR_ERROR, G_SGRAPH_CSR_ERROR_FORMAT,
+                 "File `%s' is damaged.", filename);
+    g_mapped_file_free (mapped_file);
+    return NULL;
+  }
+
+  csr = g_slice_new (GSGraphCsr);
+  csr->order = header->order;
+  csr->size = header->size;
+  csr->offsets = (guint32*)offsets;
+  csr->neighbours = (guint32*)neighbours;
+  csr->data = g_new0 (gpointer, csr->order);
+  csr->mapped_file = mapped_file;
+  csr->payloads = payloads;
+  csr->payload_offsets = payload_offsets;
+
+  if (load_func && payloads)
+  {
+    for (iter = 0; iter < csr->order; ++iter)
+    {
+      csr->data[iter] = (*load_func) (payloads + payload_offsets[iter],
+                                      payload_offsets[iter + 1] -
+                                      payload_offsets[iter],
+                                      user_data);
+    }
+  }
+
+  return csr;
+}
+
+/**
+ * g_sgraph_csr_get_payload:
+ * @csr: a graph loaded with g_sgraph_csr_load().
+ * @index: index of a node.
+ * @length: return location for length of payload or %NULL.
+ *
+ * Gets serialized data of node with @index straight from the mapped file,
+ * without deserializing it.
+ *
+ * Returns: payload owned by @csr or %NULL if @csr holds no payloads.
+ */
+const gchar*
+g_sgraph_csr_get_payload (GSGraphCsr* csr,
+                          guint32 index,
+                          gsize* length)
+{
+  g_return_val_if_fail (csr != NULL, NULL);
+  g_return_val_if_fail (index < csr->order, NULL);
+
+  if (!csr->payloads)
+  {
+    if (length)
+    {
+      *length = 0;
+    }
+    return NULL;
+  }
+
+  if (length)
+  {
+    *length = csr->payload_offsets[index + 1] - csr->payload_offsets[index];
+  }
+  return csr->payloads + csr->payload_offsets[index];
+}
+
+/* static function definitions. */
+
+/**
+ * _g_sgraph_csr_append_DFS:
+ * @csr: a graph.
+ * @index: index of starting node.
+ * @indices: array where indices of visited nodes are put.
+ * @visited: array of flags, one per node.
+ *
+ * Puts indices of all nodes reachable from node with @index into @indices
+ * using depth first search algorithm. Explicit stack is used instead of
+ * recursion.
+ */
+static void
+_g_sgraph_csr_append_DFS (GSGraphCsr* csr,
+                          guint32 index,
+                          GArray* indices,
+                          guint8* visited)
+{
+  GArray* stack;
+  GSGraphCsrFrame frame;
+
+  stack = g_array_new (FALSE, FALSE, sizeof (GSGraphCsrFrame));
+
+  visited[index] = TRUE;
+  g_array_append_val (indices, index);
+  frame.index = index;
+  frame.position = csr->offsets[index];
+  g_array_append_val (stack, frame);
+
+  while (stack->len)
+  {
+    GSGraphCsrFrame* top;
+    guint32 other_index;
+
+    top = &g_array_index (stack, GSGraphCsrFrame, stack->len - 1);
+    if (top->position == csr->offsets[top->index + 1])
+    {
+      g_array_set_size (stack, stack->len - 1);
+      continue;
+    }
+
+    other_index = csr->neighbours[top->position];
+    ++top->position;
+    if (visited[other_index])
+    {
+      continue;
+    }
+
+    visited[other_index] = TRUE;
+    g_array_append_val (indices, other_index);
+    frame.index = other_index;
+    frame.position = csr->offsets[other_index];
+    g_array_append_val (stack, frame);
+  }
+
+  g_array_free (stack, TRUE);
+}
+
+/**
+ * _g_sgraph_csr_append_BFS:
+ * @csr: a graph.
+ * @index: index of starting node.
+ * @indices: array where indices of visited nodes are put.
+ * @visited: array of flags, one per node.
+ *
+ * Puts indices of all nodes reachable from node with @index into @indices
+ * using breadth first search algorithm. @indices itself serves as a queue.
+ */
+static void
+_g_sgraph_csr_append_BFS (GSGraphCsr* csr,
+                          guint32 index,
+                          GArray* indices,
+                          guint8* visited)
+{
+  guint head;
+
+  visited[index] = TRUE;
+  g_array_append_val (indices, index);
+
+  for (head = 0; head < indices->len; ++head)
+  {
+    guint32 temp_index;
+    guint32 iter;
+
+    temp_index = g_array_index (indices, guint32, head);
+    for (iter = csr->offsets[temp_index];
+         iter < csr->offsets[temp_index + 1];
+         ++iter)
+    {
+      guint32 other_index;
+
+      other_index = csr->neighbours[iter];
+      if (visited[other_index])
+      {
+        continue;
+      }
+
+      visited[other_index] = TRUE;
+      g_array_append_val (indices, other_index);
+    }
+  }
+}
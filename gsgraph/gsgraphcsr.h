@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined (G_DISABLE_SINGLE_INCLUDES) && !defined (_G_SGRAPH_H_INSIDE_) && !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "Only <gsgraph/gsgraph.h> can be included directly."
+#endif
+
+#ifndef _G_SGRAPH_CSR_H_
+#define _G_SGRAPH_CSR_H_
+
+#include <glib.h>
+
+#include <gsgraph/gsgraphenums.h>
+#include <gsgraph/gsgraphsnapshot.h>
+
+G_BEGIN_DECLS
+
+/**
+ * G_SGRAPH_CSR_ERROR:
+ *
+ * Error domain for loading #GSGraphCsr from a file. Errors in this domain will
+ * be from the #GSGraphCsrError enumeration.
+ */
+#define G_SGRAPH_CSR_ERROR g_sgraph_csr_error_quark ()
+
+/**
+ * GSGraphCsrSaveFunc:
+ * @data: data of a node.
+ * @buffer: a buffer to append serialized @data to.
+ * @user_data: user data passed to g_sgraph_csr_save().
+ *
+ * Serializes node data, so it can be saved in a file.
+ */
+typedef void (*GSGraphCsrSaveFunc) (gpointer data,
+                                    GString* buffer,
+                                    gpointer user_data);
+
+/**
+ * GSGraphCsrLoadFunc:
+ * @payload: serialized node data.
+ * @length: length of @payload.
+ * @user_data: user data passed to g_sgraph_csr_load().
+ *
+ * Deserializes node data saved with #GSGraphCsrSaveFunc.
+ *
+ * Returns: node data.
+ */
+typedef gpointer (*GSGraphCsrLoadFunc) (const gchar* payload,
+                                        gsize length,
+                                        gpointer user_data);
+
+/**
+ * GSGraphCsr:
+ * @order: number of nodes.
+ * @size: number of connections.
+ * @offsets: array of @order + 1 offsets into @neighbours. Neighbours of node
+ * with index i are stored between @offsets[i] (inclusive) and @offsets[i + 1]
+ * (exclusive).
+ * @neighbours: array of neighbour indices.
+ * @data: array of @order node data.
+ *
+ * Immutable graph in compressed sparse row form. Node with index i is the i-th
+ * node in node array of #GSGraphSnapshot it was created from.
+ */
+typedef struct _GSGraphCsr GSGraphCsr;
+
+struct _GSGraphCsr
+{
+  guint32 order;
+  guint32 size;
+  guint32* offsets;
+  guint32* neighbours;
+  gpointer* data;
+
+  /*< private >*/
+  GMappedFile* mapped_file;
+  const gchar* payloads;
+  const guint64* payload_offsets;
+};
+
+GQuark
+g_sgraph_csr_error_quark (void);
+
+GSGraphCsr*
+g_sgraph_csr_new (GSGraphSnapshot* graph) G_GNUC_WARN_UNUSED_RESULT;
+
+void
+g_sgraph_csr_free (GSGraphCsr* csr);
+
+guint
+g_sgraph_csr_get_order (GSGraphCsr* csr);
+
+guint
+g_sgraph_csr_get_size (GSGraphCsr* csr);
+
+guint
+g_sgraph_csr_get_degree (GSGraphCsr* csr,
+                         guint32 index);
+
+GArray*
+g_sgraph_csr_traverse (GSGraphCsr* csr,
+                       guint32 index,
+                       GSGraphTraverseType traverse_type) G_GNUC_WARN_UNUSED_RESULT;
+
+GArray*
+g_sgraph_csr_bfs_parallel (GSGraphCsr* csr,
+                           guint32 index,
+                           GArray** parents,
+                           guint n_threads) G_GNUC_WARN_UNUSED_RESULT;
+
+gboolean
+g_sgraph_csr_save (GSGraphCsr* csr,
+                   const gchar* filename,
+                   GSGraphCsrSaveFunc save_func,
+                   gpointer user_data,
+                   GError** error);
+
+GSGraphCsr*
+g_sgraph_csr_load (const gchar* filename,
+                   GSGraphCsrLoadFunc load_func,
+                   gpointer user_data,
+                   GError** error) G_GNUC_WARN_UNUSED_RESULT;
+
+const gchar*
+g_sgraph_csr_get_payload (GSGraphCsr* csr,
+                          guint32 index,
+                          gsize* length);
+
+G_END_DECLS
+
+#endif /* _G_SGRAPH_CSR_H_ */
@@ -0,0 +1,423 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsgraphdataindex.h"
+#include "gsgraphparallel.h"
+
+/* Internal index mapping keys of graph elements to elements. When there are
+ * many shards, the index is built in three passes: first shards of all keys
+ * are computed by many threads, then indices of elements are sorted by their
+ * shards into buckets and finally each shard is filled by a separate thread
+ * with elements from its bucket. Elements are visited in array order, so for
+ * duplicated keys the first element wins, just like linear search would find.
+ */
+
+/* internal types. */
+
+typedef struct _GSGraphDataIndexBuild GSGraphDataIndexBuild;
+
+struct _GSGraphDataIndexBuild
+{
+  GSGraphDataIndex* index;
+  GPtrArray* array;
+  GSGraphDataIndexKeyFunc key_func;
+  guint* shard_ids;
+  guint* buckets;
+  guint* bucket_starts;
+};
+
+/* static function declarations. */
+
+static GSGraphDataIndex*
+_g_sgraph_data_index_new_blank (guint n_shards,
+                                GHashFunc hash_func,
+                                GEqualFunc key_equal_func);
+
+static GHashTable*
+_g_sgraph_data_index_get_shard (GSGraphDataIndex* index,
+                                gconstpointer key);
+
+static void
+_g_sgraph_data_index_hash_element (guint element_index,
+                                   gpointer build);
+
+static void
+_g_sgraph_data_index_fill_buckets (GSGraphDataIndexBuild* build);
+
+static void
+_g_sgraph_data_index_fill_shard (guint shard_index,
+                                 gpointer build);
+
+/* function definitions. */
+
+/**
+ * _g_sgraph_data_index_new:
+ * @array: array of elements to index.
+ * @key_func: function getting a key of an element.
+ * @hash_func: function hashing keys or %NULL for g_direct_hash().
+ * @key_equal_func: function comparing keys or %NULL for g_direct_equal().
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Creates an index of elements in @array by their keys.
+ *
+ * Returns: new #GSGraphDataIndex.
+ */
+GSGraphDataIndex*
+_g_sgraph_data_index_new (GPtrArray* array,
+                          GSGraphDataIndexKeyFunc key_func,
+                          GHashFunc hash_func,
+                          GEqualFunc key_equal_func,
+                          guint n_threads)
+{
+  GSGraphDataIndexBuild build;
+
+  if (!n_threads)
+  {
+    n_threads = 1;
+  }
+  build.index = _g_sgraph_data_index_new_blank (n_threads,
+                                                hash_func,
+                                                key_equal_func);
+  build.array = array;
+  build.key_func = key_func;
+  build.shard_ids = NULL;
+  build.buckets = NULL;
+  build.bucket_starts = NULL;
+
+  if (n_threads == 1)
+  {
+    _g_sgraph_data_index_fill_shard (0, &build);
+    return build.index;
+  }
+
+  build.shard_ids = g_new (guint, array->len);
+  _g_sgraph_parallel_for (array->len,
+                          _g_sgraph_data_index_hash_element,
+                          &build,
+                          n_threads);
+  _g_sgraph_data_index_fill_buckets (&build);
+  _g_sgraph_parallel_for (n_threads,
+                          _g_sgraph_data_index_fill_shard,
+                          &build,
+                          n_threads);
+  g_free (build.bucket_starts);
+  g_free (build.buckets);
+  g_free (build.shard_ids);
+
+  return build.index;
+}
+
+/**
+ * _g_sgraph_data_index_new_from_table:
+ * @table: a #GHashTable with direct hashing, mapping keys to elements.
+ *
+ * Creates an index taking over @table as its only shard.
+ *
+ * Returns: new #GSGraphDataIndex.
+ */
+GSGraphDataIndex*
+_g_sgraph_data_index_new_from_table (GHashTable* table)
+{
+  GSGraphDataIndex* index;
+
+  index = g_slice_new (GSGraphDataIndex);
+  index->shards = g_new (GHashTable*, 1);
+  index->shards[0] = table;
+  index->n_shards = 1;
+  index->hash_func = g_direct_hash;
+  index->key_equal_func = g_direct_equal;
+
+  return index;
+}
+
+/**
+ * _g_sgraph_data_index_free:
+ * @index: an index.
+ *
+ * Frees memory allocated to @index.
+ */
+void
+_g_sgraph_data_index_free (GSGraphDataIndex* index)
+{
+  guint iter;
+
+  for (iter = 0; iter < index->n_shards; ++iter)
+  {
+    g_hash_table_unref (index->shards[iter]);
+  }
+  g_free (index->shards);
+  g_slice_free (GSGraphDataIndex, index);
+}
+
+/**
+ * _g_sgraph_data_index_lookup:
+ * @index: an index.
+ * @key: a key.
+ *
+ * Looks up an element with given @key.
+ *
+ * Returns: found element or %NULL.
+ */
+gpointer
+_g_sgraph_data_index_lookup (GSGraphDataIndex* index,
+                             gconstpointer key)
+{
+  return g_hash_table_lookup (_g_sgraph_data_index_get_shard (index, key), key);
+}
+
+/**
+ * _g_sgraph_data_index_insert:
+ * @index: an index.
+ * @key: a key of @element.
+ * @element: an element.
+ *
+ * Puts @element into @index, unless there already is an element with given
+ * @key.
+ */
+void
+_g_sgraph_data_index_insert (GSGraphDataIndex* index,
+                             gpointer key,
+                             gpointer element)
+{
+  GHashTable* shard;
+
+  shard = _g_sgraph_data_index_get_shard (index, key);
+  if (!g_hash_table_lookup_extended (shard, key, NULL, NULL))
+  {
+    g_hash_table_insert (shard, key, element);
+  }
+}
+
+/**
+ * _g_sgraph_data_index_remove:
+ * @index: an index.
+ * @key: a key of @element.
+ * @element: an element.
+ * @array: array of indexed elements, already without @element.
+ * @key_func: function getting a key of an element.
+ *
+ * Removes @element from @index, if it is the one given @key maps to. In such
+ * case @array is searched for the first element with key equal to @key, which
+ * takes @element's place, so it does not become invisible to lookups. This
+ * takes time linear in length of @array.
+ */
+void
+_g_sgraph_data_index_remove (GSGraphDataIndex* index,
+                             gpointer key,
+                             gpointer element,
+                             GPtrArray* array,
+                             GSGraphDataIndexKeyFunc key_func)
+{
+  GHashTable* shard;
+  guint iter;
+
+  shard = _g_sgraph_data_index_get_shard (index, key);
+  if (g_hash_table_lookup (shard, key) != element)
+  {
+    return;
+  }
+  g_hash_table_remove (shard, key);
+  for (iter = 0; iter < array->len; ++iter)
+  {
+    gpointer other;
+    gpointer other_key;
+
+    other = g_ptr_array_index (array, iter);
+    other_key = (*key_func) (other);
+    if ((*index->key_equal_func) (other_key, key))
+    {
+      g_hash_table_insert (shard, other_key, other);
+      break;
+    }
+  }
+}
+
+/* static function definitions. */
+
+/**
+ * _g_sgraph_data_index_new_blank:
+ * @n_shards: number of shards.
+ * @hash_func: function hashing keys or %NULL for g_direct_hash().
+ * @key_equal_func: function comparing keys or %NULL for g_direct_equal().
+ *
+ * Creates an index with @n_shards empty shards.
+ *
+ * Returns: new #GSGraphDataIndex.
+ */
+static GSGraphDataIndex*
+_g_sgraph_data_index_new_blank (guint n_shards,
+                                GHashFunc hash_func,
+                                GEqualFunc key_equal_func)
+{
+  GSGraphDataIndex* index;
+  guint iter;
+
+  if (!hash_func)
+  {
+    hash_func = g_direct_hash;
+  }
+  if (!key_equal_func)
+  {
+    key_equal_func = g_direct_equal;
+  }
+
+  index = g_slice_new (GSGraphDataIndex);
+  index->shards = g_new (GHashTable*, n_shards);
+  for (iter = 0; iter < n_shards; ++iter)
+  {
+    index->shards[iter] = g_hash_table_new (hash_func, key_equal_func);
+  }
+  index->n_shards = n_shards;
+  index->hash_func = hash_func;
+  index->key_equal_func = key_equal_func;
+
+  return index;
+}
+
+/**
+ * _g_sgraph_data_index_get_shard:
+ * @index: an index.
+ * @key: a key.
+ *
+ * Gets a shard which @key lives in.
+ *
+ * Returns: a #GHashTable.
+ */
+static GHashTable*
+_g_sgraph_data_index_get_shard (GSGraphDataIndex* index,
+                                gconstpointer key)
+{
+  if (index->n_shards == 1)
+  {
+    return index->shards[0];
+  }
+  return index->shards[(*index->hash_func) (key) % index->n_shards];
+}
+
+/**
+ * _g_sgraph_data_index_hash_element:
+ * @element_index: index of an element in array.
+ * @build: a #GSGraphDataIndexBuild.
+ *
+ * Computes a shard of key of an element at @element_index. Called from
+ * many threads, each for different elements.
+ */
+static void
+_g_sgraph_data_index_hash_element (guint element_index,
+                                   gpointer build)
+{
+  GSGraphDataIndexBuild* index_build;
+  gpointer key;
+
+  index_build = build;
+  key = (*index_build->key_func) (g_ptr_array_index (index_build->array,
+                                                     element_index));
+  index_build->shard_ids[element_index] =
+    (*index_build->index->hash_func) (key) % index_build->index->n_shards;
+}
+
+/**
+ * _g_sgraph_data_index_fill_buckets:
+ * @build: a #GSGraphDataIndexBuild.
+ *
+ * Sorts indices of elements by their shards, so each shard gets its own
+ * bucket of indices, still in array order. Bucket of shard @i starts at
+ * @build->bucket_starts[@i] and ends where bucket of shard @i + 1 starts.
+ */
+static void
+_g_sgraph_data_index_fill_buckets (GSGraphDataIndexBuild* build)
+{
+  guint n_shards;
+  guint iter;
+
+  n_shards = build->index->n_shards;
+  build->buckets = g_new (guint, build->array->len);
+  build->bucket_starts = g_new0 (guint, n_shards + 1);
+  for (iter = 0; iter < build->array->len; ++iter)
+  {
+    ++build->bucket_starts[build->shard_ids[iter] + 1];
+  }
+  for (iter = 0; iter < n_shards; ++iter)
+  {
+    build->bucket_starts[iter + 1] += build->bucket_starts[iter];
+  }
+  /* bucket starts are used as cursors here, so afterwards each of them
+   * points to a start of next bucket and they have to be shifted back. */
+  for (iter = 0; iter < build->array->len; ++iter)
+  {
+    build->buckets[build->bucket_starts[build->shard_ids[iter]]++] = iter;
+  }
+  for (iter = n_shards; iter > 0; --iter)
+  {
+    build->bucket_starts[iter] = build->bucket_starts[iter - 1];
+  }
+  build->bucket_starts[0] = 0;
+}
+
+/**
+ * _g_sgraph_data_index_fill_shard:
+ * @shard_index: index of a shard.
+ * @build: a #GSGraphDataIndexBuild.
+ *
+ * Puts elements from bucket of shard at @shard_index into this shard or, if
+ * there are no buckets, all elements into the only shard. Called from many
+ * threads, each for different shard.
+ */
+static void
+_g_sgraph_data_index_fill_shard (guint shard_index,
+                                 gpointer build)
+{
+  GSGraphDataIndexBuild* index_build;
+  GHashTable* shard;
+  guint iter;
+  guint end;
+
+  index_build = build;
+  shard = index_build->index->shards[shard_index];
+  if (index_build->buckets)
+  {
+    iter = index_build->bucket_starts[shard_index];
+    end = index_build->bucket_starts[shard_index + 1];
+  }
+  else
+  {
+    iter = 0;
+    end = index_build->array->len;
+  }
+  for (; iter < end; ++iter)
+  {
+    gpointer element;
+    gpointer key;
+
+    if (index_build->buckets)
+    {
+      element = g_ptr_array_index (index_build->array,
+                                   index_build->buckets[iter]);
+    }
+    else
+    {
+      element = g_ptr_array_index (index_build->array, iter);
+    }
+    key = (*index_build->key_func) (element);
+    if (!g_hash_table_lookup_extended (shard, key, NULL, NULL))
+    {
+      g_hash_table_insert (shard, key, element);
+    }
+  }
+}
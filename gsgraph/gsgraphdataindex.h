@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "This is a private header, it must not be included outside libggraph."
+#endif
+
+#ifndef _G_SGRAPH_DATA_INDEX_H_
+#define _G_SGRAPH_DATA_INDEX_H_
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GSGraphDataIndexKeyFunc:
+ * @element: an indexed element.
+ *
+ * Gets a key of @element, usually its data.
+ *
+ * Returns: key of @element.
+ */
+typedef gpointer (*GSGraphDataIndexKeyFunc) (gpointer element);
+
+/**
+ * GSGraphDataIndex:
+ * @shards: array of #GHashTable<!-- -->s mapping keys to elements.
+ * @n_shards: length of @shards.
+ * @hash_func: function used to choose a shard for a key.
+ * @key_equal_func: function comparing keys.
+ *
+ * Internal index of graph elements by their keys. Every key lives in a shard
+ * chosen by its hash, so shards can be filled by separate threads.
+ */
+typedef struct _GSGraphDataIndex GSGraphDataIndex;
+
+struct _GSGraphDataIndex
+{
+  GHashTable** shards;
+  guint n_shards;
+  GHashFunc hash_func;
+  GEqualFunc key_equal_func;
+};
+
+G_GNUC_INTERNAL GSGraphDataIndex*
+_g_sgraph_data_index_new (GPtrArray* array,
+                          GSGraphDataIndexKeyFunc key_func,
+                          GHashFunc hash_func,
+                          GEqualFunc key_equal_func,
+                          guint n_threads);
+
+G_GNUC_INTERNAL GSGraphDataIndex*
+_g_sgraph_data_index_new_from_table (GHashTable* table);
+
+G_GNUC_INTERNAL void
+_g_sgraph_data_index_free (GSGraphDataIndex* index);
+
+G_GNUC_INTERNAL gpointer
+_g_sgraph_data_index_lookup (GSGraphDataIndex* index,
+                             gconstpointer key);
+
+G_GNUC_INTERNAL void
+_g_sgraph_data_index_insert (GSGraphDataIndex* index,
+                             gpointer key,
+                             gpointer element);
+
+G_GNUC_INTERNAL void
+_g_sgraph_data_index_remove (GSGraphDataIndex* index,
+                             gpointer key,
+                             gpointer element,
+                             GPtrArray* array,
+                             GSGraphDataIndexKeyFunc key_func);
+
+G_END_DECLS
+
+#endif /* _G_SGRAPH_DATA_INDEX_H_ */
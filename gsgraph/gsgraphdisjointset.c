@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsgraphdisjointset.h"
+
+/* Internal disjoint-set forest. Elements are dense indices handed out by
+ * _g_sgraph_disjoint_set_add(), so callers keep their own mapping from nodes
+ * to elements. Union by size together with path compression makes a sequence
+ * of operations run in nearly linear time.
+ */
+
+/* function definitions. */
+
+/**
+ * _g_sgraph_disjoint_set_new:
+ * @reserved_size: number of elements to reserve memory for.
+ *
+ * Creates new empty disjoint-set forest.
+ *
+ * Returns: new #GSGraphDisjointSet.
+ */
+GSGraphDisjointSet*
+_g_sgraph_disjoint_set_new (guint reserved_size)
+{
+  GSGraphDisjointSet* set;
+
+  set = g_slice_new (GSGraphDisjointSet);
+  set->parents = g_array_sized_new (FALSE,
+                                    FALSE,
+                                    sizeof (guint),
+                                    reserved_size);
+  set->sizes = g_array_sized_new (FALSE,
+                                  FALSE,
+                                  sizeof (guint),
+                                  reserved_size);
+
+  return set;
+}
+
+/**
+ * _g_sgraph_disjoint_set_free:
+ * @set: a set.
+ *
+ * Frees memory allocated to @set.
+ */
+void
+_g_sgraph_disjoint_set_free (GSGraphDisjointSet* set)
+{
+  g_array_free (set->parents, TRUE);
+  g_array_free (set->sizes, TRUE);
+  g_slice_free (GSGraphDisjointSet, set);
+}
+
+/**
+ * _g_sgraph_disjoint_set_add:
+ * @set: a set.
+ *
+ * Adds new element being its own set.
+ *
+ * Returns: index of new element.
+ */
+guint
+_g_sgraph_disjoint_set_add (GSGraphDisjointSet* set)
+{
+  guint element;
+  guint size;
+
+  element = set->parents->len;
+  size = 1;
+  g_array_append_val (set->parents, element);
+  g_array_append_val (set->sizes, size);
+
+  return element;
+}
+
+/**
+ * _g_sgraph_disjoint_set_find:
+ * @set: a set.
+ * @element: an element.
+ *
+ * Finds representative of set containing @element. All elements on the path
+ * from @element to the representative are made its direct children.
+ *
+ * Returns: representative element.
+ */
+guint
+_g_sgraph_disjoint_set_find (GSGraphDisjointSet* set,
+                             guint element)
+{
+  guint* parents;
+  guint root;
+
+  parents = (guint*)set->parents->data;
+  root = element;
+  while (parents[root] != root)
+  {
+    root = parents[root];
+  }
+
+  while (parents[element] != root)
+  {
+    guint next;
+
+    next = parents[element];
+    parents[element] = root;
+    element = next;
+  }
+
+  return root;
+}
+
+/**
+ * _g_sgraph_disjoint_set_union:
+ * @set: a set.
+ * @element: an element.
+ * @other_element: other element.
+ *
+ * Joins sets containing @element and @other_element. Representative of larger
+ * set becomes the representative of the joined one.
+ *
+ * Returns: %TRUE if sets were separate, %FALSE if they already were one set.
+ */
+gboolean
+_g_sgraph_disjoint_set_union (GSGraphDisjointSet* set,
+                              guint element,
+                              guint other_element)
+{
+  guint* parents;
+  guint* sizes;
+  guint root;
+  guint other_root;
+
+  root = _g_sgraph_disjoint_set_find (set, element);
+  other_root = _g_sgraph_disjoint_set_find (set, other_element);
+  if (root == other_root)
+  {
+    return FALSE;
+  }
+
+  parents = (guint*)set->parents->data;
+  sizes = (guint*)set->sizes->data;
+  if (sizes[root] < sizes[other_root])
+  {
+    guint temp;
+
+    temp = root;
+    root = other_root;
+    other_root = temp;
+  }
+  parents[other_root] = root;
+  sizes[root] += sizes[other_root];
+
+  return TRUE;
+}
+
+/**
+ * _g_sgraph_disjoint_set_get_set_size:
+ * @set: a set.
+ * @element: an element.
+ *
+ * Gets number of elements in set containing @element.
+ *
+ * Returns: size of a set.
+ */
+guint
+_g_sgraph_disjoint_set_get_set_size (GSGraphDisjointSet* set,
+                                     guint element)
+{
+  guint root;
+
+  root = _g_sgraph_disjoint_set_find (set, element);
+  return g_array_index (set->sizes, guint, root);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "This is a private header, it must not be included outside libggraph."
+#endif
+
+#ifndef _G_SGRAPH_DISJOINT_SET_H_
+#define _G_SGRAPH_DISJOINT_SET_H_
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GSGraphDisjointSet:
+ * @parents: #GArray of #guint parent of each element.
+ * @sizes: #GArray of #guint sizes of sets, valid only for roots.
+ *
+ * Internal disjoint-set forest over dense #guint elements, using union by size
+ * and path compression.
+ */
+typedef struct _GSGraphDisjointSet GSGraphDisjointSet;
+
+struct _GSGraphDisjointSet
+{
+  GArray* parents;
+  GArray* sizes;
+};
+
+G_GNUC_INTERNAL GSGraphDisjointSet*
+_g_sgraph_disjoint_set_new (guint reserved_size);
+
+G_GNUC_INTERNAL void
+_g_sgraph_disjoint_set_free (GSGraphDisjointSet* set);
+
+G_GNUC_INTERNAL guint
+_g_sgraph_disjoint_set_add (GSGraphDisjointSet* set);
+
+G_GNUC_INTERNAL guint
+_g_sgraph_disjoint_set_find (GSGraphDisjointSet* set,
+                             guint element);
+
+G_GNUC_INTERNAL gboolean
+_g_sgraph_disjoint_set_union (GSGraphDisjointSet* set,
+                              guint element,
+                              guint other_element);
+
+G_GNUC_INTERNAL guint
+_g_sgraph_disjoint_set_get_set_size (GSGraphDisjointSet* set,
+                                     guint element);
+
+G_END_DECLS
+
+#endif /* _G_SGRAPH_DISJOINT_SET_H_ */
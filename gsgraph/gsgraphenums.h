@@ -50,6 +50,83 @@ typedef enum
   G_SGRAPH_TRAVERSE_DFS
 } GSGraphTraverseType;
 
+/**
+ * GSGraphVisitResult:
+ * @G_SGRAPH_VISIT_CONTINUE: Continue traversal.
+ * @G_SGRAPH_VISIT_SKIP_CHILDREN: Continue traversal, but do not go through
+ * neighbours of visited node.
+ * @G_SGRAPH_VISIT_STOP: Stop traversal.
+ *
+ * Returned by #GSGraphVisitFunc to tell how traversal should go on.
+ */
+typedef enum
+{
+  G_SGRAPH_VISIT_CONTINUE,
+  G_SGRAPH_VISIT_SKIP_CHILDREN,
+  G_SGRAPH_VISIT_STOP
+} GSGraphVisitResult;
+
+/**
+ * GSGraphCsrError:
+ * @G_SGRAPH_CSR_ERROR_FORMAT: File is not a simple graph file or it is
+ * damaged.
+ * @G_SGRAPH_CSR_ERROR_VERSION: File has unsupported version.
+ * @G_SGRAPH_CSR_ERROR_BYTE_ORDER: File was written on a machine with different
+ * byte order.
+ *
+ * Error codes returned by g_sgraph_csr_load().
+ */
+typedef enum
+{
+  G_SGRAPH_CSR_ERROR_FORMAT,
+  G_SGRAPH_CSR_ERROR_VERSION,
+  G_SGRAPH_CSR_ERROR_BYTE_ORDER
+} GSGraphCsrError;
+
+/**
+ * GSGraphOrdering:
+ * @G_SGRAPH_ORDERING_RCM: Reverse Cuthill-McKee order. Neighbouring nodes get
+ * close positions, which keeps bandwidth of adjacency matrix low.
+ * @G_SGRAPH_ORDERING_DEGREE: Nodes with highest degrees go first.
+ * @G_SGRAPH_ORDERING_BFS: Order of breadth first search.
+ *
+ * Used to specify order nodes are put in by g_sgraph_snapshot_reorder().
+ */
+typedef enum
+{
+  G_SGRAPH_ORDERING_RCM,
+  G_SGRAPH_ORDERING_DEGREE,
+  G_SGRAPH_ORDERING_BFS
+} GSGraphOrdering;
+
+/**
+ * GSGraphEdgeListFormat:
+ * @G_SGRAPH_EDGE_LIST_INTEGERS: Text with one pair of unsigned 32-bit integer
+ * keys per line.
+ * @G_SGRAPH_EDGE_LIST_STRINGS: Text with one pair of string keys per line.
+ * @G_SGRAPH_EDGE_LIST_BINARY: Stream of pairs of unsigned 32-bit integer keys
+ * in native byte order.
+ *
+ * Used to specify format of edge list read by g_sgraph_builder_load_file().
+ */
+typedef enum
+{
+  G_SGRAPH_EDGE_LIST_INTEGERS,
+  G_SGRAPH_EDGE_LIST_STRINGS,
+  G_SGRAPH_EDGE_LIST_BINARY
+} GSGraphEdgeListFormat;
+
+/**
+ * GSGraphBuilderError:
+ * @G_SGRAPH_BUILDER_ERROR_PARSE: Edge list is malformed.
+ *
+ * Error codes returned by g_sgraph_builder_load_file().
+ */
+typedef enum
+{
+  G_SGRAPH_BUILDER_ERROR_PARSE
+} GSGraphBuilderError;
+
 G_END_DECLS
 
 #endif /* _G_SGRAPH_ENUMS_H_ */
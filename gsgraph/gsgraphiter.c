@@ -0,0 +1,410 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsgraphiter.h"
+#include "gsgraphiterprivate.h"
+
+/**
+ * SECTION: gsgraphiter
+ * @title: Simple graph iterator
+ * @short_description: traversal returning nodes one by one.
+ * @include: gsgraph/gsgraph.h
+ * @see_also: #GSGraphNode, #GSGraphTraverseType, #GSGraphSnapshot
+ *
+ * Iterator traversing a graph from given node and returning nodes one by one,
+ * in the same order g_sgraph_snapshot_new_from_node() puts them into its
+ * array. Work is done only when next node is requested, so traversal can be
+ * stopped early without visiting whole graph and without keeping an array of
+ * all its nodes.
+ *
+ * To create an iterator, use g_sgraph_iter_new().
+ *
+ * To get next node, use g_sgraph_iter_next().
+ *
+ * To free an iterator, use g_sgraph_iter_free().
+ *
+ * <note>
+ *   <para>
+ *     Graph must not be changed while it is traversed by an iterator. Visited
+ *     nodes are remembered in a hash table owned by iterator, so many
+ *     iterators can traverse the same graph at the same time.
+ *   </para>
+ * </note>
+ */
+
+/* internal macros */
+
+/**
+ * G_SGRAPH_ITER_COMPACT_THRESHOLD:
+ *
+ * Number of already expanded nodes in breadth first search queue, above which
+ * they are removed from the queue if they take at least half of it.
+ */
+#define G_SGRAPH_ITER_COMPACT_THRESHOLD 1024
+
+/* static function declarations. */
+
+static GSGraphNode*
+_g_sgraph_iter_next_DFS (GSGraphIter* iter);
+
+static GSGraphNode*
+_g_sgraph_iter_next_BFS (GSGraphIter* iter);
+
+/* public function definitions. */
+
+/**
+ * g_sgraph_iter_new:
+ * @node: a node traversal starts from.
+ * @traverse_type: which traversing algorithm to use.
+ *
+ * Creates an iterator over all nodes reachable from @node, @node included.
+ *
+ * Returns: newly created #GSGraphIter.
+ */
+GSGraphIter*
+g_sgraph_iter_new (GSGraphNode* node,
+                   GSGraphTraverseType traverse_type)
+{
+  GSGraphIter* iter;
+
+  g_return_val_if_fail (node != NULL, NULL);
+  g_return_val_if_fail ((traverse_type == G_SGRAPH_TRAVERSE_BFS) ||
+                        (traverse_type == G_SGRAPH_TRAVERSE_DFS), NULL);
+
+  iter = g_slice_new (GSGraphIter);
+  _g_sgraph_iter_init (iter, node, traverse_type, FALSE);
+
+  return iter;
+}
+
+/**
+ * g_sgraph_iter_next:
+ * @iter: an iterator.
+ *
+ * Gets next node of traversal.
+ *
+ * Returns: next node or %NULL if all reachable nodes were already returned.
+ */
+GSGraphNode*
+g_sgraph_iter_next (GSGraphIter* iter)
+{
+  g_return_val_if_fail (iter != NULL, NULL);
+
+  if (iter->start)
+  {
+    GSGraphNode* node;
+
+    node = iter->start;
+    iter->start = NULL;
+    return node;
+  }
+
+  switch (iter->traverse_type)
+  {
+    case G_SGRAPH_TRAVERSE_BFS:
+    {
+      return _g_sgraph_iter_next_BFS (iter);
+    }
+    case G_SGRAPH_TRAVERSE_DFS:
+    {
+      return _g_sgraph_iter_next_DFS (iter);
+    }
+    default:
+    {
+      g_return_val_if_reached (NULL);
+    }
+  }
+}
+
+/**
+ * g_sgraph_iter_free:
+ * @iter: an iterator to free.
+ *
+ * Frees @iter. Traversed graph is left untouched.
+ */
+void
+g_sgraph_iter_free (GSGraphIter* iter)
+{
+  g_return_if_fail (iter != NULL);
+
+  _g_sgraph_iter_clear (iter);
+  g_slice_free (GSGraphIter, iter);
+}
+
+/* internal function definitions. */
+
+/**
+ * _g_sgraph_iter_init:
+ * @iter: an iterator to initialize.
+ * @node: a node traversal starts from.
+ * @traverse_type: which traversing algorithm to use.
+ * @use_marks: whether visit marks in nodes can be used.
+ *
+ * Prepares @iter for traversal starting from @node. If @use_marks is %TRUE,
+ * visited set may hold the domain lock until _g_sgraph_iter_clear() is called,
+ * so it should be used only by traversals done within a single function.
+ */
+void
+_g_sgraph_iter_init (GSGraphIter* iter,
+                     GSGraphNode* node,
+                     GSGraphTraverseType traverse_type,
+                     gboolean use_marks)
+{
+  iter->traverse_type = traverse_type;
+  iter->start = node;
+  iter->stack = NULL;
+  iter->queue = NULL;
+  iter->head = 0;
+  iter->position = 0;
+  iter->level_end = 1;
+  iter->depth = 0;
+  iter->last_depth = 0;
+  iter->max_depth = G_MAXUINT;
+  iter->filter_func = NULL;
+  iter->filter_data = NULL;
+
+  if (use_marks)
+  {
+    _g_sgraph_visited_init (&iter->visited, G_SGRAPH_VISITED_DOMAIN_SGRAPH, 1);
+  }
+  else
+  {
+    _g_sgraph_visited_init_table (&iter->visited,
+                                  G_SGRAPH_VISITED_DOMAIN_SGRAPH,
+                                  1);
+  }
+  _g_sgraph_visited_set (&iter->visited, node, &node->visit_mark, 1);
+
+  if (traverse_type == G_SGRAPH_TRAVERSE_DFS)
+  {
+    GSGraphIterFrame frame;
+
+    iter->stack = g_array_new (FALSE, FALSE, sizeof (GSGraphIterFrame));
+    frame.node = node;
+    frame.position = 0;
+    g_array_append_val (iter->stack, frame);
+  }
+  else
+  {
+    iter->queue = g_ptr_array_new ();
+    g_ptr_array_add (iter->queue, node);
+  }
+}
+
+/**
+ * _g_sgraph_iter_set_limits:
+ * @iter: an iterator, which did not return any node yet.
+ * @max_depth: depth of nodes whose neighbours are not checked.
+ * @filter_func: function deciding which neighbours can be followed or %NULL.
+ * @filter_data: data passed to @filter_func.
+ *
+ * Limits traversal done by @iter to nodes at most @max_depth steps away from
+ * starting node, going only to neighbours accepted by @filter_func.
+ */
+void
+_g_sgraph_iter_set_limits (GSGraphIter* iter,
+                           guint max_depth,
+                           GSGraphFilterFunc filter_func,
+                           gpointer filter_data)
+{
+  iter->max_depth = max_depth;
+  iter->filter_func = filter_func;
+  iter->filter_data = filter_data;
+}
+
+/**
+ * _g_sgraph_iter_get_depth:
+ * @iter: an iterator.
+ *
+ * Gets depth of last node returned by @iter. In breadth first search it is
+ * a distance from starting node, in depth first search it is a depth in the
+ * search tree.
+ *
+ * Returns: depth of last returned node.
+ */
+guint
+_g_sgraph_iter_get_depth (GSGraphIter* iter)
+{
+  return iter->last_depth;
+}
+
+/**
+ * _g_sgraph_iter_skip_children:
+ * @iter: an iterator.
+ *
+ * Makes @iter not check neighbours of last returned node. Nodes reachable only
+ * through that node will not be returned.
+ */
+void
+_g_sgraph_iter_skip_children (GSGraphIter* iter)
+{
+  if (iter->stack)
+  {
+    g_array_set_size (iter->stack, iter->stack->len - 1);
+  }
+  else
+  {
+    g_ptr_array_set_size (iter->queue, iter->queue->len - 1);
+  }
+}
+
+/**
+ * _g_sgraph_iter_clear:
+ * @iter: an iterator.
+ *
+ * Frees memory allocated by @iter, but not @iter itself.
+ */
+void
+_g_sgraph_iter_clear (GSGraphIter* iter)
+{
+  if (iter->stack)
+  {
+    g_array_free (iter->stack, TRUE);
+  }
+  if (iter->queue)
+  {
+    g_ptr_array_free (iter->queue, TRUE);
+  }
+  _g_sgraph_visited_clear (&iter->visited);
+}
+
+/* static function definitions. */
+
+/**
+ * _g_sgraph_iter_next_DFS:
+ * @iter: an iterator.
+ *
+ * Gets next node using depth first search algorithm. Instead of recursion, an
+ * explicit stack is used, so long paths do not exhaust thread's stack.
+ *
+ * Returns: next node or %NULL if traversal is finished.
+ */
+static GSGraphNode*
+_g_sgraph_iter_next_DFS (GSGraphIter* iter)
+{
+  GArray* stack;
+
+  stack = iter->stack;
+  while (stack->len)
+  {
+    GSGraphIterFrame* top;
+    GSGraphIterFrame frame;
+    GSGraphNode* other_node;
+
+    top = &g_array_index (stack, GSGraphIterFrame, stack->len - 1);
+    if ((top->position == top->node->neighbours->len) ||
+        (stack->len > iter->max_depth))
+    {
+      g_array_set_size (stack, stack->len - 1);
+      continue;
+    }
+
+    other_node = g_ptr_array_index (top->node->neighbours, top->position);
+    ++top->position;
+    if (iter->filter_func && !(*iter->filter_func) (top->node,
+                                                     other_node,
+                                                     iter->filter_data))
+    {
+      continue;
+    }
+    if (_g_sgraph_visited_check (&iter->visited,
+                                 other_node,
+                                 &other_node->visit_mark))
+    {
+      continue;
+    }
+
+    iter->last_depth = stack->len;
+    frame.node = other_node;
+    frame.position = 0;
+    g_array_append_val (stack, frame);
+    return other_node;
+  }
+
+  return NULL;
+}
+
+/**
+ * _g_sgraph_iter_next_BFS:
+ * @iter: an iterator.
+ *
+ * Gets next node using breadth first search algorithm. Expanded nodes are
+ * dropped from the front of the queue from time to time, so it does not grow
+ * to the size of whole graph.
+ *
+ * Returns: next node or %NULL if traversal is finished.
+ */
+static GSGraphNode*
+_g_sgraph_iter_next_BFS (GSGraphIter* iter)
+{
+  GPtrArray* queue;
+
+  queue = iter->queue;
+  while (iter->head < queue->len)
+  {
+    GSGraphNode* node;
+    GSGraphNode* other_node;
+
+    if (iter->depth >= iter->max_depth)
+    {
+      break;
+    }
+
+    node = g_ptr_array_index (queue, iter->head);
+    if (iter->position == node->neighbours->len)
+    {
+      ++iter->head;
+      iter->position = 0;
+      if (iter->head == iter->level_end)
+      {
+        ++iter->depth;
+        iter->level_end = queue->len;
+      }
+      continue;
+    }
+
+    other_node = g_ptr_array_index (node->neighbours, iter->position);
+    ++iter->position;
+    if (iter->filter_func && !(*iter->filter_func) (node,
+                                                     other_node,
+                                                     iter->filter_data))
+    {
+      continue;
+    }
+    if (_g_sgraph_visited_check (&iter->visited,
+                                 other_node,
+                                 &other_node->visit_mark))
+    {
+      continue;
+    }
+
+    if ((iter->head >= G_SGRAPH_ITER_COMPACT_THRESHOLD) &&
+        (iter->head * 2 >= queue->len))
+    {
+      g_ptr_array_remove_range (queue, 0, iter->head);
+      iter->level_end -= iter->head;
+      iter->head = 0;
+    }
+    iter->last_depth = iter->depth + 1;
+    g_ptr_array_add (queue, other_node);
+    return other_node;
+  }
+
+  return NULL;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "This is a private header, it must not be included outside libggraph."
+#endif
+
+#ifndef _G_SGRAPH_ITER_PRIVATE_H_
+#define _G_SGRAPH_ITER_PRIVATE_H_
+
+#include <glib.h>
+
+#include "gsgraphiter.h"
+#include "gsgraphvisited.h"
+
+G_BEGIN_DECLS
+
+/**
+ * GSGraphIterFrame:
+ * @node: a node.
+ * @position: index of next neighbour of @node to check.
+ *
+ * Internal struct used as a depth first search stack frame.
+ */
+typedef struct _GSGraphIterFrame GSGraphIterFrame;
+
+struct _GSGraphIterFrame
+{
+  GSGraphNode* node;
+  guint position;
+};
+
+/**
+ * GSGraphIter:
+ * @traverse_type: traversing algorithm.
+ * @visited: a set of already visited nodes.
+ * @start: node to be returned first or %NULL if it was already returned.
+ * @stack: array of #GSGraphIterFrame, used in depth first search.
+ * @queue: array of discovered nodes, used in breadth first search.
+ * @head: index of node in @queue whose neighbours are checked.
+ * @position: index of next neighbour of node at @head to check.
+ * @level_end: index in @queue of first node deeper than node at @head.
+ * @depth: depth of node at @head.
+ * @last_depth: depth of last returned node.
+ * @max_depth: depth of nodes whose neighbours are not checked.
+ * @filter_func: function deciding which neighbours can be followed or %NULL.
+ * @filter_data: data passed to @filter_func.
+ *
+ * Internal state of a traversal.
+ */
+struct _GSGraphIter
+{
+  GSGraphTraverseType traverse_type;
+  GSGraphVisited visited;
+  GSGraphNode* start;
+  GArray* stack;
+  GPtrArray* queue;
+  guint head;
+  guint position;
+  guint level_end;
+  guint depth;
+  guint last_depth;
+  guint max_depth;
+  GSGraphFilterFunc filter_func;
+  gpointer filter_data;
+};
+
+G_GNUC_INTERNAL void
+_g_sgraph_iter_init (GSGraphIter* iter,
+                     GSGraphNode* node,
+                     GSGraphTraverseType traverse_type,
+                     gboolean use_marks);
+
+G_GNUC_INTERNAL void
+_g_sgraph_iter_set_limits (GSGraphIter* iter,
+                           guint max_depth,
+                           GSGraphFilterFunc filter_func,
+                           gpointer filter_data);
+
+G_GNUC_INTERNAL guint
+_g_sgraph_iter_get_depth (GSGraphIter* iter);
+
+G_GNUC_INTERNAL void
+_g_sgraph_iter_skip_children (GSGraphIter* iter);
+
+G_GNUC_INTERNAL void
+_g_sgraph_iter_clear (GSGraphIter* iter);
+
+G_END_DECLS
+
+#endif /* _G_SGRAPH_ITER_PRIVATE_H_ */
@@ -18,6 +18,11 @@
  */
 
 #include "gsgraphnode.h"
+#include "gsgraphnodeprivate.h"
+#include "gsgraphconnectivityprivate.h"
+#include "gsgrapharenaprivate.h"
+#include "gsgraphiterprivate.h"
+#include "gsgraphvisited.h"
 
 /**
  * SECTION: gsgraphnode
@@ -29,24 +34,55 @@
  * it's neighbours. If you want to have multiple edges, loops, data on edges,
  * half-edges - use #GSEGraphNode.
  *
- * To create a single node, use g_sgraph_node_new().
+ * To create a single node, use g_sgraph_node_new() or
+ * g_sgraph_node_new_in_arena().
  *
  * To connect two nodes, use g_sgraph_node_connect().
  *
  * To disconnect two nodes, use g_sgraph_node_disconnect().
  *
- * To free a node, use g_sgraph_node_free().
+ * To check if two nodes are neighbours, use g_sgraph_node_is_neighbour().
+ *
+ * To free a node, use g_sgraph_node_free(). To disconnect a node from all its
+ * neighbours and free it, use g_sgraph_node_remove(). To do it with many nodes
+ * at once, use g_sgraph_node_remove_batch().
  *
  * To check if two nodes are in separate graphs, use
- * g_sgraph_node_are_separate().
+ * g_sgraph_node_are_separate() or g_sgraph_node_are_separate_bidirectional().
+ * If many such checks are needed, add nodes to #GSGraphConnectivity first.
+ *
+ * To visit nodes near given one, use g_sgraph_node_visit(). It can limit depth
+ * of traversal, skip parts of graph and stop early, so it does work
+ * proportional to the number of visited nodes, not to the order of the graph.
+ *
+ * Nodes with more than 32 neighbours also keep a hash table mapping
+ * neighbours to their positions in neighbours array, so connecting,
+ * disconnecting and checking neighbourhood of such nodes takes expected
+ * constant time instead of time linear in their degree.
  *
  * <note>
  *   <para>
  *     Remember to always take care about data node holds.
  *   </para>
+ *   <para>
+ *     Neighbours array can be freely read, but must not be modified directly.
+ *     Disconnecting a neighbour of node having a position index moves its last
+ *     neighbour into freed position instead of shifting all following
+ *     neighbours, so order of neighbours of such nodes is not preserved.
+ *   </para>
  * </note>
  */
 
+/* internal macros */
+
+/**
+ * G_SGRAPH_NODE_INDEX_THRESHOLD:
+ *
+ * Degree above which a node keeps a position index of its neighbours. The
+ * index is dropped when degree falls below half of it.
+ */
+#define G_SGRAPH_NODE_INDEX_THRESHOLD 32
+
 /* internal types */
 
 typedef enum
@@ -57,12 +93,48 @@ typedef enum
   G_SGRAPH_NODE_BOTH = G_SGRAPH_NODE_FIRST | G_SGRAPH_NODE_SECOND
 } GSGraphConstructFlags;
 
+/**
+ * GSGraphNodeFrame:
+ * @node: a node.
+ * @position: index of next neighbour of @node to check.
+ *
+ * Internal struct used as a depth first search stack frame.
+ */
+typedef struct _GSGraphNodeFrame GSGraphNodeFrame;
+
+struct _GSGraphNodeFrame
+{
+  GSGraphNode* node;
+  guint position;
+};
+
 /* static declarations */
 
+static GSGraphNode*
+_g_sgraph_node_new_general (GSGraphArena* arena,
+                            gpointer data);
+
 static gboolean
 _g_sgraph_node_connection_check (GSGraphNode* sgraph_node,
                                  GSGraphNode* other_sgraph_node,
-                                 GHashTable* visited_nodes);
+                                 GSGraphVisited* visited);
+
+static gboolean
+_g_sgraph_node_expand_frontier (GPtrArray** frontier,
+                                GSGraphVisited* visited,
+                                guint32 side);
+
+static void
+_g_sgraph_node_add_neighbour (GSGraphNode* node,
+                              GSGraphNode* neighbour);
+
+static gboolean
+_g_sgraph_node_remove_neighbour (GSGraphNode* node,
+                                 GSGraphNode* neighbour);
+
+static gboolean
+_g_sgraph_node_has_neighbour (GSGraphNode* node,
+                              GSGraphNode* neighbour);
 
 /* function definitions */
 
@@ -77,12 +149,26 @@ _g_sgraph_node_connection_check (GSGraphNode* sgraph_node,
 GSGraphNode*
 g_sgraph_node_new (gpointer data)
 {
-  GSGraphNode* node;
+  return _g_sgraph_node_new_general (NULL, data);
+}
 
-  node = g_slice_new (GSGraphNode);
-  node->data = data;
-  node->neighbours = g_ptr_array_new ();
-  return node;
+/**
+ * g_sgraph_node_new_in_arena:
+ * @arena: an arena.
+ * @data: data.
+ *
+ * Creates new node holding @data with memory taken from @arena. Such node is
+ * freed with g_sgraph_node_free() or together with whole @arena.
+ *
+ * Returns: newly created node.
+ */
+GSGraphNode*
+g_sgraph_node_new_in_arena (GSGraphArena* arena,
+                            gpointer data)
+{
+  g_return_val_if_fail (arena != NULL, NULL);
+
+  return _g_sgraph_node_new_general (arena, data);
 }
 
 /**
@@ -91,7 +177,7 @@ g_sgraph_node_new (gpointer data)
  *
  * Frees memory allocated to @node. It is recommended to call
  * g_sgraph_node_disconnect() and g_sgraph_node_are_separate() for all @node's
- * neighbours.
+ * neighbours or to use g_sgraph_node_remove() instead.
  *
  * Returns: data of freed node.
  */
@@ -104,42 +190,163 @@ g_sgraph_node_free (GSGraphNode* node)
 
   data = node->data;
 
-  g_ptr_array_free (node->neighbours, TRUE);
-  g_slice_free (GSGraphNode, node);
+  _g_sgraph_node_dispose (node);
+  if (node->arena)
+  {
+    _g_sgraph_arena_release_node (node->arena, node);
+  }
+  else
+  {
+    g_slice_free (GSGraphNode, node);
+  }
 
   return data;
 }
 
+/**
+ * g_sgraph_node_remove:
+ * @node: a node.
+ *
+ * Disconnects @node from all its neighbours and frees it. Takes time linear in
+ * @node's degree if its neighbours keep position indices. Checking if former
+ * neighbours are separate is up to programmist.
+ *
+ * Returns: data of removed node.
+ */
+gpointer
+g_sgraph_node_remove (GSGraphNode* node)
+{
+  guint iter;
+
+  g_return_val_if_fail (node != NULL, NULL);
+
+  if (node->neighbours->len)
+  {
+    _g_sgraph_connectivity_node_disconnected (node);
+  }
+  for (iter = 0; iter < node->neighbours->len; ++iter)
+  {
+    _g_sgraph_node_remove_neighbour (g_ptr_array_index (node->neighbours, iter),
+                                     node);
+  }
+
+  return g_sgraph_node_free (node);
+}
+
+/**
+ * g_sgraph_node_remove_batch:
+ * @nodes: an array of nodes to remove.
+ * @data_destroy_func: function freeing data of removed nodes or %NULL.
+ *
+ * Disconnects all nodes in @nodes from their neighbours and frees them. Each
+ * node surviving the removal has its neighbours array swept once, so time is
+ * linear in total degree of removed nodes and their surviving neighbours.
+ * Order of neighbours of surviving nodes is preserved. @nodes must not contain
+ * duplicates and is not freed.
+ */
+void
+g_sgraph_node_remove_batch (GPtrArray* nodes,
+                            GDestroyNotify data_destroy_func)
+{
+  GSGraphVisited visited;
+  GPtrArray* affected;
+  guint iter;
+
+  g_return_if_fail (nodes != NULL);
+
+  _g_sgraph_visited_init (&visited, G_SGRAPH_VISITED_DOMAIN_SGRAPH, 2);
+  for (iter = 0; iter < nodes->len; ++iter)
+  {
+    GSGraphNode* node;
+
+    node = g_ptr_array_index (nodes, iter);
+    _g_sgraph_visited_set (&visited, node, &node->visit_mark, 1);
+  }
+
+  affected = g_ptr_array_new ();
+  for (iter = 0; iter < nodes->len; ++iter)
+  {
+    GSGraphNode* node;
+    guint iter2;
+
+    node = g_ptr_array_index (nodes, iter);
+    for (iter2 = 0; iter2 < node->neighbours->len; ++iter2)
+    {
+      GSGraphNode* neighbour;
+
+      neighbour = g_ptr_array_index (node->neighbours, iter2);
+      if (!_g_sgraph_visited_get (&visited, neighbour, &neighbour->visit_mark))
+      {
+        _g_sgraph_visited_set (&visited, neighbour, &neighbour->visit_mark, 2);
+        g_ptr_array_add (affected, neighbour);
+      }
+    }
+  }
+
+  for (iter = 0; iter < affected->len; ++iter)
+  {
+    GSGraphNode* node;
+    guint iter2;
+    guint kept;
+
+    node = g_ptr_array_index (affected, iter);
+    kept = 0;
+    for (iter2 = 0; iter2 < node->neighbours->len; ++iter2)
+    {
+      GSGraphNode* neighbour;
+
+      neighbour = g_ptr_array_index (node->neighbours, iter2);
+      if (_g_sgraph_visited_get (&visited,
+                                 neighbour,
+                                 &neighbour->visit_mark) != 1)
+      {
+        g_ptr_array_index (node->neighbours, kept) = neighbour;
+        ++kept;
+      }
+    }
+    g_ptr_array_set_size (node->neighbours, kept);
+    _g_sgraph_node_update_index (node);
+    _g_sgraph_connectivity_node_disconnected (node);
+  }
+  _g_sgraph_visited_clear (&visited);
+  g_ptr_array_free (affected, TRUE);
+
+  for (iter = 0; iter < nodes->len; ++iter)
+  {
+    gpointer data;
+
+    data = g_sgraph_node_free (g_ptr_array_index (nodes, iter));
+    if (data_destroy_func)
+    {
+      (*data_destroy_func) (data);
+    }
+  }
+}
+
 /**
  * g_sgraph_node_connect:
  * @node: a node.
  * @other_node: other @node.
  *
  * Creates a connection between @node and @other_node. If connection already
- * existed, it does nothing.
+ * existed, it does nothing. If one of nodes is held by #GSGraphConnectivity,
+ * the index is updated.
  */
 void
 g_sgraph_node_connect (GSGraphNode* node,
                        GSGraphNode* other_node)
 {
-  guint iter;
-
   g_return_if_fail (node != NULL);
   g_return_if_fail (other_node != NULL);
   g_return_if_fail (node != other_node);
 
-  for (iter = 0; iter < node->neighbours->len; ++iter)
+  if (_g_sgraph_node_has_neighbour (node, other_node))
   {
-    GSGraphNode* temp_node;
-
-    temp_node = g_ptr_array_index (node->neighbours, iter);
-    if (temp_node == other_node)
-    {
-      return;
-    }
+    return;
   }
-  g_ptr_array_add (node->neighbours, other_node);
-  g_ptr_array_add (other_node->neighbours, node);
+  _g_sgraph_node_add_neighbour (node, other_node);
+  _g_sgraph_node_add_neighbour (other_node, node);
+  _g_sgraph_connectivity_node_connected (node, other_node);
 }
 
 /**
@@ -149,7 +356,8 @@ g_sgraph_node_connect (GSGraphNode* node,
  *
  * Removes connection from one node to another, so in effect they stop
  * being neighbours. If @node and @other_node are not neighbours then nothing
- * happens.
+ * happens. #GSGraphConnectivity holding the nodes becomes invalid until
+ * g_sgraph_connectivity_rebuild() is called.
  */
 void
 g_sgraph_node_disconnect (GSGraphNode* node,
@@ -158,11 +366,33 @@ g_sgraph_node_disconnect (GSGraphNode* node,
   g_return_if_fail (node != NULL);
   g_return_if_fail (other_node != NULL);
 
-  if (!g_ptr_array_remove (node->neighbours, other_node))
+  if (!_g_sgraph_node_remove_neighbour (node, other_node))
   {
     return;
   }
-  g_ptr_array_remove (other_node->neighbours, node);
+  _g_sgraph_node_remove_neighbour (other_node, node);
+  _g_sgraph_connectivity_node_disconnected (node);
+}
+
+/**
+ * g_sgraph_node_is_neighbour:
+ * @node: a node.
+ * @other_node: other node.
+ *
+ * Checks if @node and @other_node are connected. Takes expected constant time
+ * if any of them keeps a position index, otherwise time linear in the smaller
+ * of their degrees.
+ *
+ * Returns: %TRUE if @node and @other_node are neighbours, otherwise %FALSE.
+ */
+gboolean
+g_sgraph_node_is_neighbour (GSGraphNode* node,
+                            GSGraphNode* other_node)
+{
+  g_return_val_if_fail (node != NULL, FALSE);
+  g_return_val_if_fail (other_node != NULL, FALSE);
+
+  return _g_sgraph_node_has_neighbour (node, other_node);
 }
 
 /**
@@ -170,7 +400,9 @@ g_sgraph_node_disconnect (GSGraphNode* node,
  * @node: a node.
  * @other_node: other node.
  *
- * This function checks if @node lies in another graph than @other_node.
+ * This function checks if @node lies in another graph than @other_node. If
+ * any of the nodes is held by valid #GSGraphConnectivity, the answer is taken
+ * from it in nearly constant time. Otherwise graph is traversed.
  *
  * <note>
  *   <para>
@@ -178,6 +410,8 @@ g_sgraph_node_disconnect (GSGraphNode* node,
  *     and you are able to say which of graphs will have lower order, call this
  *     function with @node being in larger graph and @other_node being in
  *     smaller one.
+ *     If you cannot tell it, use
+ *     g_sgraph_node_are_separate_bidirectional() instead.
  *   </para>
  * </note>
  *
@@ -187,55 +421,509 @@ gboolean
 g_sgraph_node_are_separate (GSGraphNode* node,
                             GSGraphNode* other_node)
 {
-  GHashTable* visited_nodes;
+  GSGraphVisited visited;
   gboolean not_connected;
 
-  visited_nodes = g_hash_table_new (NULL, NULL);
+  g_return_val_if_fail (node != NULL, FALSE);
+  g_return_val_if_fail (other_node != NULL, FALSE);
+
+  if (_g_sgraph_connectivity_check (node, other_node, &not_connected))
+  {
+    return not_connected;
+  }
+
+  _g_sgraph_visited_init (&visited, G_SGRAPH_VISITED_DOMAIN_SGRAPH, 1);
   not_connected = _g_sgraph_node_connection_check (node,
                                                    other_node,
-                                                   visited_nodes);
-  g_hash_table_unref (visited_nodes);
+                                                   &visited);
+  _g_sgraph_visited_clear (&visited);
 
   return not_connected;
 }
 
+/**
+ * g_sgraph_node_are_separate_bidirectional:
+ * @node: a node.
+ * @other_node: other node.
+ *
+ * This function checks if @node lies in another graph than @other_node, just
+ * like g_sgraph_node_are_separate(). The difference is that breadth first
+ * search is run from both nodes at once, each time expanding whole level of
+ * the side having less nodes in its frontier. Search stops as soon as both
+ * sides meet or one of them is exhausted. So when nodes are in the same graph,
+ * amount of work depends on distance between them rather than on order of the
+ * graph, and when they are separate, the smaller graph is traversed, no matter
+ * in which order the nodes were passed.
+ *
+ * Returns: %TRUE if @node and @other_node are in separate graphs.
+ */
+gboolean
+g_sgraph_node_are_separate_bidirectional (GSGraphNode* node,
+                                          GSGraphNode* other_node)
+{
+  GSGraphVisited visited;
+  GPtrArray* frontier;
+  GPtrArray* other_frontier;
+  gboolean are_separate;
+
+  g_return_val_if_fail (node != NULL, FALSE);
+  g_return_val_if_fail (other_node != NULL, FALSE);
+
+  if (node == other_node)
+  {
+    return FALSE;
+  }
+  if (_g_sgraph_connectivity_check (node, other_node, &are_separate))
+  {
+    return are_separate;
+  }
+
+  _g_sgraph_visited_init (&visited, G_SGRAPH_VISITED_DOMAIN_SGRAPH, 2);
+  frontier = g_ptr_array_new ();
+  other_frontier = g_ptr_array_new ();
+
+  _g_sgraph_visited_set (&visited, node, &node->visit_mark, 1);
+  _g_sgraph_visited_set (&visited, other_node, &other_node->visit_mark, 2);
+  g_ptr_array_add (frontier, node);
+  g_ptr_array_add (other_frontier, other_node);
+
+  are_separate = TRUE;
+  while (frontier->len && other_frontier->len)
+  {
+    gboolean met;
+
+    if (frontier->len <= other_frontier->len)
+    {
+      met = _g_sgraph_node_expand_frontier (&frontier, &visited, 1);
+    }
+    else
+    {
+      met = _g_sgraph_node_expand_frontier (&other_frontier, &visited, 2);
+    }
+    if (met)
+    {
+      are_separate = FALSE;
+      break;
+    }
+  }
+
+  g_ptr_array_free (frontier, TRUE);
+  g_ptr_array_free (other_frontier, TRUE);
+  _g_sgraph_visited_clear (&visited);
+
+  return are_separate;
+}
+
+/**
+ * g_sgraph_node_visit:
+ * @node: a node traversal starts from.
+ * @traverse_type: which traversing algorithm to use.
+ * @max_depth: depth of nodes whose neighbours are not visited. Pass
+ * %G_MAXUINT for no limit.
+ * @visit_func: function called for each visited node.
+ * @filter_func: function deciding which neighbours can be visited or %NULL.
+ * @user_data: data passed to @visit_func and @filter_func.
+ *
+ * Traverses graph from @node, calling @visit_func for each node at most
+ * @max_depth steps away from @node, @node included. Traversal goes from a node
+ * to its neighbour only if @filter_func is %NULL or returns %TRUE for them.
+ * When @visit_func returns %G_SGRAPH_VISIT_SKIP_CHILDREN, neighbours of the
+ * node are not checked, and when it returns %G_SGRAPH_VISIT_STOP, traversal is
+ * finished at once.
+ *
+ * In breadth first search depth of a node is its distance from @node, so
+ * all nodes at most @max_depth steps away are visited. In depth first search
+ * it is a depth in search tree, which can be greater than the distance.
+ *
+ * <note>
+ *   <para>
+ *     @visit_func and @filter_func must not change the graph and must not call
+ *     g_sgraph_visit_marks_set_enabled() or g_sgraph_visit_marks_clear().
+ *   </para>
+ * </note>
+ *
+ * Returns: a node for which @visit_func returned %G_SGRAPH_VISIT_STOP or
+ * %NULL if traversal was not stopped.
+ */
+GSGraphNode*
+g_sgraph_node_visit (GSGraphNode* node,
+                     GSGraphTraverseType traverse_type,
+                     guint max_depth,
+                     GSGraphVisitFunc visit_func,
+                     GSGraphFilterFunc filter_func,
+                     gpointer user_data)
+{
+  GSGraphIter iter;
+  GSGraphNode* visited_node;
+
+  g_return_val_if_fail (node != NULL, NULL);
+  g_return_val_if_fail (visit_func != NULL, NULL);
+  g_return_val_if_fail ((traverse_type == G_SGRAPH_TRAVERSE_BFS) ||
+                        (traverse_type == G_SGRAPH_TRAVERSE_DFS), NULL);
+
+  _g_sgraph_iter_init (&iter, node, traverse_type, TRUE);
+  _g_sgraph_iter_set_limits (&iter, max_depth, filter_func, user_data);
+
+  while ((visited_node = g_sgraph_iter_next (&iter)))
+  {
+    GSGraphVisitResult result;
+
+    result = (*visit_func) (visited_node,
+                            _g_sgraph_iter_get_depth (&iter),
+                            user_data);
+    if (result == G_SGRAPH_VISIT_STOP)
+    {
+      break;
+    }
+    if (result == G_SGRAPH_VISIT_SKIP_CHILDREN)
+    {
+      _g_sgraph_iter_skip_children (&iter);
+    }
+  }
+
+  _g_sgraph_iter_clear (&iter);
+
+  return visited_node;
+}
+
+/* internal function definitions */
+
+/**
+ * _g_sgraph_node_update_index:
+ * @node: a node.
+ *
+ * Builds or drops position index of @node's neighbours, depending on its
+ * degree. It has to be called after neighbours array of @node was filled or
+ * changed directly.
+ */
+void
+_g_sgraph_node_update_index (GSGraphNode* node)
+{
+  guint iter;
+
+  if (node->neighbour_index)
+  {
+    g_hash_table_unref (node->neighbour_index);
+    node->neighbour_index = NULL;
+  }
+  if (node->neighbours->len <= G_SGRAPH_NODE_INDEX_THRESHOLD)
+  {
+    return;
+  }
+
+  node->neighbour_index = g_hash_table_new (NULL, NULL);
+  for (iter = 0; iter < node->neighbours->len; ++iter)
+  {
+    g_hash_table_insert (node->neighbour_index,
+                         g_ptr_array_index (node->neighbours, iter),
+                         GUINT_TO_POINTER (iter + 1));
+  }
+}
+
+/**
+ * _g_sgraph_node_dispose:
+ * @node: a node.
+ *
+ * Frees everything @node holds, but not @node itself. Neighbours array of
+ * @node is set to %NULL.
+ */
+void
+_g_sgraph_node_dispose (GSGraphNode* node)
+{
+  _g_sgraph_connectivity_node_freed (node);
+  if (node->neighbour_index)
+  {
+    g_hash_table_unref (node->neighbour_index);
+    node->neighbour_index = NULL;
+  }
+  g_ptr_array_free (node->neighbours, TRUE);
+  node->neighbours = NULL;
+}
+
 /* static function definitions */
 
+/**
+ * _g_sgraph_node_new_general:
+ * @arena: an arena or %NULL.
+ * @data: data.
+ *
+ * Creates new node holding @data. If @arena is not %NULL, memory for node is
+ * taken from it.
+ *
+ * Returns: newly created node.
+ */
+static GSGraphNode*
+_g_sgraph_node_new_general (GSGraphArena* arena,
+                            gpointer data)
+{
+  GSGraphNode* node;
+
+  if (arena)
+  {
+    node = _g_sgraph_arena_alloc_node (arena);
+  }
+  else
+  {
+    node = g_slice_new (GSGraphNode);
+  }
+  node->data = data;
+  node->neighbours = g_ptr_array_new ();
+  node->connectivity = NULL;
+  node->connectivity_index = 0;
+  node->visit_mark = 0;
+  node->neighbour_index = NULL;
+  node->arena = arena;
+  return node;
+}
+
 /**
  * _g_sgraph_node_connection_check:
  * @node: starting node.
  * @other_node: other node.
- * @visited_nodes: #GHashTable holding information which nodes were already
- * visited.
+ * @visited: a set of already visited nodes.
  *
- * Checks if @node == @other_node. If not it checks @node's neighbours.
+ * Checks if @node == @other_node. If not it checks @other_node's neighbours,
+ * their neighbours and so on in depth first order. An explicit stack allocated
+ * once per check is used instead of recursion.
  *
- * Returns: %TRUE if @node != @other_node, otherwise %FALSE.
+ * Returns: %TRUE if @node was not reached from @other_node, otherwise %FALSE.
  */
 static gboolean
 _g_sgraph_node_connection_check (GSGraphNode* node,
                                  GSGraphNode* other_node,
-                                 GHashTable* visited_nodes)
+                                 GSGraphVisited* visited)
 {
-  guint iter;
+  GArray* stack;
+  GSGraphNodeFrame frame;
+  gboolean not_connected;
 
   if (node == other_node)
   {
     return FALSE;
   }
-  if (g_hash_table_lookup_extended (visited_nodes, other_node, NULL, NULL))
+  if (_g_sgraph_visited_check (visited, other_node, &other_node->visit_mark))
   {
     return TRUE;
   }
-  g_hash_table_insert (visited_nodes, other_node, NULL);
 
-  for (iter = 0; iter < other_node->neighbours->len; ++iter)
+  stack = g_array_new (FALSE, FALSE, sizeof (GSGraphNodeFrame));
+
+  frame.node = other_node;
+  frame.position = 0;
+  g_array_append_val (stack, frame);
+
+  not_connected = TRUE;
+  while (stack->len)
   {
-    GSGraphNode* temp_node = g_ptr_array_index (other_node->neighbours, iter);
-    if (!_g_sgraph_node_connection_check (node, temp_node, visited_nodes))
+    GSGraphNodeFrame* top;
+    GSGraphNode* temp_node;
+
+    top = &g_array_index (stack, GSGraphNodeFrame, stack->len - 1);
+    if (top->position == top->node->neighbours->len)
+    {
+      g_array_set_size (stack, stack->len - 1);
+      continue;
+    }
+
+    temp_node = g_ptr_array_index (top->node->neighbours, top->position);
+    ++top->position;
+    if (temp_node == node)
     {
-      return FALSE;
+      not_connected = FALSE;
+      break;
     }
+    if (_g_sgraph_visited_check (visited, temp_node, &temp_node->visit_mark))
+    {
+      continue;
+    }
+
+    frame.node = temp_node;
+    frame.position = 0;
+    g_array_append_val (stack, frame);
+  }
+
+  g_array_free (stack, TRUE);
+  return not_connected;
+}
+
+/**
+ * _g_sgraph_node_expand_frontier:
+ * @frontier: pointer to array of nodes in current level of search.
+ * @visited: a set of visited nodes, remembering side of search which reached
+ * them.
+ * @side: side of search @frontier belongs to.
+ *
+ * Replaces nodes in @frontier with their neighbours not visited yet, marking
+ * them with @side. Stops when a node visited by other side is reached.
+ *
+ * Returns: %TRUE if a node visited by other side was reached, otherwise
+ * %FALSE.
+ */
+static gboolean
+_g_sgraph_node_expand_frontier (GPtrArray** frontier,
+                                GSGraphVisited* visited,
+                                guint32 side)
+{
+  GPtrArray* next_frontier;
+  guint iter;
+  gboolean met;
+
+  next_frontier = g_ptr_array_new ();
+  met = FALSE;
+  for (iter = 0; (iter < (*frontier)->len) && !met; ++iter)
+  {
+    GSGraphNode* temp_node;
+    guint iter2;
+
+    temp_node = g_ptr_array_index (*frontier, iter);
+    for (iter2 = 0; iter2 < temp_node->neighbours->len; ++iter2)
+    {
+      GSGraphNode* neighbour;
+      guint32 neighbour_side;
+
+      neighbour = g_ptr_array_index (temp_node->neighbours, iter2);
+      neighbour_side = _g_sgraph_visited_get (visited,
+                                              neighbour,
+                                              &neighbour->visit_mark);
+      if (!neighbour_side)
+      {
+        _g_sgraph_visited_set (visited,
+                               neighbour,
+                               &neighbour->visit_mark,
+                               side);
+        g_ptr_array_add (next_frontier, neighbour);
+      }
+      else if (neighbour_side != side)
+      {
+        met = TRUE;
+        break;
+      }
+    }
+  }
+
+  g_ptr_array_free (*frontier, TRUE);
+  *frontier = next_frontier;
+  return met;
+}
+
+/**
+ * _g_sgraph_node_add_neighbour:
+ * @node: a node.
+ * @neighbour: a node not being @node's neighbour yet.
+ *
+ * Appends @neighbour to @node's neighbours, keeping position index up to date.
+ */
+static void
+_g_sgraph_node_add_neighbour (GSGraphNode* node,
+                              GSGraphNode* neighbour)
+{
+  g_ptr_array_add (node->neighbours, neighbour);
+  if (node->neighbour_index)
+  {
+    g_hash_table_insert (node->neighbour_index,
+                         neighbour,
+                         GUINT_TO_POINTER (node->neighbours->len));
+  }
+  else if (node->neighbours->len > G_SGRAPH_NODE_INDEX_THRESHOLD)
+  {
+    _g_sgraph_node_update_index (node);
+  }
+}
+
+/**
+ * _g_sgraph_node_remove_neighbour:
+ * @node: a node.
+ * @neighbour: a node.
+ *
+ * Removes @neighbour from @node's neighbours. If @node has position index,
+ * last neighbour is moved into freed position, otherwise order of neighbours
+ * is preserved.
+ *
+ * Returns: %TRUE if @neighbour was removed, %FALSE if it was not @node's
+ * neighbour.
+ */
+static gboolean
+_g_sgraph_node_remove_neighbour (GSGraphNode* node,
+                                 GSGraphNode* neighbour)
+{
+  guint position;
+
+  if (!node->neighbour_index)
+  {
+    return g_ptr_array_remove (node->neighbours, neighbour);
+  }
+
+  position = GPOINTER_TO_UINT (g_hash_table_lookup (node->neighbour_index,
+                                                    neighbour));
+  if (!position)
+  {
+    return FALSE;
+  }
+
+  g_hash_table_remove (node->neighbour_index, neighbour);
+  g_ptr_array_remove_index_fast (node->neighbours, position - 1);
+  if (position <= node->neighbours->len)
+  {
+    g_hash_table_insert (node->neighbour_index,
+                         g_ptr_array_index (node->neighbours, position - 1),
+                         GUINT_TO_POINTER (position));
+  }
+  if (node->neighbours->len < G_SGRAPH_NODE_INDEX_THRESHOLD / 2)
+  {
+    _g_sgraph_node_update_index (node);
   }
   return TRUE;
 }
+
+/**
+ * _g_sgraph_node_has_neighbour:
+ * @node: a node.
+ * @neighbour: a node.
+ *
+ * Checks if @neighbour is @node's neighbour, using position index of any of
+ * them or scanning neighbours of the one with lower degree.
+ *
+ * Returns: %TRUE if nodes are neighbours, otherwise %FALSE.
+ */
+static gboolean
+_g_sgraph_node_has_neighbour (GSGraphNode* node,
+                              GSGraphNode* neighbour)
+{
+  GSGraphNode* smaller;
+  GSGraphNode* other;
+  guint iter;
+
+  if (node->neighbour_index)
+  {
+    return g_hash_table_lookup_extended (node->neighbour_index,
+                                         neighbour,
+                                         NULL,
+                                         NULL);
+  }
+  if (neighbour->neighbour_index)
+  {
+    return g_hash_table_lookup_extended (neighbour->neighbour_index,
+                                         node,
+                                         NULL,
+                                         NULL);
+  }
+
+  if (node->neighbours->len <= neighbour->neighbours->len)
+  {
+    smaller = node;
+    other = neighbour;
+  }
+  else
+  {
+    smaller = neighbour;
+    other = node;
+  }
+  for (iter = 0; iter < smaller->neighbours->len; ++iter)
+  {
+    if (g_ptr_array_index (smaller->neighbours, iter) == other)
+    {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
@@ -26,6 +26,9 @@
 
 #include <glib.h>
 
+#include <gsgraph/gsgraphtypedefs.h>
+#include <gsgraph/gsgraphenums.h>
+
 G_BEGIN_DECLS
 
 /**
@@ -41,14 +44,62 @@ struct _GSGraphNode
 {
   gpointer data;
   GPtrArray* neighbours;
+
+  /*< private >*/
+  GSGraphConnectivity* connectivity;
+  guint connectivity_index;
+  guint32 visit_mark;
+  GHashTable* neighbour_index;
+  GSGraphArena* arena;
 };
 
+/**
+ * GSGraphVisitFunc:
+ * @node: a visited node.
+ * @depth: number of steps from starting node to @node in traversal.
+ * @user_data: data passed to g_sgraph_node_visit().
+ *
+ * Specifies type of function called for each node visited by
+ * g_sgraph_node_visit().
+ *
+ * Returns: how traversal should go on.
+ */
+typedef GSGraphVisitResult (*GSGraphVisitFunc) (GSGraphNode* node,
+                                                guint depth,
+                                                gpointer user_data);
+
+/**
+ * GSGraphFilterFunc:
+ * @node: a node traversal goes from.
+ * @neighbour: a neighbour of @node traversal would go to.
+ * @user_data: data passed to g_sgraph_node_visit().
+ *
+ * Specifies type of function deciding whether traversal can go from @node to
+ * @neighbour.
+ *
+ * Returns: %TRUE if traversal can go to @neighbour, otherwise %FALSE.
+ */
+typedef gboolean (*GSGraphFilterFunc) (GSGraphNode* node,
+                                       GSGraphNode* neighbour,
+                                       gpointer user_data);
+
 GSGraphNode*
 g_sgraph_node_new (gpointer data) G_GNUC_WARN_UNUSED_RESULT;
 
+GSGraphNode*
+g_sgraph_node_new_in_arena (GSGraphArena* arena,
+                            gpointer data) G_GNUC_WARN_UNUSED_RESULT;
+
 gpointer
 g_sgraph_node_free (GSGraphNode* node);
 
+gpointer
+g_sgraph_node_remove (GSGraphNode* node);
+
+void
+g_sgraph_node_remove_batch (GPtrArray* nodes,
+                            GDestroyNotify data_destroy_func);
+
 void
 g_sgraph_node_connect (GSGraphNode* node,
                        GSGraphNode* other_node);
@@ -57,10 +108,26 @@ void
 g_sgraph_node_disconnect (GSGraphNode* node,
                           GSGraphNode* other_node);
 
+gboolean
+g_sgraph_node_is_neighbour (GSGraphNode* node,
+                            GSGraphNode* other_node);
+
 gboolean
 g_sgraph_node_are_separate (GSGraphNode* node,
                             GSGraphNode* other_node);
 
+gboolean
+g_sgraph_node_are_separate_bidirectional (GSGraphNode* node,
+                                          GSGraphNode* other_node);
+
+GSGraphNode*
+g_sgraph_node_visit (GSGraphNode* node,
+                     GSGraphTraverseType traverse_type,
+                     guint max_depth,
+                     GSGraphVisitFunc visit_func,
+                     GSGraphFilterFunc filter_func,
+                     gpointer user_data);
+
 G_END_DECLS
 
 #endif /* _G_SGRAPH_NODE_H_ */
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "This is a private header, it must not be included outside libggraph."
+#endif
+
+#ifndef _G_SGRAPH_NODE_PRIVATE_H_
+#define _G_SGRAPH_NODE_PRIVATE_H_
+
+#include <glib.h>
+
+#include "gsgraphnode.h"
+
+G_BEGIN_DECLS
+
+G_GNUC_INTERNAL void
+_g_sgraph_node_update_index (GSGraphNode* node);
+
+G_GNUC_INTERNAL void
+_g_sgraph_node_dispose (GSGraphNode* node);
+
+G_END_DECLS
+
+#endif /* _G_SGRAPH_NODE_PRIVATE_H_ */
@@ -0,0 +1,323 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsgraphordering.h"
+
+/* Internal computation of node permutations improving memory locality. Graph
+ * is given as arrays of offsets and neighbour indices, like in #GSGraphCsr, so
+ * the same code serves both graph kinds. Neighbour entries equal to
+ * %G_MAXUINT32 or to index of node owning them are ignored, so half-edges and
+ * loops of edged graphs can be passed as they are.
+ */
+
+/* internal types. */
+
+/**
+ * GSGraphOrderingState:
+ * @order: number of nodes.
+ * @offsets: offsets into @neighbours.
+ * @neighbours: neighbour indices.
+ * @degrees: degree of every node.
+ * @visited: visited flag of every node.
+ * @permutation: permutation being built.
+ *
+ * Internal state of ordering computation.
+ */
+typedef struct _GSGraphOrderingState GSGraphOrderingState;
+
+struct _GSGraphOrderingState
+{
+  guint32 order;
+  const guint32* offsets;
+  const guint32* neighbours;
+  guint32* degrees;
+  guint8* visited;
+  GArray* permutation;
+};
+
+/* static function declarations. */
+
+static guint32*
+_g_sgraph_ordering_sort_by_degree (GSGraphOrderingState* state,
+                                   GCompareDataFunc compare_func);
+
+static void
+_g_sgraph_ordering_append_BFS (GSGraphOrderingState* state,
+                               guint32 index,
+                               gboolean by_degree);
+
+static gint
+_g_sgraph_ordering_compare_ascending (gconstpointer a,
+                                      gconstpointer b,
+                                      gpointer degrees);
+
+static gint
+_g_sgraph_ordering_compare_descending (gconstpointer a,
+                                       gconstpointer b,
+                                       gpointer degrees);
+
+/* function definitions. */
+
+/**
+ * _g_sgraph_ordering_compute:
+ * @order: number of nodes.
+ * @offsets: array of @order + 1 offsets into @neighbours.
+ * @neighbours: array of neighbour indices.
+ * @ordering: kind of order to compute.
+ *
+ * Computes a permutation of nodes. For %G_SGRAPH_ORDERING_RCM every component
+ * is searched breadth first from its node of lowest degree, with neighbours of
+ * each node visited from the lowest degree, and the whole result is reversed.
+ * For %G_SGRAPH_ORDERING_BFS components are searched breadth first in order of
+ * their first nodes. Both take O(V+E log E) time at most.
+ *
+ * Returns: #GArray of #guint32 node indices, i-th element being the index of
+ * node which goes at position i.
+ */
+GArray*
+_g_sgraph_ordering_compute (guint32 order,
+                            const guint32* offsets,
+                            const guint32* neighbours,
+                            GSGraphOrdering ordering)
+{
+  GSGraphOrderingState state;
+  guint32* sorted;
+  guint32 iter;
+
+  state.order = order;
+  state.offsets = offsets;
+  state.neighbours = neighbours;
+  state.degrees = g_new (guint32, order);
+  state.visited = g_new0 (guint8, order);
+  state.permutation = g_array_sized_new (FALSE, FALSE, sizeof (guint32), order);
+  for (iter = 0; iter < order; ++iter)
+  {
+    state.degrees[iter] = offsets[iter + 1] - offsets[iter];
+  }
+
+  switch (ordering)
+  {
+    case G_SGRAPH_ORDERING_RCM:
+    {
+      sorted = _g_sgraph_ordering_sort_by_degree
+        (&state,
+         _g_sgraph_ordering_compare_ascending);
+      for (iter = 0; iter < order; ++iter)
+      {
+        if (!state.visited[sorted[iter]])
+        {
+          _g_sgraph_ordering_append_BFS (&state, sorted[iter], TRUE);
+        }
+      }
+      g_free (sorted);
+
+      for (iter = 0; iter < order / 2; ++iter)
+      {
+        guint32 temp;
+
+        temp = g_array_index (state.permutation, guint32, iter);
+        g_array_index (state.permutation, guint32, iter) =
+          g_array_index (state.permutation, guint32, order - 1 - iter);
+        g_array_index (state.permutation, guint32, order - 1 - iter) = temp;
+      }
+      break;
+    }
+    case G_SGRAPH_ORDERING_DEGREE:
+    {
+      sorted = _g_sgraph_ordering_sort_by_degree
+        (&state,
+         _g_sgraph_ordering_compare_descending);
+      g_array_append_vals (state.permutation, sorted, order);
+      g_free (sorted);
+      break;
+    }
+    case G_SGRAPH_ORDERING_BFS:
+    {
+      for (iter = 0; iter < order; ++iter)
+      {
+        if (!state.visited[iter])
+        {
+          _g_sgraph_ordering_append_BFS (&state, iter, FALSE);
+        }
+      }
+      break;
+    }
+    default:
+    {
+      g_assert_not_reached ();
+    }
+  }
+
+  g_free (state.degrees);
+  g_free (state.visited);
+  return state.permutation;
+}
+
+/* static function definitions. */
+
+/**
+ * _g_sgraph_ordering_sort_by_degree:
+ * @state: state of computation.
+ * @compare_func: function comparing node indices by degree.
+ *
+ * Sorts indices of all nodes by degree. Nodes with equal degrees keep order of
+ * their indices.
+ *
+ * Returns: sorted array of node indices. Free it with g_free().
+ */
+static guint32*
+_g_sgraph_ordering_sort_by_degree (GSGraphOrderingState* state,
+                                   GCompareDataFunc compare_func)
+{
+  guint32* sorted;
+  guint32 iter;
+
+  sorted = g_new (guint32, state->order);
+  for (iter = 0; iter < state->order; ++iter)
+  {
+    sorted[iter] = iter;
+  }
+  g_qsort_with_data (sorted,
+                     state->order,
+                     sizeof (guint32),
+                     compare_func,
+                     state->degrees);
+
+  return sorted;
+}
+
+/**
+ * _g_sgraph_ordering_append_BFS:
+ * @state: state of computation.
+ * @index: index of starting node.
+ * @by_degree: whether newly found neighbours are sorted by degree.
+ *
+ * Appends all not yet visited nodes reachable from node with @index to
+ * permutation using breadth first search. Permutation itself serves as
+ * a queue.
+ */
+static void
+_g_sgraph_ordering_append_BFS (GSGraphOrderingState* state,
+                               guint32 index,
+                               gboolean by_degree)
+{
+  guint head;
+
+  state->visited[index] = TRUE;
+  head = state->permutation->len;
+  g_array_append_val (state->permutation, index);
+
+  for (; head < state->permutation->len; ++head)
+  {
+    guint32 temp_index;
+    guint first_found;
+    guint32 iter;
+
+    temp_index = g_array_index (state->permutation, guint32, head);
+    first_found = state->permutation->len;
+    for (iter = state->offsets[temp_index];
+         iter < state->offsets[temp_index + 1];
+         ++iter)
+    {
+      guint32 other_index;
+
+      other_index = state->neighbours[iter];
+      if ((other_index == G_MAXUINT32) || state->visited[other_index])
+      {
+        continue;
+      }
+
+      state->visited[other_index] = TRUE;
+      g_array_append_val (state->permutation, other_index);
+    }
+
+    if (by_degree && (state->permutation->len - first_found > 1))
+    {
+      g_qsort_with_data (&g_array_index (state->permutation,
+                                         guint32,
+                                         first_found),
+                         state->permutation->len - first_found,
+                         sizeof (guint32),
+                         _g_sgraph_ordering_compare_ascending,
+                         state->degrees);
+    }
+  }
+}
+
+/**
+ * _g_sgraph_ordering_compare_ascending:
+ * @a: pointer to node index.
+ * @b: pointer to other node index.
+ * @degrees: array of node degrees.
+ *
+ * Compares nodes by degree, lower first. Ties are resolved by index.
+ *
+ * Returns: negative, zero or positive value.
+ */
+static gint
+_g_sgraph_ordering_compare_ascending (gconstpointer a,
+                                      gconstpointer b,
+                                      gpointer degrees)
+{
+  guint32 index;
+  guint32 other_index;
+  guint32 degree;
+  guint32 other_degree;
+
+  index = *(const guint32*)a;
+  other_index = *(const guint32*)b;
+  degree = ((guint32*)degrees)[index];
+  other_degree = ((guint32*)degrees)[other_index];
+  if (degree != other_degree)
+  {
+    return (degree < other_degree) ? -1 : 1;
+  }
+  return (index < other_index) ? -1 : (index > other_index);
+}
+
+/**
+ * _g_sgraph_ordering_compare_descending:
+ * @a: pointer to node index.
+ * @b: pointer to other node index.
+ * @degrees: array of node degrees.
+ *
+ * Compares nodes by degree, higher first. Ties are resolved by index.
+ *
+ * Returns: negative, zero or positive value.
+ */
+static gint
+_g_sgraph_ordering_compare_descending (gconstpointer a,
+                                       gconstpointer b,
+                                       gpointer degrees)
+{
+  guint32 index;
+  guint32 other_index;
+  guint32 degree;
+  guint32 other_degree;
+
+  index = *(const guint32*)a;
+  other_index = *(const guint32*)b;
+  degree = ((guint32*)degrees)[index];
+  other_degree = ((guint32*)degrees)[other_index];
+  if (degree != other_degree)
+  {
+    return (degree > other_degree) ? -1 : 1;
+  }
+  return (index < other_index) ? -1 : (index > other_index);
+}
@@ -0,0 +1,558 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsgraphparallel.h"
+
+/* Internal helpers running a function over a pointer array or a range of
+ * indices on a thread pool. The work is split into one contiguous range per
+ * thread and every range is cut into small chunks. A thread takes chunks from
+ * its own range first and when it runs dry it steals chunks from the other
+ * ranges, so uneven per element costs do not leave threads idle. Calling
+ * thread takes part in the work too.
+ *
+ * All calls share one pool of threads, which is created on first use and only
+ * grows, so starting a job costs waking up idle threads, not creating them.
+ * Each pushed item is a share of a job. Calling thread can do all chunks alone
+ * if pool threads are busy, so it waits only for shares which already started
+ * and marks the job closed - shares starting later return at once. A job is
+ * freed by whichever of them drops the last reference.
+ */
+
+/* internal macros */
+
+/* number of chunks each range is cut into. */
+#define G_SGRAPH_PARALLEL_CHUNKS_PER_RANGE 8
+
+/* internal types. */
+
+/**
+ * GSGraphParallelRange:
+ * @next: first index not yet claimed.
+ * @end: index past the last one in range.
+ *
+ * Internal struct holding a range of indices, which chunks are claimed from
+ * with atomic operations.
+ */
+typedef struct _GSGraphParallelRange GSGraphParallelRange;
+
+struct _GSGraphParallelRange
+{
+  gint next;
+  gint end;
+};
+
+/**
+ * GSGraphParallelJob:
+ * @array: array of elements or %NULL for a range of indices.
+ * @count: number of elements or indices.
+ * @ranges: ranges of indices, one for each thread.
+ * @n_ranges: number of ranges.
+ * @chunk_size: number of indices claimed at once.
+ * @for_func: function called with each index or %NULL.
+ * @func: function called with each element or %NULL.
+ * @equal_func: function matching elements or %NULL.
+ * @user_data: data passed to function.
+ * @found: lowest index of a matching element or %G_MAXINT.
+ * @next_range: number of range next started share takes as its own.
+ * @active: number of shares working on the job now.
+ * @closed: whether calling thread finished, so shares must not start.
+ * @ref_count: number of references - one of calling thread and one of each
+ * pushed share.
+ *
+ * Internal struct describing one call, shared by all threads working on it.
+ */
+typedef struct _GSGraphParallelJob GSGraphParallelJob;
+
+struct _GSGraphParallelJob
+{
+  GPtrArray* array;
+  guint count;
+  GSGraphParallelRange* ranges;
+  guint n_ranges;
+  gint chunk_size;
+  GSGraphParallelForFunc for_func;
+  GFunc func;
+  GEqualFunc equal_func;
+  gpointer user_data;
+  gint found;
+  guint next_range;
+  guint active;
+  gboolean closed;
+  gint ref_count;
+};
+
+/* static variables. */
+
+G_LOCK_DEFINE_STATIC (parallel_pool);
+
+static GThreadPool* pool = NULL;
+static GMutex* pool_mutex = NULL;
+static GCond* pool_cond = NULL;
+
+/* static function declarations. */
+
+static gpointer
+_g_sgraph_parallel_run (GSGraphParallelJob* job,
+                        guint n_threads);
+
+static GThreadPool*
+_g_sgraph_parallel_get_pool (guint n_threads);
+
+static void
+_g_sgraph_parallel_share (gpointer job,
+                          gpointer user_data);
+
+static void
+_g_sgraph_parallel_unref (GSGraphParallelJob* job);
+
+static void
+_g_sgraph_parallel_work (GSGraphParallelJob* job,
+                         guint own);
+
+static gboolean
+_g_sgraph_parallel_claim (GSGraphParallelRange* range,
+                          gint chunk_size,
+                          gint* start,
+                          gint* stop);
+
+static void
+_g_sgraph_parallel_process (GSGraphParallelJob* job,
+                            gint start,
+                            gint stop);
+
+static void
+_g_sgraph_parallel_set_found (GSGraphParallelJob* job,
+                              gint index);
+
+/* function definitions. */
+
+/**
+ * _g_sgraph_parallel_for:
+ * @count: number of indices.
+ * @func: the function to call with each index.
+ * @user_data: data passed to @func.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Calls @func for each index from 0 to @count - 1, spreading the calls over
+ * at most @n_threads threads. Order of calls is unspecified. Returns after all
+ * calls finished.
+ */
+void
+_g_sgraph_parallel_for (guint count,
+                        GSGraphParallelForFunc func,
+                        gpointer user_data,
+                        guint n_threads)
+{
+  GSGraphParallelJob* job;
+
+  job = g_slice_new (GSGraphParallelJob);
+  job->array = NULL;
+  job->count = count;
+  job->for_func = func;
+  job->func = NULL;
+  job->equal_func = NULL;
+  job->user_data = user_data;
+  _g_sgraph_parallel_run (job, n_threads);
+}
+
+/**
+ * _g_sgraph_parallel_foreach:
+ * @array: an array of elements.
+ * @func: the function to call with each element.
+ * @user_data: data passed to @func.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Calls @func for each element of @array, spreading the calls over at most
+ * @n_threads threads. Order of calls is unspecified. Returns after all calls
+ * finished. If threads are not available, calls are done sequentially.
+ */
+void
+_g_sgraph_parallel_foreach (GPtrArray* array,
+                            GFunc func,
+                            gpointer user_data,
+                            guint n_threads)
+{
+  GSGraphParallelJob* job;
+
+  job = g_slice_new (GSGraphParallelJob);
+  job->array = array;
+  job->count = array->len;
+  job->for_func = NULL;
+  job->func = func;
+  job->equal_func = NULL;
+  job->user_data = user_data;
+  _g_sgraph_parallel_run (job, n_threads);
+}
+
+/**
+ * _g_sgraph_parallel_find:
+ * @array: an array of elements.
+ * @func: the function to call with elements.
+ * @user_data: data passed to @func as second parameter.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Finds first element in @array for which @func returns %TRUE, spreading the
+ * calls over at most @n_threads threads. Once a match is found, chunks lying
+ * after it are not processed anymore. Result is always the match with lowest
+ * index, so it is the same as sequential search would give.
+ *
+ * Returns: found element or %NULL if there was no such element.
+ */
+gpointer
+_g_sgraph_parallel_find (GPtrArray* array,
+                         GEqualFunc func,
+                         gpointer user_data,
+                         guint n_threads)
+{
+  GSGraphParallelJob* job;
+
+  job = g_slice_new (GSGraphParallelJob);
+  job->array = array;
+  job->count = array->len;
+  job->for_func = NULL;
+  job->func = NULL;
+  job->equal_func = func;
+  job->user_data = user_data;
+
+  return _g_sgraph_parallel_run (job, n_threads);
+}
+
+/* static function definitions. */
+
+/**
+ * _g_sgraph_parallel_run:
+ * @job: a newly allocated job with elements and function set.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Splits @job into ranges, pushes a share of it for each additional thread
+ * into the pool and works on it in calling thread too. Returns when all
+ * chunks are processed and no other thread touches user data anymore. @job
+ * is freed when the last share drops its reference.
+ *
+ * Returns: element found by equal function of @job or %NULL.
+ */
+static gpointer
+_g_sgraph_parallel_run (GSGraphParallelJob* job,
+                        guint n_threads)
+{
+  GThreadPool* thread_pool;
+  gpointer found;
+  guint count;
+  gint len;
+  guint iter;
+
+  count = job->count;
+  if (!count || (count >= G_MAXINT))
+  {
+    g_slice_free (GSGraphParallelJob, job);
+    g_return_val_if_fail (count < G_MAXINT, NULL);
+    return NULL;
+  }
+  len = count;
+  if (n_threads > (guint)len)
+  {
+    n_threads = len;
+  }
+  thread_pool = NULL;
+  if ((n_threads > 1) && g_thread_supported ())
+  {
+    thread_pool = _g_sgraph_parallel_get_pool (n_threads);
+  }
+  if (!thread_pool)
+  {
+    n_threads = 1;
+  }
+
+  job->found = G_MAXINT;
+  job->next_range = 1;
+  job->active = 0;
+  job->closed = FALSE;
+  job->ref_count = n_threads;
+  job->n_ranges = n_threads;
+  job->ranges = g_new (GSGraphParallelRange, n_threads);
+  for (iter = 0; iter < n_threads; ++iter)
+  {
+    job->ranges[iter].next = (gint)(((gint64)len * iter) / n_threads);
+    job->ranges[iter].end = (gint)(((gint64)len * (iter + 1)) / n_threads);
+  }
+  job->chunk_size = len / (n_threads * G_SGRAPH_PARALLEL_CHUNKS_PER_RANGE);
+  if (!job->chunk_size)
+  {
+    job->chunk_size = 1;
+  }
+
+  for (iter = 1; iter < n_threads; ++iter)
+  {
+    g_thread_pool_push (thread_pool, job, NULL);
+  }
+  _g_sgraph_parallel_work (job, 0);
+
+  if (thread_pool)
+  {
+    g_mutex_lock (pool_mutex);
+    job->closed = TRUE;
+    while (job->active)
+    {
+      g_cond_wait (pool_cond, pool_mutex);
+    }
+    g_mutex_unlock (pool_mutex);
+  }
+
+  found = NULL;
+  if (job->found != G_MAXINT)
+  {
+    found = g_ptr_array_index (job->array, job->found);
+  }
+  _g_sgraph_parallel_unref (job);
+
+  return found;
+}
+
+/**
+ * _g_sgraph_parallel_get_pool:
+ * @n_threads: number of threads a job is going to use.
+ *
+ * Gets the pool shared by all jobs, creating it on first use. Pool is grown,
+ * so it has at least @n_threads - 1 threads, because calling thread works on
+ * a job too.
+ *
+ * Returns: the shared pool or %NULL if it could not be created.
+ */
+static GThreadPool*
+_g_sgraph_parallel_get_pool (guint n_threads)
+{
+  GThreadPool* thread_pool;
+
+  G_LOCK (parallel_pool);
+  if (!pool)
+  {
+    pool_mutex = g_mutex_new ();
+    pool_cond = g_cond_new ();
+    pool = g_thread_pool_new (_g_sgraph_parallel_share,
+                              NULL,
+                              n_threads - 1,
+                              TRUE,
+                              NULL);
+  }
+  else if (g_thread_pool_get_max_threads (pool) < (gint)n_threads - 1)
+  {
+    g_thread_pool_set_max_threads (pool, n_threads - 1, NULL);
+  }
+  thread_pool = pool;
+  G_UNLOCK (parallel_pool);
+
+  return thread_pool;
+}
+
+/**
+ * _g_sgraph_parallel_share:
+ * @job: a #GSGraphParallelJob.
+ * @user_data: unused.
+ *
+ * Works on a share of @job in a pool thread, unless calling thread already
+ * finished the job. Drops the reference of the share afterwards.
+ */
+static void
+_g_sgraph_parallel_share (gpointer job,
+                          gpointer user_data G_GNUC_UNUSED)
+{
+  GSGraphParallelJob* parallel_job;
+  gboolean closed;
+  guint own;
+
+  parallel_job = job;
+  g_mutex_lock (pool_mutex);
+  closed = parallel_job->closed;
+  own = parallel_job->next_range;
+  if (!closed)
+  {
+    ++parallel_job->active;
+    ++parallel_job->next_range;
+  }
+  g_mutex_unlock (pool_mutex);
+
+  if (!closed)
+  {
+    _g_sgraph_parallel_work (parallel_job, own);
+    g_mutex_lock (pool_mutex);
+    --parallel_job->active;
+    if (!parallel_job->active)
+    {
+      g_cond_broadcast (pool_cond);
+    }
+    g_mutex_unlock (pool_mutex);
+  }
+  _g_sgraph_parallel_unref (parallel_job);
+}
+
+/**
+ * _g_sgraph_parallel_unref:
+ * @job: a job.
+ *
+ * Drops a reference to @job and frees it if it was the last one.
+ */
+static void
+_g_sgraph_parallel_unref (GSGraphParallelJob* job)
+{
+  if (g_atomic_int_dec_and_test (&job->ref_count))
+  {
+    g_free (job->ranges);
+    g_slice_free (GSGraphParallelJob, job);
+  }
+}
+
+/**
+ * _g_sgraph_parallel_work:
+ * @job: a job.
+ * @own: number of range to start with.
+ *
+ * Processes chunks of @own range and then steals chunks from other ranges,
+ * until all of them are claimed.
+ */
+static void
+_g_sgraph_parallel_work (GSGraphParallelJob* job,
+                         guint own)
+{
+  guint iter;
+
+  for (iter = 0; iter < job->n_ranges; ++iter)
+  {
+    GSGraphParallelRange* range;
+    gint start;
+    gint stop;
+
+    range = job->ranges + (own + iter) % job->n_ranges;
+    while (_g_sgraph_parallel_claim (range,
+                                     job->chunk_size,
+                                     &start,
+                                     &stop))
+    {
+      /* remaining chunks of this range lie after a found match. */
+      if (start >= g_atomic_int_get (&job->found))
+      {
+        break;
+      }
+      _g_sgraph_parallel_process (job, start, stop);
+    }
+  }
+}
+
+/**
+ * _g_sgraph_parallel_claim:
+ * @range: a range.
+ * @chunk_size: maximum number of indices to claim.
+ * @start: return location for first claimed index.
+ * @stop: return location for index past the last claimed one.
+ *
+ * Claims next chunk of @range. It is safe to call it from many threads at
+ * once.
+ *
+ * Returns: %TRUE if a chunk was claimed, %FALSE if @range is exhausted.
+ */
+static gboolean
+_g_sgraph_parallel_claim (GSGraphParallelRange* range,
+                          gint chunk_size,
+                          gint* start,
+                          gint* stop)
+{
+  do
+  {
+    *start = g_atomic_int_get (&range->next);
+    if (*start >= range->end)
+    {
+      return FALSE;
+    }
+    *stop = MIN (*start + chunk_size, range->end);
+  } while (!g_atomic_int_compare_and_exchange (&range->next, *start, *stop));
+  return TRUE;
+}
+
+/**
+ * _g_sgraph_parallel_process:
+ * @job: a job.
+ * @start: first index of a chunk.
+ * @stop: index past the last one of the chunk.
+ *
+ * Calls function of @job for indices or elements of a chunk. When matching
+ * elements, stops at first match or when a match with lower index was found.
+ */
+static void
+_g_sgraph_parallel_process (GSGraphParallelJob* job,
+                            gint start,
+                            gint stop)
+{
+  gint iter;
+
+  if (job->for_func)
+  {
+    for (iter = start; iter < stop; ++iter)
+    {
+      (*job->for_func) (iter, job->user_data);
+    }
+    return;
+  }
+
+  if (job->func)
+  {
+    for (iter = start; iter < stop; ++iter)
+    {
+      (*job->func) (g_ptr_array_index (job->array, iter), job->user_data);
+    }
+    return;
+  }
+
+  for (iter = start; iter < stop; ++iter)
+  {
+    /* there is a match before this one - rest of chunk is not needed. */
+    if (iter >= g_atomic_int_get (&job->found))
+    {
+      return;
+    }
+    if ((*job->equal_func) (g_ptr_array_index (job->array, iter),
+                            job->user_data))
+    {
+      _g_sgraph_parallel_set_found (job, iter);
+      return;
+    }
+  }
+}
+
+/**
+ * _g_sgraph_parallel_set_found:
+ * @job: a job.
+ * @index: index of a matching element.
+ *
+ * Records @index as found match, unless a match with lower index was already
+ * recorded.
+ */
+static void
+_g_sgraph_parallel_set_found (GSGraphParallelJob* job,
+                              gint index)
+{
+  gint found;
+
+  do
+  {
+    found = g_atomic_int_get (&job->found);
+    if (index >= found)
+    {
+      return;
+    }
+  } while (!g_atomic_int_compare_and_exchange (&job->found, found, index));
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "This is a private header, it must not be included outside libggraph."
+#endif
+
+#ifndef _G_SGRAPH_PARALLEL_H_
+#define _G_SGRAPH_PARALLEL_H_
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GSGraphParallelForFunc:
+ * @index: an index of an element.
+ * @user_data: user data.
+ *
+ * Function called by _g_sgraph_parallel_for() for each index.
+ */
+typedef void (*GSGraphParallelForFunc) (guint index,
+                                        gpointer user_data);
+
+G_GNUC_INTERNAL void
+_g_sgraph_parallel_for (guint count,
+                        GSGraphParallelForFunc func,
+                        gpointer user_data,
+                        guint n_threads);
+
+G_GNUC_INTERNAL void
+_g_sgraph_parallel_foreach (GPtrArray* array,
+                            GFunc func,
+                            gpointer user_data,
+                            guint n_threads);
+
+G_GNUC_INTERNAL gpointer
+_g_sgraph_parallel_find (GPtrArray* array,
+                         GEqualFunc func,
+                         gpointer user_data,
+                         guint n_threads);
+
+G_END_DECLS
+
+#endif /* _G_SGRAPH_PARALLEL_H_ */
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsgraphpositions.h"
+
+/* Dense positions of elements let copying functions remap pointers with an
+ * array lookup. A position is written directly into the visit mark of an
+ * element and the mark is remembered in a per-call array at that position, so
+ * a mark holds a position only if the array points back to it. This needs the
+ * domain lock for the whole call, which is taken by claiming a single epoch,
+ * and when the map is cleared, all the marks are set to that epoch, so they
+ * do not look visited to later traversals. When the epoch cannot be claimed,
+ * elements with their positions are put into a side array, which is sorted by
+ * address and binary searched.
+ */
+
+/* static function declarations. */
+
+static gint
+_g_sgraph_positions_compare (gconstpointer entry,
+                             gconstpointer other_entry,
+                             gpointer user_data);
+
+/* function definitions. */
+
+/**
+ * _g_sgraph_positions_init:
+ * @positions: a map of positions to initialize.
+ * @domain: domain of elements.
+ * @count: number of positions.
+ *
+ * Prepares @positions for @count elements. If an epoch was claimed, the domain
+ * lock is held until _g_sgraph_positions_clear() is called.
+ */
+void
+_g_sgraph_positions_init (GSGraphPositions* positions,
+                          GSGraphVisitedDomain domain,
+                          guint count)
+{
+  positions->sorted = NULL;
+  positions->marks = NULL;
+  positions->count = count;
+  positions->marked = (count &&
+                       _g_sgraph_visited_try_init (&positions->visited,
+                                                   domain,
+                                                   1));
+  if (positions->marked)
+  {
+    positions->marks = g_new0 (guint32*, count);
+  }
+  else
+  {
+    positions->sorted = g_array_sized_new (FALSE,
+                                           FALSE,
+                                           sizeof (GSGraphPositionsEntry),
+                                           count);
+  }
+}
+
+/**
+ * _g_sgraph_positions_seal:
+ * @positions: a map of positions.
+ *
+ * Finishes setting positions, so they can be read.
+ */
+void
+_g_sgraph_positions_seal (GSGraphPositions* positions)
+{
+  if (!positions->marked)
+  {
+    g_qsort_with_data (positions->sorted->data,
+                       positions->sorted->len,
+                       sizeof (GSGraphPositionsEntry),
+                       _g_sgraph_positions_compare,
+                       NULL);
+  }
+}
+
+/**
+ * _g_sgraph_positions_clear:
+ * @positions: a map of positions.
+ *
+ * Releases resources held by @positions - either a side array or the domain
+ * lock. In the latter case visit marks holding positions are set to the
+ * claimed epoch.
+ */
+void
+_g_sgraph_positions_clear (GSGraphPositions* positions)
+{
+  if (positions->marked)
+  {
+    guint iter;
+
+    for (iter = 0; iter < positions->count; ++iter)
+    {
+      if (positions->marks[iter])
+      {
+        *positions->marks[iter] = positions->visited.epoch;
+      }
+    }
+    g_free (positions->marks);
+    _g_sgraph_visited_clear (&positions->visited);
+  }
+  else
+  {
+    g_array_free (positions->sorted, TRUE);
+  }
+}
+
+/**
+ * _g_sgraph_positions_search:
+ * @positions: a sealed map of positions using a side array.
+ * @element: an element.
+ *
+ * Finds position of @element with binary search.
+ *
+ * Returns: position of @element or %G_MAXUINT if it has none.
+ */
+guint
+_g_sgraph_positions_search (GSGraphPositions* positions,
+                            gconstpointer element)
+{
+  GSGraphPositionsEntry* entries;
+  guint low;
+  guint high;
+
+  entries = (GSGraphPositionsEntry*)positions->sorted->data;
+  low = 0;
+  high = positions->sorted->len;
+  while (low < high)
+  {
+    guint middle;
+
+    middle = low + (high - low) / 2;
+    if ((gsize)entries[middle].element < (gsize)element)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+
+  if ((low < positions->sorted->len) && (entries[low].element == element))
+  {
+    return entries[low].position;
+  }
+  return G_MAXUINT;
+}
+
+/* static function definitions. */
+
+/**
+ * _g_sgraph_positions_compare:
+ * @entry: a #GSGraphPositionsEntry.
+ * @other_entry: other #GSGraphPositionsEntry.
+ * @user_data: unused.
+ *
+ * Compares addresses of elements in entries, for sorting the side array.
+ *
+ * Returns: negative value, zero or positive value if address of element in
+ * @entry is lower than, equal to or greater than the one in @other_entry.
+ */
+static gint
+_g_sgraph_positions_compare (gconstpointer entry,
+                             gconstpointer other_entry,
+                             gpointer user_data G_GNUC_UNUSED)
+{
+  gsize address;
+  gsize other_address;
+
+  address = (gsize)((const GSGraphPositionsEntry*)entry)->element;
+  other_address = (gsize)((const GSGraphPositionsEntry*)other_entry)->element;
+  if (address < other_address)
+  {
+    return -1;
+  }
+  return (address > other_address);
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "This is a private header, it must not be included outside libggraph."
+#endif
+
+#ifndef _G_SGRAPH_POSITIONS_H_
+#define _G_SGRAPH_POSITIONS_H_
+
+#include <glib.h>
+
+#include "gsgraphvisited.h"
+
+G_BEGIN_DECLS
+
+/**
+ * GSGraphPositions:
+ * @visited: a visited set with single side, used when @marked is %TRUE.
+ * @marked: whether positions are kept in visit marks.
+ * @marks: array of visit marks of elements, indexed by their positions, used
+ * when @marked is %TRUE.
+ * @count: length of @marks.
+ * @sorted: #GArray of #GSGraphPositionsEntry sorted by address of element,
+ * used when @marked is %FALSE.
+ *
+ * Internal map of graph elements to their dense positions, used instead of
+ * a hash table when elements are copied. Positions are kept in visit marks
+ * if an epoch can be claimed, otherwise elements are found by binary search
+ * in a side array.
+ */
+typedef struct _GSGraphPositions GSGraphPositions;
+
+struct _GSGraphPositions
+{
+  GSGraphVisited visited;
+  gboolean marked;
+  guint32** marks;
+  guint count;
+  GArray* sorted;
+};
+
+/**
+ * GSGraphPositionsEntry:
+ * @element: an element.
+ * @position: position of @element.
+ *
+ * Internal entry of side array of #GSGraphPositions.
+ */
+typedef struct _GSGraphPositionsEntry GSGraphPositionsEntry;
+
+struct _GSGraphPositionsEntry
+{
+  gpointer element;
+  guint position;
+};
+
+G_GNUC_INTERNAL void
+_g_sgraph_positions_init (GSGraphPositions* positions,
+                          GSGraphVisitedDomain domain,
+                          guint count);
+
+G_GNUC_INTERNAL void
+_g_sgraph_positions_seal (GSGraphPositions* positions);
+
+G_GNUC_INTERNAL void
+_g_sgraph_positions_clear (GSGraphPositions* positions);
+
+G_GNUC_INTERNAL guint
+_g_sgraph_positions_search (GSGraphPositions* positions,
+                            gconstpointer element);
+
+/**
+ * _g_sgraph_positions_set:
+ * @positions: a map of positions.
+ * @element: a node or an edge.
+ * @mark: visit mark of @element.
+ * @position: position of @element, less than count passed to
+ * _g_sgraph_positions_init().
+ *
+ * Sets position of @element. All positions have to be set before
+ * _g_sgraph_positions_seal() is called.
+ */
+static inline void
+_g_sgraph_positions_set (GSGraphPositions* positions,
+                         gpointer element,
+                         guint32* mark,
+                         guint position)
+{
+  if (positions->marked)
+  {
+    *mark = position;
+    positions->marks[position] = mark;
+  }
+  else
+  {
+    GSGraphPositionsEntry entry;
+
+    entry.element = element;
+    entry.position = position;
+    g_array_append_val (positions->sorted, entry);
+  }
+}
+
+/**
+ * _g_sgraph_positions_get:
+ * @positions: a sealed map of positions.
+ * @element: a node or an edge.
+ * @mark: visit mark of @element.
+ *
+ * Gets position of @element. It is safe to call it from many threads at once.
+ *
+ * Returns: position of @element or %G_MAXUINT if it has none.
+ */
+static inline guint
+_g_sgraph_positions_get (GSGraphPositions* positions,
+                         gpointer element,
+                         guint32* mark)
+{
+  if (positions->marked)
+  {
+    guint32 position;
+
+    position = *mark;
+    if ((position < positions->count) &&
+        (positions->marks[position] == mark))
+    {
+      return position;
+    }
+    return G_MAXUINT;
+  }
+  return _g_sgraph_positions_search (positions, element);
+}
+
+G_END_DECLS
+
+#endif /* _G_SGRAPH_POSITIONS_H_ */
@@ -18,6 +18,19 @@
  */
 
 #include "gsgraphsnapshot.h"
+#include "gsgraphsnapshotprivate.h"
+#include "gsgraphbuilder.h"
+#include "gsgraphcsr.h"
+#include "gsgraphnodeprivate.h"
+#include "gsgrapharenaprivate.h"
+#include "gsgraphiterprivate.h"
+
+#include "gsgraphparallel.h"
+#include "gsgraphdataindex.h"
+#include "gsgraphpositions.h"
+#include "gsgraphordering.h"
+#include "gsgraphcomponents.h"
+#include "gsgraphbiconnected.h"
 
 /**
  * SECTION: gsgraphsnapshot
@@ -33,19 +46,49 @@
  * wrapper are reflected in wrapper too.
  *
  * Wrapper can be created using two traversing algorithms to add nodes to arrays
- * inside the wrapper or by specifing data triplets.
+ * inside the wrapper or by specifing data triplets. Traversal is done with
+ * #GSGraphIter, so the order of nodes is the same as the order in which
+ * an iterator returns them.
  *
  * To create a structure, use g_sgraph_snapshot_new() or
- * g_sgraph_snapshot_new_from_node().
+ * g_sgraph_snapshot_new_from_node(). To create it from pairs fed one by one or
+ * read from an edge list file, use #GSGraphBuilder.
  *
- * To make a copy of graph, use g_sgraph_snapshot_copy() or
- * g_sgraph_snapshot_copy_deep().
+ * To make a copy of graph, use g_sgraph_snapshot_copy(),
+ * g_sgraph_snapshot_copy_deep() or g_sgraph_snapshot_copy_deep_parallel().
+ *
+ * To create nodes of new graph in #GSGraphArena, use
+ * g_sgraph_snapshot_new_in_arena() or g_sgraph_snapshot_copy_in_arena().
+ *
+ * To put neighbouring nodes close to each other in memory, use
+ * g_sgraph_snapshot_reorder(). It copies a graph with nodes in order computed
+ * by g_sgraph_snapshot_get_ordering(), so algorithms going through the copy
+ * jump less between distant nodes.
  *
  * To free a wrapper or whole graph too, use g_sgraph_snapshot_free().
  *
- * To find a node, use g_sgraph_snapshot_find_node_custom().
+ * To get order and size of a graph, use g_sgraph_snapshot_get_order() and
+ * g_sgraph_snapshot_get_size(). Size is counted once and cached. To change
+ * a graph without losing cached size, use g_sgraph_snapshot_add_node(),
+ * g_sgraph_snapshot_remove_node(), g_sgraph_snapshot_connect_nodes() and
+ * g_sgraph_snapshot_disconnect_nodes(). If nodes are changed behind the
+ * wrapper's back, with #GSGraphNode functions or by changing nodes array
+ * directly, use g_sgraph_snapshot_set_dirty().
+ *
+ * To find a node, use g_sgraph_snapshot_find_node_custom() or its threaded
+ * version g_sgraph_snapshot_find_node_custom_parallel(). To find nodes by data
+ * many times, build an index with g_sgraph_snapshot_build_index() and use
+ * g_sgraph_snapshot_lookup_node().
  *
- * To process nodes, use g_sgraph_snapshot_foreach_node().
+ * To process nodes, use g_sgraph_snapshot_foreach_node() or its threaded
+ * version g_sgraph_snapshot_foreach_node_parallel().
+ *
+ * To find connected components of any array of nodes using many threads, use
+ * g_sgraph_snapshot_label_components(). To get one wrapper for each of them,
+ * use g_sgraph_snapshot_split_components().
+ *
+ * To find articulation points and biconnected blocks of a graph, use
+ * g_sgraph_snapshot_find_blocks().
  *
  * <note>
  *   <para>
@@ -59,34 +102,66 @@
 /* internal types. */
 
 /**
- * GSGraphConstructFlags:
- * @G_SGRAPH_NONE: no nodes were created.
- * @G_SGRAPH_FIRST: node containing first data was created.
- * @G_SGRAPH_SECOND: node containing second data was created.
- * @G_SGRAPH_BOTH: both nodes were created.
+ * GSGraphSnapshotCopy:
+ * @graph: a graph being copied.
+ * @dup_graph: a copy of @graph.
+ * @positions: positions of @graph's nodes.
+ * @node_data_copy_func: function copying data in nodes.
+ * @node_user_data: data passed to node data copying function.
  *
- * Internal enum for g_sgraph_snapshot_new() needs. Describes which nodes were
- * created.
+ * Internal state of a copy, shared by threads copying nodes.
  */
-typedef enum
+typedef struct _GSGraphSnapshotCopy GSGraphSnapshotCopy;
+
+struct _GSGraphSnapshotCopy
 {
-  G_SGRAPH_NONE = 0,
-  G_SGRAPH_FIRST = 1 << 0,
-  G_SGRAPH_SECOND = 1 << 1,
-  G_SGRAPH_BOTH = G_SGRAPH_FIRST | G_SGRAPH_SECOND
-} GSGraphConstructFlags;
+  GSGraphSnapshot* graph;
+  GSGraphSnapshot* dup_graph;
+  GSGraphPositions positions;
+  GCopyFunc node_data_copy_func;
+  gpointer node_user_data;
+};
 
-/* static function declarations. */
+/**
+ * GSGraphSnapshotComponents:
+ * @nodes: nodes being labelled.
+ * @positions: positions of @nodes.
+ * @components: forest of components of @nodes.
+ *
+ * Internal state of components labelling, shared by threads joining nodes.
+ */
+typedef struct _GSGraphSnapshotComponents GSGraphSnapshotComponents;
 
-static void
-_g_sgraph_snapshot_append_DFS (GSGraphNode* node,
-                               GPtrArray* node_array,
-                               GHashTable* visited_nodes);
+struct _GSGraphSnapshotComponents
+{
+  GPtrArray* nodes;
+  GSGraphPositions positions;
+  GSGraphComponents* components;
+};
 
-static void
-_g_sgraph_snapshot_append_BFS (GSGraphNode* node,
-                               GPtrArray* node_array,
-                               GHashTable* visited_nodes);
+/**
+ * GSGraphSnapshotFrame:
+ * @index: position of a node being visited.
+ * @parent: position of its parent or %G_MAXUINT for a root.
+ * @position: position of next neighbour to check in neighbours of the node.
+ *
+ * Frame of iterative depth-first search.
+ */
+typedef struct _GSGraphSnapshotFrame GSGraphSnapshotFrame;
+
+struct _GSGraphSnapshotFrame
+{
+  guint index;
+  guint parent;
+  guint position;
+};
+
+/* static function declarations. */
+
+static GPtrArray*
+_g_sgraph_snapshot_new_general (GSGraphArena* arena,
+                                GSGraphDataPair** data_pairs,
+                                guint count);
 
 static GSGraphSnapshot*
 _g_sgraph_snapshot_new_from_node_general (GSGraphNode* node,
@@ -94,11 +169,27 @@ _g_sgraph_snapshot_new_from_node_general (GSGraphNode* node,
 
 static GSGraphSnapshot*
 _g_sgraph_snapshot_copy_general (GSGraphSnapshot* graph,
+                                 GSGraphArena* arena,
                                  GCopyFunc node_data_copy_func,
-                                 gpointer node_user_data);
+                                 gpointer node_user_data,
+                                 guint n_threads);
 
-static GSGraphSnapshot*
-_g_sgraph_snapshot_new_blank (guint node_array_size);
+static void
+_g_sgraph_snapshot_copy_node (guint index,
+                              gpointer copy);
+
+static gboolean
+_g_sgraph_snapshot_is_counted (GSGraphSnapshot* graph);
+
+static void
+_g_sgraph_snapshot_count (GSGraphSnapshot* graph);
+
+static gpointer
+_g_sgraph_snapshot_get_node_data (gpointer node);
+
+static void
+_g_sgraph_snapshot_join_neighbours (guint index,
+                                    gpointer components);
 
 /* public function definitions. */
 
@@ -113,40 +204,15 @@ _g_sgraph_snapshot_new_blank (guint node_array_size);
  * omitted in creation. If @count is 0, it  is assumed that @data_pairs is %NULL
  * terminated array.
  *
- * For performance reasons it would be good if in second and
- * later pairs one of node have data describing already created node.
- * Lets assume we want to create this graph:
- * <informalexample>
- *   <programlisting>
- *     A--B
- *     |
- *     C--D
- *   </programlisting>
- * </informalexample>
- * So best order of pairs is:
- * <itemizedlist>
- *   <listitem>
- *     <para>
- *       A, B
- *     </para>
- *   </listitem>
- *   <listitem>
- *     <para>
- *       A, C
- *     </para>
- *   </listitem>
- *   <listitem>
- *     <para>
- *       C, D
- *     </para>
- *   </listitem>
- * </itemizedlist>
- * This way we never create a separate graph, because in given pair one of the
- * members is already created, so newly created one will be its neighbour and a
- * part of larger graph.
- * Swaping third and fourth pair will cause creation of a separate graph while
- * processing third pair and checking if two graphs are one when processing
- * fourth pair.
+ * Separate graphs are tracked with a disjoint-set forest and node arrays are
+ * filled only after all pairs are processed, so construction time is nearly
+ * linear in number of pairs regardless of their order. Separate graphs are
+ * ordered by first appearance of their nodes in @data_pairs and nodes in each
+ * graph are in order of their creation. Each graph gets an index of its nodes
+ * by data, so they can be found with g_sgraph_snapshot_lookup_node().
+ *
+ * To avoid creating all data pairs up front, feed pairs to #GSGraphBuilder
+ * instead.
  *
  * Returns: array of newly created separate graphs or %NULL if no nodes were
  * created.
@@ -155,173 +221,32 @@ GPtrArray*
 g_sgraph_snapshot_new (GSGraphDataPair** data_pairs,
                        guint count)
 {
-  GPtrArray* separate_graphs;
-  GHashTable* data_to_nodes;
-  GHashTable* nodes_to_wholes;
-  guint iter;
-
   g_return_val_if_fail (data_pairs != NULL, NULL);
 
-  if (!count)
-  {
-    while (data_pairs[count])
-    {
-      ++count;
-    }
-  }
-
-  if (!count)
-  {
-    return NULL;
-  }
-
-  separate_graphs = g_ptr_array_new ();
-  data_to_nodes = g_hash_table_new (NULL, NULL);
-  nodes_to_wholes = g_hash_table_new (NULL, NULL);
-  for (iter = 0; iter < count; ++iter)
-  {
-    GSGraphDataPair* data_pair;
-
-    data_pair = data_pairs[iter];
-    if (g_sgraph_data_pair_is_valid (data_pair))
-    {
-      GSGraphNode* first_node;
-      GSGraphNode* second_node;
-      GSGraphConstructFlags created;
-
-      created = G_SGRAPH_NONE;
-      if (!g_hash_table_lookup_extended (data_to_nodes,
-                                         data_pair->first,
-                                         NULL,
-                                         (gpointer*)&first_node))
-      {
-        first_node = g_sgraph_node_new (data_pair->first);
-        g_hash_table_insert (data_to_nodes, data_pair->first, first_node);
-        created |= G_SGRAPH_FIRST;
-      }
-
-      if (!g_hash_table_lookup_extended (data_to_nodes,
-                                         data_pair->second,
-                                         NULL,
-                                         (gpointer*)&second_node))
-      {
-        second_node = g_sgraph_node_new (data_pair->second);
-        g_hash_table_insert (data_to_nodes, data_pair->second, second_node);
-        created |= G_SGRAPH_SECOND;
-      }
-
-      g_sgraph_node_connect (first_node, second_node);
-      switch (created)
-      {
-        case G_SGRAPH_NONE:
-        {
-          /* no nodes were created, so they can join two separate graphs. */
-          #define JOIN_COUNT 2
-          guint which;
-          GSGraphSnapshot* joined_graphs[JOIN_COUNT];
-          GSGraphNode* check_nodes[JOIN_COUNT];
-
-          check_nodes[0] = first_node;
-          check_nodes[1] = second_node;
-          for (which = 0; which < JOIN_COUNT; ++which)
-          {
-            guint iter2;
-
-            for (iter2 = 0; iter2 < separate_graphs->len; ++iter2)
-            {
-              GSGraphSnapshot* graph;
-              guint iter3;
-              gboolean hit;
-
-              graph = g_ptr_array_index (separate_graphs, iter2);
-              hit = FALSE;
-              for (iter3 = 0; iter3 < graph->node_array->len; ++iter3)
-              {
-                GSGraphNode* temp_node;
-
-                temp_node = g_ptr_array_index (graph->node_array, iter3);
-                if (temp_node == check_nodes[which])
-                {
-                  joined_graphs[which] = graph;
-                  hit = TRUE;
-                  break;
-                }
-              }
-              if (hit)
-              {
-                break;
-              }
-            }
-          }
-
-          if (joined_graphs[0] != joined_graphs[1])
-          {
-            guint iter2;
-
-            for (iter2 = 0; iter2 < joined_graphs[1]->node_array->len; ++iter2)
-            {
-              GSGraphNode* temp_node;
-
-              temp_node = g_ptr_array_index (joined_graphs[1]->node_array,
-                                             iter2);
-              if (temp_node != check_nodes[1])
-              {
-                g_ptr_array_add (joined_graphs[0]->node_array, temp_node);
-                g_hash_table_insert (nodes_to_wholes,
-                                     temp_node,
-                                     joined_graphs[0]);
-              }
-            }
-            g_ptr_array_remove_fast (separate_graphs, joined_graphs[1]);
-            g_sgraph_snapshot_free (joined_graphs[1], FALSE);
-          }
-          #undef JOIN_COUNT
-          break;
-        }
-        case G_SGRAPH_FIRST:
-        {
-          /* first node was created, so it belongs to existing graph. */
-          GSGraphSnapshot* temp_graph;
+  return _g_sgraph_snapshot_new_general (NULL, data_pairs, count);
+}
 
-          temp_graph = g_hash_table_lookup (nodes_to_wholes, second_node);
-          g_ptr_array_add (temp_graph->node_array, first_node);
-          g_hash_table_insert (nodes_to_wholes, first_node, temp_graph);
-          break;
-        }
-        case G_SGRAPH_SECOND:
-        {
-          /* second node was created, so it belongs to existing graph. */
-          GSGraphSnapshot* temp_graph;
+/**
+ * g_sgraph_snapshot_new_in_arena:
+ * @arena: an arena.
+ * @data_pairs: array of data pairs.
+ * @count: length of @data_pairs.
+ *
+ * Does the same as g_sgraph_snapshot_new(), but memory for nodes is taken from
+ * @arena.
+ *
+ * Returns: array of newly created separate graphs or %NULL if no nodes were
+ * created.
+ */
+GPtrArray*
+g_sgraph_snapshot_new_in_arena (GSGraphArena* arena,
+                                GSGraphDataPair** data_pairs,
+                                guint count)
+{
+  g_return_val_if_fail (arena != NULL, NULL);
+  g_return_val_if_fail (data_pairs != NULL, NULL);
 
-          temp_graph = g_hash_table_lookup (nodes_to_wholes, first_node);
-          g_ptr_array_add (temp_graph->node_array, second_node);
-          g_hash_table_insert (nodes_to_wholes, second_node, temp_graph);
-          break;
-        }
-        case G_SGRAPH_BOTH:
-        {
-          /* if both nodes were created then they create separate graph. */
-          GSGraphSnapshot* temp_graph;
-
-          temp_graph = _g_sgraph_snapshot_new_blank (2);
-          g_ptr_array_add (temp_graph->node_array, first_node);
-          g_ptr_array_add (temp_graph->node_array, second_node);
-          g_ptr_array_add (separate_graphs, temp_graph);
-          g_hash_table_insert (nodes_to_wholes, first_node, temp_graph);
-          g_hash_table_insert (nodes_to_wholes, second_node, temp_graph);
-          break;
-        }
-      }
-    }
-  }
-  g_hash_table_unref (data_to_nodes);
-  g_hash_table_unref (nodes_to_wholes);
-  if (!separate_graphs->len)
-  {
-    g_ptr_array_free (separate_graphs, TRUE);
-    separate_graphs = NULL;
-  }
-  return separate_graphs;
+  return _g_sgraph_snapshot_new_general (arena, data_pairs, count);
 }
 
 /**
@@ -358,7 +283,7 @@ g_sgraph_snapshot_copy (GSGraphSnapshot* graph)
 {
   g_return_val_if_fail (graph != NULL, NULL);
 
-  return _g_sgraph_snapshot_copy_general (graph, NULL, NULL);
+  return _g_sgraph_snapshot_copy_general (graph, NULL, NULL, NULL, 1);
 }
 
 /**
@@ -381,8 +306,159 @@ g_sgraph_snapshot_copy_deep (GSGraphSnapshot* graph,
   g_return_val_if_fail (node_data_copy_func != NULL, NULL);
 
   return _g_sgraph_snapshot_copy_general (graph,
+                                          NULL,
+                                          node_data_copy_func,
+                                          node_user_data,
+                                          1);
+}
+
+/**
+ * g_sgraph_snapshot_copy_deep_parallel:
+ * @graph: a graph to be copied.
+ * @node_data_copy_func: function copying data in nodes.
+ * @node_user_data: data passed to node data copying function.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Does the same as g_sgraph_snapshot_copy_deep(), but data and neighbours of
+ * nodes are copied by at most @n_threads threads. @node_data_copy_func must be
+ * safe to call from many threads at once.
+ *
+ * Returns: A copy of @graph.
+ */
+GSGraphSnapshot*
+g_sgraph_snapshot_copy_deep_parallel (GSGraphSnapshot* graph,
+                                      GCopyFunc node_data_copy_func,
+                                      gpointer node_user_data,
+                                      guint n_threads)
+{
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (node_data_copy_func != NULL, NULL);
+
+  return _g_sgraph_snapshot_copy_general (graph,
+                                          NULL,
+                                          node_data_copy_func,
+                                          node_user_data,
+                                          n_threads);
+}
+
+/**
+ * g_sgraph_snapshot_copy_in_arena:
+ * @graph: a graph to be copied.
+ * @arena: an arena.
+ * @node_data_copy_func: a function copying node data or %NULL.
+ * @node_user_data: user data passed to @node_data_copy_func.
+ *
+ * Does a copy of @graph with memory for nodes taken from @arena. If
+ * @node_data_copy_func is %NULL, data is shared like in
+ * g_sgraph_snapshot_copy(), otherwise it is duplicated like in
+ * g_sgraph_snapshot_copy_deep().
+ *
+ * Returns: A copy of @graph.
+ */
+GSGraphSnapshot*
+g_sgraph_snapshot_copy_in_arena (GSGraphSnapshot* graph,
+                                 GSGraphArena* arena,
+                                 GCopyFunc node_data_copy_func,
+                                 gpointer node_user_data)
+{
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (arena != NULL, NULL);
+
+  return _g_sgraph_snapshot_copy_general (graph,
+                                          arena,
                                           node_data_copy_func,
-                                          node_user_data);
+                                          node_user_data,
+                                          1);
+}
+
+/**
+ * g_sgraph_snapshot_get_ordering:
+ * @graph: a graph.
+ * @ordering: kind of order.
+ *
+ * Computes an order of nodes in @graph, which improves locality of memory
+ * accesses. All neighbours of nodes in @graph have to be in @graph too.
+ *
+ * Returns: #GArray of #guint32 indices into @graph's node array, i-th element
+ * being the index of node which goes at position i. Free it with
+ * g_array_free().
+ */
+GArray*
+g_sgraph_snapshot_get_ordering (GSGraphSnapshot* graph,
+                                GSGraphOrdering ordering)
+{
+  GSGraphCsr* csr;
+  GArray* permutation;
+
+  g_return_val_if_fail (graph != NULL, NULL);
+
+  csr = g_sgraph_csr_new (graph);
+  if (!csr)
+  {
+    return NULL;
+  }
+  permutation = _g_sgraph_ordering_compute (csr->order,
+                                            csr->offsets,
+                                            csr->neighbours,
+                                            ordering);
+  g_sgraph_csr_free (csr);
+
+  return permutation;
+}
+
+/**
+ * g_sgraph_snapshot_reorder:
+ * @graph: a graph to be reordered.
+ * @arena: an arena or %NULL.
+ * @ordering: kind of order.
+ *
+ * Does a copy of @graph with nodes in order computed by
+ * g_sgraph_snapshot_get_ordering(). Nodes of copy are allocated one after
+ * another in that order, so when @arena is not %NULL, neighbouring nodes end up
+ * close to each other in memory. Data is shared like in
+ * g_sgraph_snapshot_copy(). Reordering pays off for graphs which are traversed
+ * many times.
+ *
+ * Returns: A reordered copy of @graph or %NULL if some neighbours are not in
+ * @graph.
+ */
+GSGraphSnapshot*
+g_sgraph_snapshot_reorder (GSGraphSnapshot* graph,
+                           GSGraphArena* arena,
+                           GSGraphOrdering ordering)
+{
+  GSGraphSnapshot* temp_graph;
+  GSGraphSnapshot* dup_graph;
+  GArray* permutation;
+  guint iter;
+
+  g_return_val_if_fail (graph != NULL, NULL);
+
+  permutation = g_sgraph_snapshot_get_ordering (graph, ordering);
+  if (!permutation)
+  {
+    return NULL;
+  }
+
+  temp_graph = _g_sgraph_snapshot_new_blank (permutation->len);
+  for (iter = 0; iter < permutation->len; ++iter)
+  {
+    g_ptr_array_add (temp_graph->node_array,
+                     g_ptr_array_index (graph->node_array,
+                                        g_array_index (permutation,
+                                                       guint32,
+                                                       iter)));
+  }
+  g_array_free (permutation, TRUE);
+
+  dup_graph = _g_sgraph_snapshot_copy_general (temp_graph,
+                                               arena,
+                                               NULL,
+                                               NULL,
+                                               1);
+  g_sgraph_snapshot_free (temp_graph, FALSE);
+
+  return dup_graph;
 }
 
 /**
@@ -412,6 +488,10 @@ g_sgraph_snapshot_free (GSGraphSnapshot* graph,
     }
   }
 
+  if (graph->node_index)
+  {
+    _g_sgraph_data_index_free (graph->node_index);
+  }
   g_ptr_array_free (graph->node_array, TRUE);
   g_slice_free (GSGraphSnapshot, graph);
 }
@@ -438,222 +518,754 @@ g_sgraph_snapshot_get_order (GSGraphSnapshot* graph)
  * @graph: a graph.
  *
  * Gets @graph's size, that is - number of edges in graph. Since there are no
- * edges then number of all connections is returned.
+ * edges then number of all connections is returned. Size is taken from cache
+ * in constant time, unless @graph was marked dirty or number of its nodes
+ * changed since it was counted - then it is counted again in time linear in
+ * order of @graph. Cache does not notice nodes gaining or losing neighbours
+ * by #GSGraphNode functions, see g_sgraph_snapshot_set_dirty().
  *
  * Returns: number of edges in graph.
  */
 guint
 g_sgraph_snapshot_get_size (GSGraphSnapshot* graph)
 {
-  guint iter;
-  guint size;
-
   g_return_val_if_fail (graph != NULL, 0);
   g_return_val_if_fail (graph->node_array != NULL, 0);
 
-  size = 0;
-  for (iter = 0; iter < graph->node_array->len; ++iter)
+  if (!_g_sgraph_snapshot_is_counted (graph))
   {
-    GSGraphNode* node;
-
-    node = g_ptr_array_index (graph->node_array, iter);
-    size += node->neighbours->len;
+    _g_sgraph_snapshot_count (graph);
   }
 
-  return (size / 2);
+  return (graph->degree_sum / 2);
 }
 
 /**
- * g_sgraph_snapshot_foreach_node:
+ * g_sgraph_snapshot_set_dirty:
  * @graph: a graph.
- * @func: the function to call with each @graph's node.
- * @user_data: data passed to @func.
  *
- * Calls @func for each node in @graph.
+ * Marks cached size of @graph as stale, so it is counted again when it is
+ * needed. Call it after changing neighbours of @graph's nodes with
+ * #GSGraphNode functions, like g_sgraph_node_connect(), or after replacing
+ * nodes in @graph's node array. Snapshot functions changing a graph keep the
+ * cache valid, so they need no such call. Staleness is tracked by each
+ * wrapper alone, so changing other graphs never invalidates cached size of
+ * @graph.
  */
 void
-g_sgraph_snapshot_foreach_node (GSGraphSnapshot* graph,
-                                GFunc func,
-                                gpointer user_data)
+g_sgraph_snapshot_set_dirty (GSGraphSnapshot* graph)
 {
-  guint iter;
+  g_return_if_fail (graph != NULL);
+
+  graph->dirty = TRUE;
+}
+
+/**
+ * g_sgraph_snapshot_add_node:
+ * @graph: a graph.
+ * @node: a node not being in @graph.
+ *
+ * Appends @node to @graph's node array, keeping cached size valid. All
+ * neighbours of @node should be in @graph.
+ */
+void
+g_sgraph_snapshot_add_node (GSGraphSnapshot* graph,
+                            GSGraphNode* node)
+{
+  gboolean counted;
 
   g_return_if_fail (graph != NULL);
   g_return_if_fail (graph->node_array != NULL);
-  g_return_if_fail (func != NULL);
+  g_return_if_fail (node != NULL);
 
-  for (iter = 0; iter < graph->node_array->len; ++iter)
+  counted = _g_sgraph_snapshot_is_counted (graph);
+  g_ptr_array_add (graph->node_array, node);
+  if (graph->node_index)
   {
-    GSGraphNode* node = g_ptr_array_index (graph->node_array, iter);
-    (*func) (node, user_data);
+    _g_sgraph_data_index_insert (graph->node_index, node->data, node);
+  }
+  if (counted)
+  {
+    graph->degree_sum += node->neighbours->len;
+    graph->counted_order = graph->node_array->len;
   }
 }
 
 /**
- * g_sgraph_snapshot_find_node_custom:
+ * g_sgraph_snapshot_remove_node:
  * @graph: a graph.
- * @user_data: user data passed to @func.
- * @func: the function to call for each node.
+ * @node: a node in @graph.
  *
- * Finds first element in a @graph, using a supplied function to find the
- * desired element. It iterates over the node array, calling the given function
- * which should return %TRUE when the desired element is found. The function
- * takes two arguments, the node from the iterated array as the first argument
- * and the given @user_data as second. If an element is found it is returned.
+ * Removes @node from @graph's node array, disconnects it from all its
+ * neighbours and frees it, keeping cached size valid. Order of remaining nodes
+ * is preserved. If @graph has an index and @node was the indexed one among
+ * nodes with equal data, the next of them in node array gets indexed instead.
+ * Takes time linear in order of @graph.
  *
- * Returns: found #GSGraphNode or %NULL if there was no such node.
+ * Returns: data of removed node.
  */
-GSGraphNode*
-g_sgraph_snapshot_find_node_custom (GSGraphSnapshot* graph,
-                                    gpointer user_data,
-                                    GEqualFunc func)
+gpointer
+g_sgraph_snapshot_remove_node (GSGraphSnapshot* graph,
+                               GSGraphNode* node)
 {
-  guint iter;
+  gpointer data;
+  gboolean counted;
+  guint degree;
 
   g_return_val_if_fail (graph != NULL, NULL);
   g_return_val_if_fail (graph->node_array != NULL, NULL);
-  g_return_val_if_fail (func != NULL, NULL);
+  g_return_val_if_fail (node != NULL, NULL);
 
-  for (iter = 0; iter < graph->node_array->len; ++iter)
+  counted = _g_sgraph_snapshot_is_counted (graph);
+  if (!g_ptr_array_remove (graph->node_array, node))
   {
-    GSGraphNode* node = g_ptr_array_index (graph->node_array, iter);
-    if ((*func) (node, user_data))
-    {
-      return node;
-    }
+    g_return_val_if_reached (NULL);
+  }
+  if (graph->node_index)
+  {
+    _g_sgraph_data_index_remove (graph->node_index,
+                                 node->data,
+                                 node,
+                                 graph->node_array,
+                                 _g_sgraph_snapshot_get_node_data);
+  }
+  degree = node->neighbours->len;
+  data = g_sgraph_node_remove (node);
+  if (counted)
+  {
+    graph->degree_sum -= 2 * degree;
+    graph->counted_order = graph->node_array->len;
   }
-  return NULL;
-}
 
-/* static function definitions. */
+  return data;
+}
 
 /**
- * _g_sgraph_snapshot_append_DFS:
- * @node: a node, which will be put into arrays with its edges.
- * @node_array: array of all nodes in graph.
- * @visited_nodes: a map of already visited nodes.
+ * g_sgraph_snapshot_connect_nodes:
+ * @graph: a graph.
+ * @node: a node in @graph.
+ * @other_node: other node in @graph.
  *
- * Checks all nodes and put them into array using depth first search algorithm.
+ * Connects @node with @other_node like g_sgraph_node_connect() does, keeping
+ * cached size of @graph valid.
  */
-static void
-_g_sgraph_snapshot_append_DFS (GSGraphNode* node,
-                               GPtrArray* node_array,
-                               GHashTable* visited_nodes)
+void
+g_sgraph_snapshot_connect_nodes (GSGraphSnapshot* graph,
+                                 GSGraphNode* node,
+                                 GSGraphNode* other_node)
 {
-  guint iter;
+  gboolean counted;
+  guint degree;
 
-  if (g_hash_table_lookup_extended (visited_nodes, node, NULL, NULL))
-  {
-    return;
-  }
+  g_return_if_fail (graph != NULL);
+  g_return_if_fail (node != NULL);
 
-  g_hash_table_insert (visited_nodes, node, NULL);
-  g_ptr_array_add (node_array, node);
-  for (iter = 0; iter < node->neighbours->len; ++iter)
+  counted = _g_sgraph_snapshot_is_counted (graph);
+  degree = node->neighbours->len;
+  g_sgraph_node_connect (node, other_node);
+  if (counted)
   {
-    GSGraphNode* other_node;
-
-    other_node = g_ptr_array_index (node->neighbours, iter);
-    _g_sgraph_snapshot_append_DFS (other_node, node_array, visited_nodes);
+    graph->degree_sum += 2 * (node->neighbours->len - degree);
   }
 }
 
 /**
- * _g_sgraph_snapshot_append_BFS:
- * @node: a node, which will be put into arrays with its edges.
- * @node_array: array of all nodes in graph.
- * @visited_nodes: a map of already visited nodes.
+ * g_sgraph_snapshot_disconnect_nodes:
+ * @graph: a graph.
+ * @node: a node in @graph.
+ * @other_node: other node in @graph.
  *
- * Checks all nodes and put them into array using breadth first search
- * algorithm.
+ * Disconnects @node from @other_node like g_sgraph_node_disconnect() does,
+ * keeping cached size of @graph valid.
  */
-static void
-_g_sgraph_snapshot_append_BFS (GSGraphNode* node,
-                               GPtrArray* node_array,
-                               GHashTable* visited_nodes)
+void
+g_sgraph_snapshot_disconnect_nodes (GSGraphSnapshot* graph,
+                                    GSGraphNode* node,
+                                    GSGraphNode* other_node)
 {
-  GQueue* queue;
-
-  queue = g_queue_new ();
+  gboolean counted;
+  guint degree;
 
-  g_hash_table_insert (visited_nodes, node, NULL);
-  g_queue_push_tail (queue, node);
-  g_ptr_array_add (node_array, node);
+  g_return_if_fail (graph != NULL);
+  g_return_if_fail (node != NULL);
 
-  while (!g_queue_is_empty (queue))
+  counted = _g_sgraph_snapshot_is_counted (graph);
+  degree = node->neighbours->len;
+  g_sgraph_node_disconnect (node, other_node);
+  if (counted)
   {
-    GSGraphNode* temp_node;
-    guint iter;
-
-    temp_node = g_queue_pop_head (queue);
-
-    for (iter = 0; iter < temp_node->neighbours->len; ++iter)
-    {
-      GSGraphNode* other_node;
-
-      other_node = g_ptr_array_index (temp_node->neighbours, iter);
-
-      if (g_hash_table_lookup_extended (visited_nodes, other_node, NULL, NULL))
-      {
-        continue;
-      }
-
-      g_hash_table_insert (visited_nodes, other_node, NULL);
-      g_queue_push_tail (queue, other_node);
-      g_ptr_array_add (node_array, other_node);
-    }
+    graph->degree_sum -= 2 * (degree - node->neighbours->len);
   }
-
-  g_queue_free (queue);
 }
 
 /**
- * _g_sgraph_snapshot_new_from_node_general:
- * @node: a node being a part of a graph.
- * @traverse_type: which traversing algorithm to use.
+ * g_sgraph_snapshot_build_index:
+ * @graph: a graph.
+ * @hash_func: a function to create a hash value from node's data or %NULL.
+ * @key_equal_func: a function to check two node's data for equality or %NULL.
+ * @n_threads: number of threads to use, including the calling one.
  *
- * General function creating a #GSGraphSnapshot from given @node using
- * traversing algorithm denoted by @traverse_type.
+ * Builds an index of nodes in @graph by their data, so
+ * g_sgraph_snapshot_lookup_node() can find them without iterating the node
+ * array. @hash_func and @key_equal_func have the same meaning as in
+ * g_hash_table_new(), so if they are %NULL, data are compared directly. If
+ * there are many nodes with equal data, the first one in node array is
+ * indexed. If @n_threads is greater than 1, index is built by that many
+ * threads, so @hash_func and @key_equal_func must be safe to call from many
+ * threads at once. Previous index of @graph, if any, is dropped.
  *
- * Returns: new #GSGraphSnapshot.
+ * Graphs created with g_sgraph_snapshot_new() already have an index comparing
+ * data directly, which was used during their construction.
+ *
+ * Index is kept up to date by g_sgraph_snapshot_add_node() and
+ * g_sgraph_snapshot_remove_node(). If node array or data of nodes are changed
+ * directly, index has to be built again.
  */
-static GSGraphSnapshot*
-_g_sgraph_snapshot_new_from_node_general (GSGraphNode* node,
-                                          GSGraphTraverseType traverse_type)
+void
+g_sgraph_snapshot_build_index (GSGraphSnapshot* graph,
+                               GHashFunc hash_func,
+                               GEqualFunc key_equal_func,
+                               guint n_threads)
 {
-  typedef void (*GraphSearchFunc) (GSGraphNode* node,
-                                   GPtrArray* node_array,
-                                   GHashTable* visited_nodes);
+  g_return_if_fail (graph != NULL);
+  g_return_if_fail (graph->node_array != NULL);
 
-  GSGraphSnapshot* graph;
-  GHashTable* visited_nodes;
-  GraphSearchFunc gsfunc;
+  g_sgraph_snapshot_drop_index (graph);
+  graph->node_index =
+    _g_sgraph_data_index_new (graph->node_array,
+                              _g_sgraph_snapshot_get_node_data,
+                              hash_func,
+                              key_equal_func,
+                              n_threads);
+}
+
+/**
+ * g_sgraph_snapshot_drop_index:
+ * @graph: a graph.
+ *
+ * Frees an index of @graph's nodes, if it has one.
+ */
+void
+g_sgraph_snapshot_drop_index (GSGraphSnapshot* graph)
+{
+  g_return_if_fail (graph != NULL);
+
+  if (graph->node_index)
+  {
+    _g_sgraph_data_index_free (graph->node_index);
+    graph->node_index = NULL;
+  }
+}
+
+/**
+ * g_sgraph_snapshot_has_index:
+ * @graph: a graph.
+ *
+ * Checks whether @graph has an index of its nodes.
+ *
+ * Returns: %TRUE if @graph has an index, otherwise %FALSE.
+ */
+gboolean
+g_sgraph_snapshot_has_index (GSGraphSnapshot* graph)
+{
+  g_return_val_if_fail (graph != NULL, FALSE);
+
+  return (graph->node_index != NULL);
+}
+
+/**
+ * g_sgraph_snapshot_lookup_node:
+ * @graph: a graph with an index.
+ * @data: data of a node.
+ *
+ * Finds a node holding @data using an index of @graph. See
+ * g_sgraph_snapshot_build_index().
+ *
+ * Returns: found #GSGraphNode or %NULL if there was no such node.
+ */
+GSGraphNode*
+g_sgraph_snapshot_lookup_node (GSGraphSnapshot* graph,
+                               gconstpointer data)
+{
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->node_index != NULL, NULL);
+
+  return _g_sgraph_data_index_lookup (graph->node_index, data);
+}
+
+/**
+ * g_sgraph_snapshot_foreach_node:
+ * @graph: a graph.
+ * @func: the function to call with each @graph's node.
+ * @user_data: data passed to @func.
+ *
+ * Calls @func for each node in @graph.
+ */
+void
+g_sgraph_snapshot_foreach_node (GSGraphSnapshot* graph,
+                                GFunc func,
+                                gpointer user_data)
+{
+  guint iter;
+
+  g_return_if_fail (graph != NULL);
+  g_return_if_fail (graph->node_array != NULL);
+  g_return_if_fail (func != NULL);
+
+  for (iter = 0; iter < graph->node_array->len; ++iter)
+  {
+    GSGraphNode* node = g_ptr_array_index (graph->node_array, iter);
+    (*func) (node, user_data);
+  }
+}
+
+/**
+ * g_sgraph_snapshot_find_node_custom:
+ * @graph: a graph.
+ * @user_data: user data passed to @func.
+ * @func: the function to call for each node.
+ *
+ * Finds first element in a @graph, using a supplied function to find the
+ * desired element. It iterates over the node array, calling the given function
+ * which should return %TRUE when the desired element is found. The function
+ * takes two arguments, the node from the iterated array as the first argument
+ * and the given @user_data as second. If an element is found it is returned.
+ *
+ * Returns: found #GSGraphNode or %NULL if there was no such node.
+ */
+GSGraphNode*
+g_sgraph_snapshot_find_node_custom (GSGraphSnapshot* graph,
+                                    gpointer user_data,
+                                    GEqualFunc func)
+{
+  guint iter;
 
-  switch (traverse_type)
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->node_array != NULL, NULL);
+  g_return_val_if_fail (func != NULL, NULL);
+
+  for (iter = 0; iter < graph->node_array->len; ++iter)
   {
-    case G_SGRAPH_TRAVERSE_BFS:
+    GSGraphNode* node = g_ptr_array_index (graph->node_array, iter);
+    if ((*func) (node, user_data))
     {
-      gsfunc = _g_sgraph_snapshot_append_BFS;
-      break;
+      return node;
     }
-    case G_SGRAPH_TRAVERSE_DFS:
+  }
+  return NULL;
+}
+
+/**
+ * g_sgraph_snapshot_foreach_node_parallel:
+ * @graph: a graph.
+ * @func: the function to call with each node.
+ * @user_data: data passed to @func.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Calls @func for each node in @graph, like
+ * g_sgraph_snapshot_foreach_node() does, but spreads the calls over at most
+ * @n_threads threads. The node array is split into chunks and idle threads
+ * take chunks left by busy ones. Calls happen in no particular order and
+ * @func must be safe to call from many threads at once. This function
+ * returns after all calls finished.
+ *
+ * If threads are not supported, that is - g_thread_init() was not called with
+ * older GLib, @func is called sequentially.
+ */
+void
+g_sgraph_snapshot_foreach_node_parallel (GSGraphSnapshot* graph,
+                                         GFunc func,
+                                         gpointer user_data,
+                                         guint n_threads)
+{
+  g_return_if_fail (graph != NULL);
+  g_return_if_fail (graph->node_array != NULL);
+  g_return_if_fail (func != NULL);
+
+  _g_sgraph_parallel_foreach (graph->node_array, func, user_data, n_threads);
+}
+
+/**
+ * g_sgraph_snapshot_find_node_custom_parallel:
+ * @graph: a graph.
+ * @user_data: user data passed to @func.
+ * @func: the function to call for each node.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Finds first element in a @graph, like
+ * g_sgraph_snapshot_find_node_custom() does, but spreads the calls of
+ * @func over at most @n_threads threads. When a match is found, parts of the
+ * node array lying after it are not searched anymore. Returned node is
+ * always the one with lowest index in the array, so the result is the same as
+ * the sequential version gives. @func must be safe to call from many threads
+ * at once.
+ *
+ * Returns: found #GSGraphNode or %NULL if there was no such node.
+ */
+GSGraphNode*
+g_sgraph_snapshot_find_node_custom_parallel (GSGraphSnapshot* graph,
+                                             gpointer user_data,
+                                             GEqualFunc func,
+                                             guint n_threads)
+{
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->node_array != NULL, NULL);
+  g_return_val_if_fail (func != NULL, NULL);
+
+  return _g_sgraph_parallel_find (graph->node_array,
+                                  func,
+                                  user_data,
+                                  n_threads);
+}
+
+/**
+ * g_sgraph_snapshot_label_components:
+ * @nodes: array of distinct nodes, for example node array of a graph.
+ * @n_components: return location for number of components or %NULL.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Finds connected components of @nodes using at most @n_threads threads.
+ * Only connections between nodes in @nodes are taken into account, neighbours
+ * outside of it are ignored. Each thread joins nodes with their neighbours in
+ * a disjoint-set forest, which is updated with atomic operations instead of
+ * locks. Components are labelled with numbers from 0 to number of components
+ * minus 1, in order of their first nodes in @nodes.
+ *
+ * If threads are not supported, that is - g_thread_init() was not called with
+ * older GLib, components are found sequentially.
+ *
+ * Returns: newly created #GArray of #guint32 labels, i-th element being the
+ * label of i-th node in @nodes. Free it with g_array_free().
+ */
+GArray*
+g_sgraph_snapshot_label_components (GPtrArray* nodes,
+                                    guint* n_components,
+                                    guint n_threads)
+{
+  GSGraphSnapshotComponents graph_components;
+  GArray* labels;
+  guint count;
+  guint iter;
+
+  g_return_val_if_fail (nodes != NULL, NULL);
+  g_return_val_if_fail (nodes->len < G_MAXINT, NULL);
+
+  graph_components.nodes = nodes;
+  graph_components.components = _g_sgraph_components_new (nodes->len);
+  _g_sgraph_positions_init (&graph_components.positions,
+                            G_SGRAPH_VISITED_DOMAIN_SGRAPH,
+                            nodes->len);
+  for (iter = 0; iter < nodes->len; ++iter)
+  {
+    GSGraphNode* node;
+
+    node = g_ptr_array_index (nodes, iter);
+    _g_sgraph_positions_set (&graph_components.positions,
+                             node,
+                             &node->visit_mark,
+                             iter);
+  }
+  _g_sgraph_positions_seal (&graph_components.positions);
+
+  _g_sgraph_parallel_for (nodes->len,
+                          _g_sgraph_snapshot_join_neighbours,
+                          &graph_components,
+                          n_threads);
+  _g_sgraph_positions_clear (&graph_components.positions);
+
+  labels = g_array_sized_new (FALSE, FALSE, sizeof (guint32), nodes->len);
+  g_array_set_size (labels, nodes->len);
+  count = _g_sgraph_components_label (graph_components.components,
+                                      (guint32*)labels->data,
+                                      n_threads);
+  _g_sgraph_components_free (graph_components.components);
+
+  if (n_components)
+  {
+    *n_components = count;
+  }
+  return labels;
+}
+
+/**
+ * g_sgraph_snapshot_split_components:
+ * @nodes: array of distinct nodes, for example node array of a graph.
+ * @n_threads: number of threads to use, including the calling one.
+ *
+ * Splits @nodes into connected components found by
+ * g_sgraph_snapshot_label_components(). Nodes in each component keep their
+ * order from @nodes. Wrappers are created, nodes are not copied.
+ *
+ * Returns: newly created #GPtrArray of #GSGraphSnapshot<!-- -->s, one for each
+ * component, in order of their first nodes in @nodes.
+ */
+GPtrArray*
+g_sgraph_snapshot_split_components (GPtrArray* nodes,
+                                    guint n_threads)
+{
+  GPtrArray* graphs;
+  GArray* labels;
+  guint count;
+  guint iter;
+
+  g_return_val_if_fail (nodes != NULL, NULL);
+
+  labels = g_sgraph_snapshot_label_components (nodes, &count, n_threads);
+  if (!labels)
+  {
+    return NULL;
+  }
+
+  graphs = g_ptr_array_sized_new (count);
+  for (iter = 0; iter < count; ++iter)
+  {
+    g_ptr_array_add (graphs, _g_sgraph_snapshot_new_blank (0));
+  }
+  for (iter = 0; iter < nodes->len; ++iter)
+  {
+    GSGraphSnapshot* graph;
+
+    graph = g_ptr_array_index (graphs, g_array_index (labels, guint32, iter));
+    g_ptr_array_add (graph->node_array, g_ptr_array_index (nodes, iter));
+  }
+  g_array_free (labels, TRUE);
+
+  return graphs;
+}
+
+/**
+ * g_sgraph_snapshot_find_blocks:
+ * @graph: a graph.
+ * @articulation_points: return location for articulation points or %NULL.
+ *
+ * Finds biconnected blocks and articulation points of @graph in one
+ * depth-first search, so it takes time linear in order and size of @graph and
+ * @graph is not changed. Search is iterative, so it works for graphs of any
+ * depth. An articulation point is a node, which removal leaves more connected
+ * components. A block is a maximal set of nodes, which stays connected after
+ * removing any one of its nodes. Blocks can share only articulation points
+ * and a node without neighbours is a block by itself. Neighbours outside of
+ * node array are ignored.
+ *
+ * If @articulation_points is not %NULL, it is set to a newly created #GArray
+ * of #guint32 indices of articulation points in node array, in ascending
+ * order. Free it with g_array_free().
+ *
+ * Returns: newly created #GPtrArray of blocks, each being #GArray of #guint32
+ * indices of its nodes in node array, in no particular order. Free each block
+ * with g_array_free() and the array with g_ptr_array_free().
+ */
+GPtrArray*
+g_sgraph_snapshot_find_blocks (GSGraphSnapshot* graph,
+                               GArray** articulation_points)
+{
+  GSGraphPositions positions;
+  GSGraphBiconnected* biconnected;
+  GArray* stack;
+  guint node_count;
+  guint iter;
+
+  g_return_val_if_fail (graph != NULL, NULL);
+  g_return_val_if_fail (graph->node_array != NULL, NULL);
+
+  node_count = graph->node_array->len;
+  _g_sgraph_positions_init (&positions,
+                            G_SGRAPH_VISITED_DOMAIN_SGRAPH,
+                            node_count);
+  for (iter = 0; iter < node_count; ++iter)
+  {
+    GSGraphNode* node;
+
+    node = g_ptr_array_index (graph->node_array, iter);
+    _g_sgraph_positions_set (&positions, node, &node->visit_mark, iter);
+  }
+  _g_sgraph_positions_seal (&positions);
+
+  biconnected = _g_sgraph_biconnected_new (node_count);
+  stack = g_array_new (FALSE, FALSE, sizeof (GSGraphSnapshotFrame));
+  for (iter = 0; iter < node_count; ++iter)
+  {
+    GSGraphSnapshotFrame root;
+
+    if (!_g_sgraph_biconnected_start (biconnected, iter))
     {
-      gsfunc = _g_sgraph_snapshot_append_DFS;
-      break;
+      continue;
     }
-    default:
+    root.index = iter;
+    root.parent = G_MAXUINT;
+    root.position = 0;
+    g_array_append_val (stack, root);
+    while (stack->len)
     {
-      g_return_val_if_reached (NULL);
+      GSGraphSnapshotFrame* frame;
+      GSGraphNode* node;
+
+      frame = &g_array_index (stack, GSGraphSnapshotFrame, stack->len - 1);
+      node = g_ptr_array_index (graph->node_array, frame->index);
+      if (frame->position < node->neighbours->len)
+      {
+        GSGraphNode* neighbour;
+        GSGraphSnapshotFrame child;
+
+        neighbour = g_ptr_array_index (node->neighbours, frame->position);
+        ++frame->position;
+        child.index = _g_sgraph_positions_get (&positions,
+                                               neighbour,
+                                               &neighbour->visit_mark);
+        if ((child.index == G_MAXUINT) ||
+            (child.index == frame->parent) ||
+            (child.index == frame->index))
+        {
+          continue;
+        }
+        if (_g_sgraph_biconnected_reach (biconnected,
+                                         frame->index,
+                                         child.index))
+        {
+          child.parent = frame->index;
+          child.position = 0;
+          g_array_append_val (stack, child);
+        }
+      }
+      else
+      {
+        guint index;
+        guint parent;
+
+        index = frame->index;
+        parent = frame->parent;
+        g_array_set_size (stack, stack->len - 1);
+        if (parent != G_MAXUINT)
+        {
+          _g_sgraph_biconnected_finish (biconnected, parent, index);
+        }
+        else
+        {
+          _g_sgraph_biconnected_finish_root (biconnected, index);
+        }
+      }
     }
   }
+  g_array_free (stack, TRUE);
+  _g_sgraph_positions_clear (&positions);
 
-  graph = _g_sgraph_snapshot_new_blank (0);
+  return _g_sgraph_biconnected_free (biconnected, articulation_points);
+}
+
+/* internal function definitions. */
+
+/**
+ * _g_sgraph_snapshot_new_blank:
+ * @node_array_size: size of node array.
+ *
+ * Constructs #GSGraphSnapshot with an array with given size.
+ *
+ * Returns: new #GSGraphSnapshot.
+ */
+GSGraphSnapshot*
+_g_sgraph_snapshot_new_blank (guint node_array_size)
+{
+  GSGraphSnapshot* graph;
+
+  graph = g_slice_new (GSGraphSnapshot);
+
+  graph->node_array = g_ptr_array_sized_new (node_array_size);
+  graph->degree_sum = 0;
+  graph->counted_order = 0;
+  graph->dirty = FALSE;
+  graph->node_index = NULL;
+
+  return graph;
+}
+
+/* static function definitions. */
+
+/**
+ * _g_sgraph_snapshot_new_general:
+ * @arena: an arena or %NULL.
+ * @data_pairs: array of data pairs.
+ * @count: length of @data_pairs.
+ *
+ * Creates a graph from passed data pairs. If @arena is not %NULL, memory for
+ * nodes is taken from it. See g_sgraph_snapshot_new() for details.
+ *
+ * Returns: array of newly created separate graphs or %NULL if no nodes were
+ * created.
+ */
+static GPtrArray*
+_g_sgraph_snapshot_new_general (GSGraphArena* arena,
+                                GSGraphDataPair** data_pairs,
+                                guint count)
+{
+  GSGraphBuilder* builder;
+  guint iter;
+
+  if (!count)
+  {
+    while (data_pairs[count])
+    {
+      ++count;
+    }
+  }
+
+  if (!count)
+  {
+    return NULL;
+  }
+
+  if (arena)
+  {
+    builder = g_sgraph_builder_new_in_arena (arena, NULL, NULL);
+  }
+  else
+  {
+    builder = g_sgraph_builder_new (NULL, NULL);
+  }
+  for (iter = 0; iter < count; ++iter)
+  {
+    GSGraphDataPair* data_pair;
+
+    data_pair = data_pairs[iter];
+    if (g_sgraph_data_pair_is_valid (data_pair))
+    {
+      g_sgraph_builder_add_pair (builder, data_pair->first, data_pair->second);
+    }
+  }
+
+  return g_sgraph_builder_finish (builder);
+}
+
+/**
+ * _g_sgraph_snapshot_new_from_node_general:
+ * @node: a node being a part of a graph.
+ * @traverse_type: which traversing algorithm to use.
+ *
+ * General function creating a #GSGraphSnapshot from given @node using
+ * traversing algorithm denoted by @traverse_type.
+ *
+ * Returns: new #GSGraphSnapshot.
+ */
+static GSGraphSnapshot*
+_g_sgraph_snapshot_new_from_node_general (GSGraphNode* node,
+                                          GSGraphTraverseType traverse_type)
+{
+  GSGraphSnapshot* graph;
+  GSGraphIter iter;
+  GSGraphNode* other_node;
 
-  visited_nodes = g_hash_table_new (NULL, NULL);
+  g_return_val_if_fail ((traverse_type == G_SGRAPH_TRAVERSE_BFS) ||
+                        (traverse_type == G_SGRAPH_TRAVERSE_DFS), NULL);
 
-  (*gsfunc) (node, graph->node_array, visited_nodes);
+  graph = _g_sgraph_snapshot_new_blank (0);
 
-  g_hash_table_unref (visited_nodes);
+  _g_sgraph_iter_init (&iter, node, traverse_type, TRUE);
+  while ((other_node = g_sgraph_iter_next (&iter)))
+  {
+    g_ptr_array_add (graph->node_array, other_node);
+    graph->degree_sum += other_node->neighbours->len;
+  }
+  _g_sgraph_iter_clear (&iter);
+  graph->counted_order = graph->node_array->len;
 
   return graph;
 }
@@ -661,26 +1273,40 @@ _g_sgraph_snapshot_new_from_node_general (GSGraphNode* node,
 /**
  * _g_sgraph_snapshot_copy_general:
  * @graph: a graph to be copied.
+ * @arena: an arena for nodes of copy or %NULL.
  * @node_data_copy_func: function copying data in nodes.
  * @node_user_data: data passed to node data copying function.
+ * @n_threads: number of threads to use, including the calling one.
  *
  * Does a copy of @graph. Each node data in @graph copy is duplicated using
  * passed function. If @node_data_copy_func is %NULL, then shallow copy of data
- * is done.
+ * is done. If @arena is not %NULL, memory for nodes is taken from it.
+ *
+ * Every node gets a dense position first, so neighbours are remapped with an
+ * array lookup. Nodes are allocated in the calling thread, then their data
+ * and neighbours are copied by @n_threads threads.
  *
  * Returns: A copy of @graph.
  */
 static GSGraphSnapshot*
 _g_sgraph_snapshot_copy_general (GSGraphSnapshot* graph,
+                                 GSGraphArena* arena,
                                  GCopyFunc node_data_copy_func,
-                                 gpointer node_user_data)
+                                 gpointer node_user_data,
+                                 guint n_threads)
 {
-  GHashTable* nodes_to_dups;
+  GSGraphSnapshotCopy copy;
   GSGraphSnapshot* dup_graph;
   guint iter;
 
-  nodes_to_dups = g_hash_table_new (NULL, NULL);
   dup_graph = _g_sgraph_snapshot_new_blank (graph->node_array->len);
+  copy.graph = graph;
+  copy.dup_graph = dup_graph;
+  copy.node_data_copy_func = node_data_copy_func;
+  copy.node_user_data = node_user_data;
+  _g_sgraph_positions_init (&copy.positions,
+                            G_SGRAPH_VISITED_DOMAIN_SGRAPH,
+                            graph->node_array->len);
 
   for (iter = 0; iter < graph->node_array->len; ++iter)
   {
@@ -688,64 +1314,186 @@ _g_sgraph_snapshot_copy_general (GSGraphSnapshot* graph,
     GSGraphNode* dup_node;
 
     node = g_ptr_array_index (graph->node_array, iter);
-    dup_node = g_slice_new (GSGraphNode);
-
-    if (node_data_copy_func)
+    if (arena)
     {
-      dup_node->data = (*node_data_copy_func) (node->data, node_user_data);
+      dup_node = _g_sgraph_arena_alloc_node (arena);
     }
     else
     {
-      dup_node->data = node->data;
+      dup_node = g_slice_new (GSGraphNode);
     }
+    dup_node->arena = arena;
 
-    g_hash_table_insert (nodes_to_dups, node, dup_node);
+    _g_sgraph_positions_set (&copy.positions, node, &node->visit_mark, iter);
     g_ptr_array_add (dup_graph->node_array, dup_node);
   }
+  _g_sgraph_positions_seal (&copy.positions);
 
-  for (iter = 0; iter < graph->node_array->len; ++iter)
+  _g_sgraph_parallel_for (graph->node_array->len,
+                          _g_sgraph_snapshot_copy_node,
+                          &copy,
+                          n_threads);
+  _g_sgraph_positions_clear (&copy.positions);
+
+  for (iter = 0; iter < dup_graph->node_array->len; ++iter)
   {
-    GSGraphNode* node;
     GSGraphNode* dup_node;
-    GPtrArray* dup_edges;
-    guint iter2;
 
-    node = g_ptr_array_index (graph->node_array, iter);
     dup_node = g_ptr_array_index (dup_graph->node_array, iter);
-    dup_edges = g_ptr_array_sized_new (node->neighbours->len);
+    dup_graph->degree_sum += dup_node->neighbours->len;
+  }
+  dup_graph->counted_order = dup_graph->node_array->len;
 
-    for (iter2 = 0; iter2 < node->neighbours->len; ++iter2)
-    {
-      GSGraphNode* neighbour;
-      GSGraphNode* dup_neighbour;
+  return dup_graph;
+}
 
-      neighbour = g_ptr_array_index (node->neighbours, iter2);
-      dup_neighbour = g_hash_table_lookup (nodes_to_dups, neighbour);
-      g_ptr_array_add (dup_edges, dup_neighbour);
-    }
-    dup_node->neighbours = dup_edges;
+/**
+ * _g_sgraph_snapshot_copy_node:
+ * @index: an index of a node.
+ * @copy: a #GSGraphSnapshotCopy.
+ *
+ * Fills a copy of @index-th node with duplicated data and neighbours.
+ */
+static void
+_g_sgraph_snapshot_copy_node (guint index,
+                              gpointer copy)
+{
+  GSGraphSnapshotCopy* graph_copy;
+  GSGraphNode* node;
+  GSGraphNode* dup_node;
+  GPtrArray* dup_neighbours;
+  guint iter;
+
+  graph_copy = copy;
+  node = g_ptr_array_index (graph_copy->graph->node_array, index);
+  dup_node = g_ptr_array_index (graph_copy->dup_graph->node_array, index);
+  dup_node->connectivity = NULL;
+  dup_node->connectivity_index = 0;
+  dup_node->visit_mark = 0;
+  dup_node->neighbour_index = NULL;
+
+  if (graph_copy->node_data_copy_func)
+  {
+    dup_node->data =
+      (*graph_copy->node_data_copy_func) (node->data,
+                                          graph_copy->node_user_data);
+  }
+  else
+  {
+    dup_node->data = node->data;
   }
 
-  g_hash_table_unref (nodes_to_dups);
-  return dup_graph;
+  dup_neighbours = g_ptr_array_sized_new (node->neighbours->len);
+  for (iter = 0; iter < node->neighbours->len; ++iter)
+  {
+    GSGraphNode* neighbour;
+    guint position;
+
+    neighbour = g_ptr_array_index (node->neighbours, iter);
+    position = _g_sgraph_positions_get (&graph_copy->positions,
+                                        neighbour,
+                                        &neighbour->visit_mark);
+    if (position == G_MAXUINT)
+    {
+      g_ptr_array_add (dup_neighbours, NULL);
+    }
+    else
+    {
+      g_ptr_array_add (dup_neighbours,
+                       g_ptr_array_index (graph_copy->dup_graph->node_array,
+                                          position));
+    }
+  }
+  dup_node->neighbours = dup_neighbours;
+  _g_sgraph_node_update_index (dup_node);
 }
 
 /**
- * _g_sgraph_snapshot_new_blank:
- * @node_array_size: size of node array.
+ * _g_sgraph_snapshot_is_counted:
+ * @graph: a graph.
  *
- * Constructs #GSGraphSnapshot with an array with given size.
+ * Checks whether cached degree sum of @graph is up to date. It is stale when
+ * it was marked so or when number of nodes in @graph changed since counting.
  *
- * Returns: new #GSGraphSnapshot.
+ * Returns: %TRUE if cached degree sum can be used.
  */
-static GSGraphSnapshot*
-_g_sgraph_snapshot_new_blank (guint node_array_size)
+static gboolean
+_g_sgraph_snapshot_is_counted (GSGraphSnapshot* graph)
 {
-  GSGraphSnapshot* graph;
+  return (!graph->dirty &&
+          (graph->counted_order == graph->node_array->len));
+}
 
-  graph = g_slice_new (GSGraphSnapshot);
+/**
+ * _g_sgraph_snapshot_count:
+ * @graph: a graph.
+ *
+ * Counts sum of degrees of all nodes in @graph and caches it.
+ */
+static void
+_g_sgraph_snapshot_count (GSGraphSnapshot* graph)
+{
+  guint iter;
 
-  graph->node_array = g_ptr_array_sized_new (node_array_size);
+  graph->degree_sum = 0;
+  for (iter = 0; iter < graph->node_array->len; ++iter)
+  {
+    GSGraphNode* node;
 
-  return graph;
+    node = g_ptr_array_index (graph->node_array, iter);
+    graph->degree_sum += node->neighbours->len;
+  }
+  graph->counted_order = graph->node_array->len;
+  graph->dirty = FALSE;
+}
+
+/**
+ * _g_sgraph_snapshot_get_node_data:
+ * @node: a node.
+ *
+ * Gets data of @node. Used as a key function of node index.
+ *
+ * Returns: data of @node.
+ */
+static gpointer
+_g_sgraph_snapshot_get_node_data (gpointer node)
+{
+  return ((GSGraphNode*)node)->data;
+}
+
+/**
+ * _g_sgraph_snapshot_join_neighbours:
+ * @index: an index of a node.
+ * @components: a #GSGraphSnapshotComponents.
+ *
+ * Joins component of @index-th node with components of its neighbours having
+ * higher positions. Connection with a neighbour having lower position is
+ * joined by that neighbour.
+ */
+static void
+_g_sgraph_snapshot_join_neighbours (guint index,
+                                    gpointer components)
+{
+  GSGraphSnapshotComponents* graph_components;
+  GSGraphNode* node;
+  guint iter;
+
+  graph_components = components;
+  node = g_ptr_array_index (graph_components->nodes, index);
+  for (iter = 0; iter < node->neighbours->len; ++iter)
+  {
+    GSGraphNode* neighbour;
+    guint position;
+
+    neighbour = g_ptr_array_index (node->neighbours, iter);
+    position = _g_sgraph_positions_get (&graph_components->positions,
+                                        neighbour,
+                                        &neighbour->visit_mark);
+    if ((position != G_MAXUINT) && (position > index))
+    {
+      _g_sgraph_components_union (graph_components->components,
+                                  index,
+                                  position);
+    }
+  }
 }
@@ -26,6 +26,7 @@
 
 #include <glib.h>
 
+#include <gsgraph/gsgraphtypedefs.h>
 #include <gsgraph/gsgraphnode.h>
 #include <gsgraph/gsgraphenums.h>
 #include <gsgraph/gsgraphdatapair.h>
@@ -43,12 +44,23 @@ typedef struct _GSGraphSnapshot GSGraphSnapshot;
 struct _GSGraphSnapshot
 {
   GPtrArray* node_array;
+
+  /*< private >*/
+  guint degree_sum;
+  guint counted_order;
+  gboolean dirty;
+  gpointer node_index;
 };
 
 GPtrArray*
 g_sgraph_snapshot_new (GSGraphDataPair** data_pairs,
                        guint count);
 
+GPtrArray*
+g_sgraph_snapshot_new_in_arena (GSGraphArena* arena,
+                                GSGraphDataPair** data_pairs,
+                                guint count);
+
 GSGraphSnapshot*
 g_sgraph_snapshot_new_from_node (GSGraphNode* node,
                                  GSGraphTraverseType traverse_type);
@@ -61,6 +73,27 @@ g_sgraph_snapshot_copy_deep (GSGraphSnapshot* graph,
                              GCopyFunc node_data_copy_func,
                              gpointer node_user_data);
 
+GSGraphSnapshot*
+g_sgraph_snapshot_copy_deep_parallel (GSGraphSnapshot* graph,
+                                      GCopyFunc node_data_copy_func,
+                                      gpointer node_user_data,
+                                      guint n_threads);
+
+GSGraphSnapshot*
+g_sgraph_snapshot_copy_in_arena (GSGraphSnapshot* graph,
+                                 GSGraphArena* arena,
+                                 GCopyFunc node_data_copy_func,
+                                 gpointer node_user_data);
+
+GArray*
+g_sgraph_snapshot_get_ordering (GSGraphSnapshot* graph,
+                                GSGraphOrdering ordering);
+
+GSGraphSnapshot*
+g_sgraph_snapshot_reorder (GSGraphSnapshot* graph,
+                           GSGraphArena* arena,
+                           GSGraphOrdering ordering);
+
 void
 g_sgraph_snapshot_free (GSGraphSnapshot* graph,
                         gboolean deep_free);
@@ -71,6 +104,43 @@ g_sgraph_snapshot_get_order (GSGraphSnapshot* graph);
 guint
 g_sgraph_snapshot_get_size (GSGraphSnapshot* graph);
 
+void
+g_sgraph_snapshot_set_dirty (GSGraphSnapshot* graph);
+
+void
+g_sgraph_snapshot_add_node (GSGraphSnapshot* graph,
+                            GSGraphNode* node);
+
+gpointer
+g_sgraph_snapshot_remove_node (GSGraphSnapshot* graph,
+                               GSGraphNode* node);
+
+void
+g_sgraph_snapshot_connect_nodes (GSGraphSnapshot* graph,
+                                 GSGraphNode* node,
+                                 GSGraphNode* other_node);
+
+void
+g_sgraph_snapshot_disconnect_nodes (GSGraphSnapshot* graph,
+                                    GSGraphNode* node,
+                                    GSGraphNode* other_node);
+
+void
+g_sgraph_snapshot_build_index (GSGraphSnapshot* graph,
+                               GHashFunc hash_func,
+                               GEqualFunc key_equal_func,
+                               guint n_threads);
+
+void
+g_sgraph_snapshot_drop_index (GSGraphSnapshot* graph);
+
+gboolean
+g_sgraph_snapshot_has_index (GSGraphSnapshot* graph);
+
+GSGraphNode*
+g_sgraph_snapshot_lookup_node (GSGraphSnapshot* graph,
+                               gconstpointer data);
+
 void
 g_sgraph_snapshot_foreach_node (GSGraphSnapshot* graph,
                                 GFunc func,
@@ -81,6 +151,31 @@ g_sgraph_snapshot_find_node_custom (GSGraphSnapshot* graph,
                                     gpointer user_data,
                                     GEqualFunc func) G_GNUC_WARN_UNUSED_RESULT;
 
+void
+g_sgraph_snapshot_foreach_node_parallel (GSGraphSnapshot* graph,
+                                         GFunc func,
+                                         gpointer user_data,
+                                         guint n_threads);
+
+GSGraphNode*
+g_sgraph_snapshot_find_node_custom_parallel (GSGraphSnapshot* graph,
+                                             gpointer user_data,
+                                             GEqualFunc func,
+                                             guint n_threads);
+
+GArray*
+g_sgraph_snapshot_label_components (GPtrArray* nodes,
+                                    guint* n_components,
+                                    guint n_threads) G_GNUC_WARN_UNUSED_RESULT;
+
+GPtrArray*
+g_sgraph_snapshot_split_components (GPtrArray* nodes,
+                                    guint n_threads) G_GNUC_WARN_UNUSED_RESULT;
+
+GPtrArray*
+g_sgraph_snapshot_find_blocks (GSGraphSnapshot* graph,
+                               GArray** articulation_points) G_GNUC_WARN_UNUSED_RESULT;
+
 G_END_DECLS
 
 #endif /* _G_SGRAPH_SNAPSHOT_H_ */
@@ -0,0 +1,337 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsgraphvisited.h"
+
+/* Visit marks let traversals remember visited nodes and edges without
+ * allocating anything. Every node and edge has a 32-bit mark and every
+ * traversal claims fresh epochs from a counter of its domain, so element is
+ * visited if and only if its mark is one of the claimed epochs. Marks are
+ * never reset between traversals.
+ *
+ * Marks live in graph elements, so two traversals using epochs at the same
+ * time could overwrite each other's marks. Hence a traversal using epochs holds
+ * the domain lock until it finishes. The lock is only tried, never waited for,
+ * so a concurrent traversal in another thread or a nested one in the same
+ * thread uses a hash table instead. When the counter is about to overflow,
+ * marks are disabled, because an old mark could be taken for a new epoch. They
+ * can be enabled again only after all marks were cleared. Marks disabled on
+ * request keep their counter, so enabling them again does not reuse epochs.
+ */
+
+/* internal types. */
+
+/**
+ * GSGraphVisitedState:
+ * @last_epoch: last epoch claimed.
+ * @enabled: whether epochs can be claimed.
+ * @exhausted: whether marks were disabled because epochs ran out.
+ *
+ * Internal struct holding the epoch counter of one domain.
+ */
+typedef struct _GSGraphVisitedState GSGraphVisitedState;
+
+struct _GSGraphVisitedState
+{
+  guint32 last_epoch;
+  gboolean enabled;
+  gboolean exhausted;
+};
+
+/* static variables. */
+
+G_LOCK_DEFINE_STATIC (sgraph_visited);
+G_LOCK_DEFINE_STATIC (segraph_visited);
+
+static GSGraphVisitedState states[2] = {{0, FALSE, FALSE}, {0, FALSE, FALSE}};
+
+/* static function declarations. */
+
+static gboolean
+_g_sgraph_visited_trylock (GSGraphVisitedDomain domain);
+
+static void
+_g_sgraph_visited_lock (GSGraphVisitedDomain domain);
+
+static void
+_g_sgraph_visited_unlock (GSGraphVisitedDomain domain);
+
+/* function definitions. */
+
+/**
+ * _g_sgraph_visited_init:
+ * @visited: a visited set to initialize.
+ * @domain: domain of a traversal.
+ * @sides: number of sides of search, at least 1.
+ *
+ * Prepares @visited for a traversal. If marks of @domain are enabled and no
+ * other traversal uses them, @sides epochs are claimed and the domain lock is
+ * held until _g_sgraph_visited_clear() is called. Otherwise a hash table is
+ * created.
+ */
+void
+_g_sgraph_visited_init (GSGraphVisited* visited,
+                        GSGraphVisitedDomain domain,
+                        guint32 sides)
+{
+  visited->domain = domain;
+  visited->epoch = 0;
+  visited->sides = sides;
+  visited->table = NULL;
+
+  if (_g_sgraph_visited_trylock (domain))
+  {
+    GSGraphVisitedState* state;
+
+    state = &states[domain];
+    if (state->enabled && (state->last_epoch > G_MAXUINT32 - sides))
+    {
+      state->enabled = FALSE;
+      state->exhausted = TRUE;
+      g_warning ("Visit marks exhausted, falling back to hash tables. Clear "
+                 "marks of all elements and enable marks again to use them.");
+    }
+    if (state->enabled)
+    {
+      visited->epoch = state->last_epoch + 1;
+      state->last_epoch += sides;
+      return;
+    }
+    _g_sgraph_visited_unlock (domain);
+  }
+
+  visited->table = g_hash_table_new (NULL, NULL);
+}
+
+/**
+ * _g_sgraph_visited_try_init:
+ * @visited: a visited set to initialize.
+ * @domain: domain of a traversal.
+ * @sides: number of sides of search, at least 1.
+ *
+ * Tries to prepare @visited for a traversal using marks, like
+ * _g_sgraph_visited_init() does, but without falling back to a hash table.
+ * Meant for callers claiming many sides, which have their own fallback, so
+ * marks are not disabled if there are not enough epochs left.
+ *
+ * Returns: %TRUE if epochs were claimed, otherwise %FALSE and @visited must
+ * not be used.
+ */
+gboolean
+_g_sgraph_visited_try_init (GSGraphVisited* visited,
+                            GSGraphVisitedDomain domain,
+                            guint32 sides)
+{
+  visited->domain = domain;
+  visited->epoch = 0;
+  visited->sides = sides;
+  visited->table = NULL;
+
+  if (_g_sgraph_visited_trylock (domain))
+  {
+    GSGraphVisitedState* state;
+
+    state = &states[domain];
+    if (state->enabled && (state->last_epoch <= G_MAXUINT32 - sides))
+    {
+      visited->epoch = state->last_epoch + 1;
+      state->last_epoch += sides;
+      return TRUE;
+    }
+    _g_sgraph_visited_unlock (domain);
+  }
+
+  return FALSE;
+}
+
+/**
+ * _g_sgraph_visited_init_table:
+ * @visited: a visited set to initialize.
+ * @domain: domain of a traversal.
+ * @sides: number of sides of search, at least 1.
+ *
+ * Prepares @visited for a traversal which may outlive the function starting
+ * it, like a traversal driven by an iterator. A hash table is always used, so
+ * the domain lock is not held and other traversals can use marks meanwhile.
+ */
+void
+_g_sgraph_visited_init_table (GSGraphVisited* visited,
+                              GSGraphVisitedDomain domain,
+                              guint32 sides)
+{
+  visited->domain = domain;
+  visited->epoch = 0;
+  visited->sides = sides;
+  visited->table = g_hash_table_new (NULL, NULL);
+}
+
+/**
+ * _g_sgraph_visited_clear:
+ * @visited: a visited set.
+ *
+ * Releases resources held by @visited - either a hash table or the domain
+ * lock.
+ */
+void
+_g_sgraph_visited_clear (GSGraphVisited* visited)
+{
+  if (visited->table)
+  {
+    g_hash_table_unref (visited->table);
+    visited->table = NULL;
+  }
+  else
+  {
+    _g_sgraph_visited_unlock (visited->domain);
+  }
+}
+
+/**
+ * _g_sgraph_visited_set_enabled:
+ * @domain: a domain.
+ * @enabled: whether to enable marks.
+ *
+ * Enables or disables visit marks in @domain. Enabling marks disabled because
+ * epochs ran out restarts epoch counter, so marks of all elements must be 0 at
+ * that time. Otherwise counting continues from the last claimed epoch. Waits
+ * for a running traversal using marks to finish.
+ */
+void
+_g_sgraph_visited_set_enabled (GSGraphVisitedDomain domain,
+                               gboolean enabled)
+{
+  g_return_if_fail (domain < G_N_ELEMENTS (states));
+
+  _g_sgraph_visited_lock (domain);
+  if (enabled && states[domain].exhausted)
+  {
+    states[domain].last_epoch = 0;
+    states[domain].exhausted = FALSE;
+  }
+  states[domain].enabled = enabled;
+  _g_sgraph_visited_unlock (domain);
+}
+
+/**
+ * _g_sgraph_visited_get_enabled:
+ * @domain: a domain.
+ *
+ * Checks if visit marks are enabled in @domain.
+ *
+ * Returns: %TRUE if marks are enabled, otherwise %FALSE.
+ */
+gboolean
+_g_sgraph_visited_get_enabled (GSGraphVisitedDomain domain)
+{
+  gboolean enabled;
+
+  g_return_val_if_fail (domain < G_N_ELEMENTS (states), FALSE);
+
+  _g_sgraph_visited_lock (domain);
+  enabled = states[domain].enabled;
+  _g_sgraph_visited_unlock (domain);
+
+  return enabled;
+}
+
+/* static function definitions. */
+
+/**
+ * _g_sgraph_visited_trylock:
+ * @domain: a domain.
+ *
+ * Tries to lock @domain without waiting.
+ *
+ * Returns: %TRUE if lock was taken, otherwise %FALSE.
+ */
+static gboolean
+_g_sgraph_visited_trylock (GSGraphVisitedDomain domain)
+{
+  switch (domain)
+  {
+    case G_SGRAPH_VISITED_DOMAIN_SGRAPH:
+    {
+      return G_TRYLOCK (sgraph_visited);
+    }
+    case G_SGRAPH_VISITED_DOMAIN_SEGRAPH:
+    {
+      return G_TRYLOCK (segraph_visited);
+    }
+    default:
+    {
+      g_return_val_if_reached (FALSE);
+    }
+  }
+}
+
+/**
+ * _g_sgraph_visited_lock:
+ * @domain: a domain.
+ *
+ * Locks @domain.
+ */
+static void
+_g_sgraph_visited_lock (GSGraphVisitedDomain domain)
+{
+  switch (domain)
+  {
+    case G_SGRAPH_VISITED_DOMAIN_SGRAPH:
+    {
+      G_LOCK (sgraph_visited);
+      break;
+    }
+    case G_SGRAPH_VISITED_DOMAIN_SEGRAPH:
+    {
+      G_LOCK (segraph_visited);
+      break;
+    }
+    default:
+    {
+      g_return_if_reached ();
+    }
+  }
+}
+
+/**
+ * _g_sgraph_visited_unlock:
+ * @domain: a domain.
+ *
+ * Unlocks @domain.
+ */
+static void
+_g_sgraph_visited_unlock (GSGraphVisitedDomain domain)
+{
+  switch (domain)
+  {
+    case G_SGRAPH_VISITED_DOMAIN_SGRAPH:
+    {
+      G_UNLOCK (sgraph_visited);
+      break;
+    }
+    case G_SGRAPH_VISITED_DOMAIN_SEGRAPH:
+    {
+      G_UNLOCK (segraph_visited);
+      break;
+    }
+    default:
+    {
+      g_return_if_reached ();
+    }
+  }
+}
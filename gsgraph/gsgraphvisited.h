@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined (_LIB_G_GRAPH_COMPILATION_)
+#error "This is a private header, it must not be included outside libggraph."
+#endif
+
+#ifndef _G_SGRAPH_VISITED_H_
+#define _G_SGRAPH_VISITED_H_
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GSGraphVisitedDomain:
+ * @G_SGRAPH_VISITED_DOMAIN_SGRAPH: marks in #GSGraphNode.
+ * @G_SGRAPH_VISITED_DOMAIN_SEGRAPH: marks in #GSEGraphNode and #GSEGraphEdge.
+ *
+ * Internal enum telling which epoch counter a traversal uses.
+ */
+typedef enum
+{
+  G_SGRAPH_VISITED_DOMAIN_SGRAPH,
+  G_SGRAPH_VISITED_DOMAIN_SEGRAPH
+} GSGraphVisitedDomain;
+
+/**
+ * GSGraphVisited:
+ * @domain: domain of the traversal.
+ * @epoch: first of epochs claimed by the traversal or 0 if @table is used.
+ * @sides: number of claimed epochs.
+ * @table: #GHashTable mapping visited elements to their sides, used when no
+ * epoch could be claimed.
+ *
+ * Internal set of elements visited by a single traversal. Each element can be
+ * visited by one of @sides sides of search, numbered from 1.
+ */
+typedef struct _GSGraphVisited GSGraphVisited;
+
+struct _GSGraphVisited
+{
+  GSGraphVisitedDomain domain;
+  guint32 epoch;
+  guint32 sides;
+  GHashTable* table;
+};
+
+G_GNUC_INTERNAL void
+_g_sgraph_visited_init (GSGraphVisited* visited,
+                        GSGraphVisitedDomain domain,
+                        guint32 sides);
+
+G_GNUC_INTERNAL gboolean
+_g_sgraph_visited_try_init (GSGraphVisited* visited,
+                            GSGraphVisitedDomain domain,
+                            guint32 sides);
+
+G_GNUC_INTERNAL void
+_g_sgraph_visited_init_table (GSGraphVisited* visited,
+                              GSGraphVisitedDomain domain,
+                              guint32 sides);
+
+G_GNUC_INTERNAL void
+_g_sgraph_visited_clear (GSGraphVisited* visited);
+
+G_GNUC_INTERNAL void
+_g_sgraph_visited_set_enabled (GSGraphVisitedDomain domain,
+                               gboolean enabled);
+
+G_GNUC_INTERNAL gboolean
+_g_sgraph_visited_get_enabled (GSGraphVisitedDomain domain);
+
+/**
+ * _g_sgraph_visited_get:
+ * @visited: a visited set.
+ * @element: a node or an edge.
+ * @mark: visit mark of @element.
+ *
+ * Gets side which visited @element.
+ *
+ * Returns: side number or 0 if @element was not visited.
+ */
+static inline guint32
+_g_sgraph_visited_get (GSGraphVisited* visited,
+                       gpointer element,
+                       guint32* mark)
+{
+  if (visited->table)
+  {
+    return GPOINTER_TO_UINT (g_hash_table_lookup (visited->table, element));
+  }
+  if (*mark - visited->epoch < visited->sides)
+  {
+    return *mark - visited->epoch + 1;
+  }
+  return 0;
+}
+
+/**
+ * _g_sgraph_visited_set:
+ * @visited: a visited set.
+ * @element: a node or an edge.
+ * @mark: visit mark of @element.
+ * @side: side visiting @element, starting from 1.
+ *
+ * Marks @element as visited by @side.
+ */
+static inline void
+_g_sgraph_visited_set (GSGraphVisited* visited,
+                       gpointer element,
+                       guint32* mark,
+                       guint32 side)
+{
+  if (visited->table)
+  {
+    g_hash_table_insert (visited->table, element, GUINT_TO_POINTER (side));
+  }
+  else
+  {
+    *mark = visited->epoch + side - 1;
+  }
+}
+
+/**
+ * _g_sgraph_visited_check:
+ * @visited: a visited set.
+ * @element: a node or an edge.
+ * @mark: visit mark of @element.
+ *
+ * Marks @element as visited by the first side, unless it was already visited.
+ *
+ * Returns: %TRUE if @element was already visited, otherwise %FALSE.
+ */
+static inline gboolean
+_g_sgraph_visited_check (GSGraphVisited* visited,
+                         gpointer element,
+                         guint32* mark)
+{
+  if (_g_sgraph_visited_get (visited, element, mark))
+  {
+    return TRUE;
+  }
+  _g_sgraph_visited_set (visited, element, mark, 1);
+  return FALSE;
+}
+
+G_END_DECLS
+
+#endif /* _G_SGRAPH_VISITED_H_ */
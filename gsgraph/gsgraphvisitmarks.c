@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2009, 2010 Krzesimir Nowak
+ *
+ * This file is part of libggraph.
+ *
+ * libggraph is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libggraph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libggraph.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gsgraphvisitmarks.h"
+
+#include "gsgraphvisited.h"
+
+/**
+ * SECTION: gsgraphvisitmarks
+ * @title: Simple graph visit marks
+ * @short_description: allocation free bookkeeping of traversals.
+ * @include: gsgraph/gsgraph.h
+ * @see_also: #GSGraphNode, #GSGraphSnapshot
+ *
+ * Every traversal has to remember which nodes it already visited. By default
+ * it uses a hash table, which costs an allocation per visited node and hashing
+ * on every step. When visit marks are enabled, each node carries a 32-bit mark
+ * and a traversal claims a new epoch, so checking whether a node was visited is
+ * a single comparison and nothing is allocated.
+ *
+ * To enable or disable visit marks, use g_sgraph_visit_marks_set_enabled().
+ *
+ * To check if they are enabled, use g_sgraph_visit_marks_get_enabled().
+ *
+ * To clear marks in a graph, use g_sgraph_visit_marks_clear().
+ *
+ * <note>
+ *   <para>
+ *     Only one traversal at a time can use marks. A traversal running while
+ *     marks are in use, either in another thread or nested in the same one,
+ *     silently uses a hash table instead, so concurrent traversals of unchanged
+ *     graphs stay safe. With GLib older than 2.32 this requires thread system
+ *     to be initialized.
+ *   </para>
+ *   <para>
+ *     After about four billion traversals epochs run out. Then a warning is
+ *     printed and marks get disabled. To enable them again, clear marks in all
+ *     existing graphs first.
+ *   </para>
+ * </note>
+ */
+
+/* public function definitions. */
+
+/**
+ * g_sgraph_visit_marks_set_enabled:
+ * @enabled: whether traversals should use visit marks.
+ *
+ * Enables or disables visit marks for #GSGraphNode traversals. When enabling
+ * marks that got disabled because epochs ran out, marks of all existing nodes
+ * must be 0 - which can be ensured with g_sgraph_visit_marks_clear(). Marks
+ * disabled with this function can be enabled again without clearing. Marks
+ * are disabled by default.
+ */
+void
+g_sgraph_visit_marks_set_enabled (gboolean enabled)
+{
+  _g_sgraph_visited_set_enabled (G_SGRAPH_VISITED_DOMAIN_SGRAPH, enabled);
+}
+
+/**
+ * g_sgraph_visit_marks_get_enabled:
+ *
+ * Checks if visit marks are enabled for #GSGraphNode traversals. They can get
+ * disabled when epochs run out.
+ *
+ * Returns: %TRUE if visit marks are enabled, otherwise %FALSE.
+ */
+gboolean
+g_sgraph_visit_marks_get_enabled (void)
+{
+  return _g_sgraph_visited_get_enabled (G_SGRAPH_VISITED_DOMAIN_SGRAPH);
+}
+
+/**
+ * g_sgraph_visit_marks_clear:
+ * @graph: a graph.
+ *
+ * Sets marks of all nodes in @graph to 0. Must not be called while a traversal
+ * is running.
+ */
+void
+g_sgraph_visit_marks_clear (GSGraphSnapshot* graph)
+{
+  guint iter;
+
+  g_return_if_fail (graph != NULL);
+  g_return_if_fail (graph->node_array != NULL);
+
+  for (iter = 0; iter < graph->node_array->len; ++iter)
+  {
+    GSGraphNode* node;
+
+    node = g_ptr_array_index (graph->node_array, iter);
+    node->visit_mark = 0;
+  }
+}